@@ -0,0 +1,91 @@
+#include <mutex>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "myMatrix.hpp"
+#include "myAssembly.hpp"
+#include "myParallel.hpp"
+
+// Сборка матрицы 2D-сетки (билинейные элементы, 16 вкладов на элемент):
+// SparseMatrix::setElement под мьютексом против MatrixAssembler с буферами
+// потоков, 1..64 потоков. Отдельно - только finalize.
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::doNotOptimize;
+
+    // Вклады элемента (ex, ey) сетки side x side узлов
+    template <typename F>
+    void elementContributions(size_t side, size_t element, F f) {
+        size_t ex = element % (side - 1);
+        size_t ey = element / (side - 1);
+        const size_t nodes[4] = { ey * side + ex, ey * side + ex + 1, (ey + 1) * side + ex, (ey + 1) * side + ex + 1 };
+        for (size_t a = 0; a < 4; ++a) {
+            for (size_t b = 0; b < 4; ++b) {
+                f(nodes[a], nodes[b], a == b ? 2.0 / 3.0 : -1.0 / 6.0);
+            }
+        }
+    }
+
+    void assemblySuite(Runner& runner) {
+        const std::string suite = "assembly";
+        const size_t side = runner.options().quick ? 120 : 400;
+        const size_t n = side * side;
+        const size_t elements = (side - 1) * (side - 1);
+        const size_t threadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+        auto params = [&](const std::string& method, size_t threads) {
+            return Params{ { "n", std::to_string(n) }, { "method", method }, { "threads", std::to_string(threads) } };
+        };
+        auto tag = [&](bench::Result* r) {
+            if (!r) return;
+            r->counter("contributions", 16.0 * static_cast<double>(elements));
+            r->counter("mcontrib_per_s", 16.0 * static_cast<double>(elements) / r->stats.median * 1e3);
+        };
+
+        for (size_t threads : threadCounts) {
+            tag(runner.run(suite, "assemble", params("mutex", threads), [&] {
+                SparseMatrix<double> mat(n, n);
+                std::mutex mutex;
+                parallel::forEachPart(parallel::uniformPartition(elements, threads), [&](size_t, size_t first, size_t last) {
+                    for (size_t e = first; e < last; ++e) {
+                        elementContributions(side, e, [&](size_t i, size_t j, double v) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            mat.setElement(i, j, mat(i, j) + v);
+                            });
+                    }
+                    });
+                doNotOptimize(mat.size());
+                }, { 3, 1 }));
+
+            tag(runner.run(suite, "assemble", params("buffers", threads), [&] {
+                MatrixAssembler<double> assembler(n, n, threads);
+                parallel::forEachPart(parallel::uniformPartition(elements, threads), [&](size_t slot, size_t first, size_t last) {
+                    assembler.reserve(slot, 16 * (last - first));
+                    for (size_t e = first; e < last; ++e) {
+                        elementContributions(side, e, [&](size_t i, size_t j, double v) { assembler.add(slot, i, j, v); });
+                    }
+                    });
+                doNotOptimize(assembler.finalizeCsr(static_cast<unsigned>(threads)).nnz());
+                }));
+
+            tag(runner.runWithSetup(suite, "finalize", params("buffers", threads), [&] {
+                MatrixAssembler<double> assembler(n, n, threads);
+                auto bounds = parallel::uniformPartition(elements, threads);
+                for (size_t slot = 0; slot + 1 < bounds.size(); ++slot) {
+                    for (size_t e = bounds[slot]; e < bounds[slot + 1]; ++e) {
+                        elementContributions(side, e, [&](size_t i, size_t j, double v) { assembler.add(slot, i, j, v); });
+                    }
+                }
+                return assembler;
+                }, [&](MatrixAssembler<double>& assembler) {
+                    doNotOptimize(assembler.finalizeCsr(static_cast<unsigned>(threads)).nnz());
+                }));
+        }
+    }
+
+    bench::SuiteRegistrar reg("assembly", assemblySuite);
+
+}
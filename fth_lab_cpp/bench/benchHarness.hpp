@@ -0,0 +1,342 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <iomanip>
+#include <sstream>
+#include <memory>
+#include "perfCounters.hpp"
+
+// Локальный харнесс бенчмарков: прогрев, повторы, медиана и перцентили,
+// вывод таблицей, CSV и JSON. Наборы (suite) регистрируются статически
+// в своих файлах и запускаются из benchMain.cpp.
+// С Options::perf каждый повтор дополнительно обрамляется аппаратными
+// счетчиками (perfCounters.hpp); в результат попадают средние на вызов.
+namespace bench {
+
+    using Params = std::vector<std::pair<std::string, std::string>>;
+
+    struct Options {
+        int warmup = 2;
+        int repetitions = 10;
+        uint64_t seed = 20241019;
+        bool quick = false;
+        bool perf = false;
+        std::string filter;
+    };
+
+    // Переопределение числа повторов для тяжелых операций
+    struct CaseOptions {
+        int repetitions = 0;
+        int warmup = -1;
+    };
+
+    struct Stats {
+        size_t samples = 0;
+        double min = 0, p10 = 0, median = 0, mean = 0, p90 = 0, p99 = 0, max = 0, stddev = 0;
+    };
+
+    struct Result {
+        std::string suite;
+        std::string name;
+        Params params;
+        Stats stats;   // наносекунды на один вызов
+        std::vector<std::pair<std::string, double>> counters;
+
+        Result& counter(const std::string& key, double value) {
+            for (auto& kv : counters) {
+                if (kv.first == key) {
+                    kv.second = value;
+                    return *this;
+                }
+            }
+            counters.emplace_back(key, value);
+            return *this;
+        }
+    };
+
+    // Перцентиль с линейной интерполяцией по отсортированной выборке
+    inline double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) return 0.0;
+        double pos = q * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(pos);
+        size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - static_cast<double>(lo));
+    }
+
+    inline Stats computeStats(std::vector<double> samples) {
+        Stats s;
+        if (samples.empty()) return s;
+        std::sort(samples.begin(), samples.end());
+        s.samples = samples.size();
+        s.min = samples.front();
+        s.max = samples.back();
+        s.p10 = percentile(samples, 0.10);
+        s.median = percentile(samples, 0.50);
+        s.p90 = percentile(samples, 0.90);
+        s.p99 = percentile(samples, 0.99);
+        s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        double var = 0.0;
+        for (double v : samples) var += (v - s.mean) * (v - s.mean);
+        s.stddev = std::sqrt(var / static_cast<double>(samples.size()));
+        return s;
+    }
+
+    // Не дает компилятору выбросить вычисление результата
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& options) : options_(options) {
+            if (options_.perf) {
+                perf_ = std::make_unique<PerfCounters>();
+            }
+        }
+
+        bool perfAvailable() const { return perf_ && perf_->available(); }
+
+        // Состояние счетчиков для контекста отчета
+        std::string perfStatus() const {
+            if (!perf_) return "disabled";
+            return perf_->available() ? "enabled" : "unavailable: " + perf_->reason();
+        }
+
+        const Options& options() const { return options_; }
+
+        // Детерминированный сид для набора данных: базовый сид + ключ
+        uint64_t seedFor(const std::string& key) const {
+            uint64_t h = 1469598103934665603ULL;
+            for (unsigned char c : key) {
+                h = (h ^ c) * 1099511628211ULL;
+            }
+            return options_.seed ^ h;
+        }
+
+        bool enabled(const std::string& suite, const std::string& name) const {
+            return options_.filter.empty()
+                || (suite + "/" + name).find(options_.filter) != std::string::npos;
+        }
+
+        // Замер f() без подготовки
+        template <typename F>
+        Result* run(const std::string& suite, const std::string& name, const Params& params,
+            F f, CaseOptions caseOptions = {}) {
+            return runWithSetup(suite, name, params, [] { return 0; },
+                [&](int&) { f(); }, caseOptions);
+        }
+
+        // Замер f(state), где state = setup() готовится заново перед каждым
+        // повтором и не входит во время (для изменяющих операций)
+        template <typename Setup, typename F>
+        Result* runWithSetup(const std::string& suite, const std::string& name, const Params& params,
+            Setup setup, F f, CaseOptions caseOptions = {}) {
+            if (!enabled(suite, name)) return nullptr;
+            int warmup = caseOptions.warmup >= 0 ? caseOptions.warmup : options_.warmup;
+            int reps = caseOptions.repetitions > 0
+                ? std::min(caseOptions.repetitions, options_.repetitions) : options_.repetitions;
+
+            for (int i = 0; i < warmup; ++i) {
+                auto state = setup();
+                f(state);
+            }
+            std::vector<double> samples;
+            samples.reserve(static_cast<size_t>(reps));
+            double perfSum[PerfCounters::EventCount] = {};
+            int perfValid[PerfCounters::EventCount] = {};
+            for (int i = 0; i < reps; ++i) {
+                auto state = setup();
+                // Счетчики включаются до и выключаются после замера времени,
+                // чтобы системные вызовы ioctl не попадали во время
+                if (perfAvailable()) perf_->start();
+                auto start = std::chrono::steady_clock::now();
+                f(state);
+                auto end = std::chrono::steady_clock::now();
+                if (perfAvailable()) {
+                    PerfCounters::Sample sample = perf_->stop();
+                    for (int e = 0; e < PerfCounters::EventCount; ++e) {
+                        if (sample.valid[e]) {
+                            perfSum[e] += sample.values[e];
+                            ++perfValid[e];
+                        }
+                    }
+                }
+                samples.push_back(static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            }
+
+            Result r;
+            r.suite = suite;
+            r.name = name;
+            r.params = params;
+            r.stats = computeStats(samples);
+            for (int e = 0; e < PerfCounters::EventCount; ++e) {
+                if (perfValid[e] > 0) {
+                    r.counter(PerfCounters::eventName(e), perfSum[e] / perfValid[e]);
+                }
+            }
+            // deque: указатели на прежние результаты остаются валидными
+            results_.push_back(r);
+            printRow(results_.back());
+            return &results_.back();
+        }
+
+        const std::deque<Result>& results() const { return results_; }
+
+        // Производные метрики из аппаратных счетчиков и счетчиков набора
+        // (nnz, bytes): IPC, промахи на ненулевой элемент, пропускная
+        // способность. Промах LLC считается за одну линию кэша в 64 байта
+        static std::vector<std::pair<std::string, double>> derivedMetrics(const Result& r) {
+            std::vector<std::pair<std::string, double>> out;
+            const double* cycles = findCounter(r, "cycles");
+            const double* instructions = findCounter(r, "instructions");
+            const double* llc = findCounter(r, "llc_misses");
+            const double* branch = findCounter(r, "branch_misses");
+            const double* nnz = findCounter(r, "nnz");
+            const double* bytes = findCounter(r, "bytes");
+            double ns = r.stats.median;
+            if (cycles && instructions && *cycles > 0) out.emplace_back("ipc", *instructions / *cycles);
+            if (nnz && *nnz > 0) {
+                if (llc) out.emplace_back("llc_misses_per_nnz", *llc / *nnz);
+                if (branch) out.emplace_back("branch_misses_per_nnz", *branch / *nnz);
+                if (cycles) out.emplace_back("cycles_per_nnz", *cycles / *nnz);
+            }
+            if (ns > 0) {
+                if (llc) out.emplace_back("llc_bandwidth_gbps", *llc * 64.0 / ns);
+                if (bytes) out.emplace_back("bandwidth_gbps", *bytes / ns);
+            }
+            return out;
+        }
+
+        void setLog(std::ostream* log) { log_ = log; }
+
+        void writeCsv(std::ostream& os) const {
+            os << "suite,name,params,samples,min_ns,p10_ns,median_ns,mean_ns,p90_ns,p99_ns,max_ns,stddev_ns,counters\n";
+            for (const auto& r : results_) {
+                os << r.suite << ',' << r.name << ',' << '"' << paramString(r.params, ';') << '"' << ','
+                    << r.stats.samples << ',' << r.stats.min << ',' << r.stats.p10 << ','
+                    << r.stats.median << ',' << r.stats.mean << ',' << r.stats.p90 << ','
+                    << r.stats.p99 << ',' << r.stats.max << ',' << r.stats.stddev << ',' << '"';
+                for (size_t i = 0; i < r.counters.size(); ++i) {
+                    os << (i ? ";" : "") << r.counters[i].first << '=' << r.counters[i].second;
+                }
+                os << '"' << '\n';
+            }
+        }
+
+        void writeJson(std::ostream& os) const {
+            os << "{\n  \"context\": {\"seed\": " << options_.seed
+                << ", \"warmup\": " << options_.warmup
+                << ", \"repetitions\": " << options_.repetitions
+                << ", \"quick\": " << (options_.quick ? "true" : "false")
+                << ", \"perf_counters\": \"" << escape(perfStatus()) << "\""
+                << ", \"compiler\": \"" << escape(__VERSION__) << "\"},\n"
+                << "  \"benchmarks\": [\n";
+            for (size_t k = 0; k < results_.size(); ++k) {
+                const auto& r = results_[k];
+                os << "    {\"suite\": \"" << escape(r.suite) << "\", \"name\": \"" << escape(r.name)
+                    << "\", \"params\": {";
+                for (size_t i = 0; i < r.params.size(); ++i) {
+                    os << (i ? ", " : "") << '"' << escape(r.params[i].first) << "\": \""
+                        << escape(r.params[i].second) << '"';
+                }
+                os << "}, \"stats_ns\": {\"samples\": " << r.stats.samples
+                    << ", \"min\": " << r.stats.min << ", \"p10\": " << r.stats.p10
+                    << ", \"median\": " << r.stats.median << ", \"mean\": " << r.stats.mean
+                    << ", \"p90\": " << r.stats.p90 << ", \"p99\": " << r.stats.p99
+                    << ", \"max\": " << r.stats.max << ", \"stddev\": " << r.stats.stddev
+                    << "}, \"counters\": {";
+                for (size_t i = 0; i < r.counters.size(); ++i) {
+                    os << (i ? ", " : "") << '"' << escape(r.counters[i].first) << "\": "
+                        << jsonNumber(r.counters[i].second);
+                }
+                os << "}, \"derived\": {";
+                auto derived = derivedMetrics(r);
+                for (size_t i = 0; i < derived.size(); ++i) {
+                    os << (i ? ", " : "") << '"' << derived[i].first << "\": " << jsonNumber(derived[i].second);
+                }
+                os << "}}" << (k + 1 < results_.size() ? "," : "") << '\n';
+            }
+            os << "  ]\n}\n";
+        }
+
+    private:
+        Options options_;
+        std::deque<Result> results_;
+        std::ostream* log_ = nullptr;
+        std::unique_ptr<PerfCounters> perf_;
+
+        static const double* findCounter(const Result& r, const std::string& key) {
+            for (const auto& kv : r.counters) {
+                if (kv.first == key) return &kv.second;
+            }
+            return nullptr;
+        }
+
+        static std::string paramString(const Params& params, char sep) {
+            std::string s;
+            for (size_t i = 0; i < params.size(); ++i) {
+                if (i) s += sep;
+                s += params[i].first + "=" + params[i].second;
+            }
+            return s;
+        }
+
+        static std::string escape(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        static std::string jsonNumber(double v) {
+            if (!std::isfinite(v)) return "null";
+            std::ostringstream os;
+            os << std::setprecision(10) << v;
+            return os.str();
+        }
+
+        void printRow(const Result& r) const {
+            if (!log_) return;
+            std::ostringstream name;
+            name << r.suite << "/" << r.name << " [" << paramString(r.params, ' ') << "]";
+            *log_ << std::left << std::setw(60) << name.str() << std::right << std::fixed
+                << std::setprecision(3)
+                << " median " << std::setw(12) << r.stats.median / 1e6 << " ms"
+                << "  p10 " << std::setw(12) << r.stats.p10 / 1e6
+                << "  p90 " << std::setw(12) << r.stats.p90 / 1e6;
+            for (const auto& kv : derivedMetrics(r)) {
+                if (kv.first == "ipc") *log_ << "  ipc " << std::setw(6) << kv.second;
+            }
+            *log_ << '\n';
+            *log_ << std::defaultfloat;
+        }
+    };
+
+    using SuiteFn = void (*)(Runner&);
+
+    inline std::vector<std::pair<std::string, SuiteFn>>& registry() {
+        static std::vector<std::pair<std::string, SuiteFn>> suites;
+        return suites;
+    }
+
+    struct SuiteRegistrar {
+        SuiteRegistrar(const char* name, SuiteFn fn) {
+            registry().emplace_back(name, fn);
+        }
+    };
+
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <exception>
+#include "benchHarness.hpp"
+#include "myProfiler.hpp"
+
+// Точка входа бенчмарков.
+//   ./FthLabBench [--filter str] [--reps n] [--warmup n] [--seed n] [--quick]
+//                 [--perf] [--csv file] [--json file] [--trace file] [--list]
+// --filter отбирает замеры по подстроке "suite/name", --quick уменьшает размеры,
+// --perf добавляет аппаратные счетчики perf_event (если доступны).
+// В сборке с -DSPARSE_PROFILING в конце печатаются счетчики операций,
+// --trace сохраняет трассу Chrome trace event.
+
+namespace {
+
+    void usage() {
+        std::cout << "Usage: FthLabBench [--filter str] [--reps n] [--warmup n] [--seed n]"
+            " [--quick] [--perf] [--csv file] [--json file] [--trace file] [--list]\n";
+    }
+
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::string csvPath;
+    std::string jsonPath;
+    std::string tracePath;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") options.filter = value();
+        else if (arg == "--reps") options.repetitions = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--warmup") options.warmup = std::max(0, std::atoi(value().c_str()));
+        else if (arg == "--seed") options.seed = std::strtoull(value().c_str(), nullptr, 10);
+        else if (arg == "--quick") options.quick = true;
+        else if (arg == "--perf") options.perf = true;
+        else if (arg == "--csv") csvPath = value();
+        else if (arg == "--json") jsonPath = value();
+        else if (arg == "--trace") tracePath = value();
+        else if (arg == "--list") list = true;
+        else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (list) {
+        for (const auto& suite : bench::registry()) std::cout << suite.first << "\n";
+        return 0;
+    }
+
+    profiler::setTracing(!tracePath.empty());
+    bench::Runner runner(options);
+    runner.setLog(&std::cout);
+    if (options.perf) {
+        std::cout << "Hardware counters: " << runner.perfStatus() << "\n";
+    }
+    for (const auto& suite : bench::registry()) {
+        // Набор целиком пропускается, если фильтр явно указывает другой набор
+        if (!options.filter.empty() && options.filter.find('/') != std::string::npos
+            && options.filter.compare(0, suite.first.size() + 1, suite.first + "/") != 0) {
+            continue;
+        }
+        // Наборы сверяют результаты ядер и бросают исключение при расхождении
+        try {
+            suite.second(runner);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Suite " << suite.first << " failed: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream out(csvPath);
+        runner.writeCsv(out);
+    }
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        runner.writeJson(out);
+    }
+    if (profiler::enabled) {
+        profiler::report(std::cout);
+    }
+    if (!tracePath.empty()) {
+        std::ofstream out(tracePath);
+        profiler::writeChromeTrace(out);
+    }
+    return 0;
+}
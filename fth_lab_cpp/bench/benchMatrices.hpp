@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "myVector.hpp"
+#include "myMatrix.hpp"
+#include "myDense.hpp"
+#include "myFormats.hpp"
+#include "myWorkload.hpp"
+
+// Генераторы входных данных для бенчмарков поверх myWorkload.hpp: строка i
+// берет числа из потока i счетчикового генератора. Все генераторы
+// детерминированы: одинаковый сид дает одинаковую матрицу.
+namespace bench {
+
+    enum class Structure { Uniform, Banded, PowerLaw };
+
+    inline const char* structureName(Structure s) {
+        switch (s) {
+        case Structure::Uniform: return "uniform";
+        case Structure::Banded: return "banded";
+        default: return "powerlaw";
+        }
+    }
+
+    // density - доля ненулевых элементов (в среднем density * n на строку,
+    // не меньше одного), значения из [0.5, 1.5)
+    inline SparseMatrix<double> makeMatrix(size_t n, double density, Structure structure, uint64_t seed) {
+        double avgLen = std::max(1.0, density * static_cast<double>(n));
+        if (structure == Structure::Uniform) {
+            double rowDensity = n ? avgLen / static_cast<double>(n) : 0.0;
+            return workload::sparseMatrix<double>(n, n, rowDensity, seed, workload::Pattern::Uniform).toSparse();
+        }
+        SparseMatrix<double> mat(n, n);
+        mat.reserve(static_cast<size_t>(avgLen * static_cast<double>(n)));
+        std::vector<size_t> cols;
+
+        for (size_t i = 0; i < n; ++i) {
+            // Счетчики строки: 0 - длина, 1..draws - столбцы, дальше - значения
+            workload::CounterRng rng(seed, i);
+            size_t draws = 0;
+            cols.clear();
+            if (structure == Structure::Banded) {
+                // Лента полуширины k вокруг диагонали
+                size_t k = static_cast<size_t>(avgLen / 2);
+                size_t lo = i > k ? i - k : 0;
+                size_t hi = std::min(n - 1, i + k);
+                for (size_t j = lo; j <= hi; ++j) cols.push_back(j);
+            }
+            else {
+                // Длина строки - Парето с alpha = 1.5 и тем же средним
+                const double alpha = 1.5;
+                double xmin = avgLen * (alpha - 1.0) / alpha;
+                double len = xmin / std::pow(1.0 - rng.uniform(0), 1.0 / alpha);
+                draws = std::max<size_t>(1, std::min<size_t>(n / 2, static_cast<size_t>(len)));
+                for (size_t k = 0; k < draws; ++k) cols.push_back(workload::below(rng(1 + k), n));
+                std::sort(cols.begin(), cols.end());
+                cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+            }
+            for (size_t k = 0; k < cols.size(); ++k) {
+                mat.appendElement(i, cols[k], 0.5 + rng.uniform(1 + draws + k));
+            }
+        }
+        return mat;
+    }
+
+    // Счетчик 2i - попадание индекса i, 2i + 1 - значение
+    inline SparseVector<double> makeVector(size_t n, double density, uint64_t seed) {
+        workload::CounterRng rng(seed);
+        SparseVector<double> vec(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (rng.uniform(2 * i) < density) vec.appendElement(i, 0.5 + rng.uniform(2 * i + 1));
+        }
+        return vec;
+    }
+
+    inline std::vector<double> makeDenseVector(size_t n, uint64_t seed) {
+        return workload::denseVector<double>(n, seed);
+    }
+
+    inline DenseMatrix<double> toDense(const SparseMatrix<double>& mat) {
+        DenseMatrix<double> dense(mat.rows(), mat.cols());
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            dense(it->first.first, it->first.second) = it->second;
+        }
+        return dense;
+    }
+
+}
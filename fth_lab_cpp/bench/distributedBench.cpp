@@ -0,0 +1,67 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "benchMatrices.hpp"
+#include "myMatrix.hpp"
+#include "myDistributed.hpp"
+
+// Масштабирование распределенного SpMV на рангах-потоках (LocalTransport):
+//  - strong: фиксированная матрица, растет число рангов;
+//  - weak: фиксированный размер блока на ранг.
+// Каждый замер включает запуск потоков рангов и обмен гало.
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::doNotOptimize;
+
+    void measure(Runner& runner, const std::string& suite, const std::string& name, size_t n, int ranks) {
+        const double density = 16.0 / static_cast<double>(n);
+        SparseMatrix<double> mat = bench::makeMatrix(n, density, bench::Structure::Banded,
+            runner.seedFor(suite + name + std::to_string(n)));
+        std::vector<double> x = bench::makeDenseVector(n, runner.seedFor(suite + "x"));
+        std::vector<size_t> bounds = distributed::balancedRowBlocks(mat, ranks);
+
+        LocalHub hub(ranks);
+        std::vector<std::unique_ptr<DistributedMatrix<double>>> parts(ranks);
+        std::vector<std::vector<double>> xs(ranks), ys(ranks);
+        distributed::runLocal(hub, [&](Transport& transport) {
+            int rank = transport.rank();
+            parts[rank] = std::make_unique<DistributedMatrix<double>>(
+                DistributedMatrix<double>::fromGlobal(mat, bounds, transport));
+            xs[rank] = parts[rank]->localPart(x);
+            });
+        size_t halo = 0;
+        for (const auto& part : parts) halo += part->haloSize();
+
+        auto r = runner.run(suite, name, Params{ { "n", std::to_string(n) }, { "ranks", std::to_string(ranks) } }, [&] {
+            distributed::runLocal(hub, [&](Transport& transport) {
+                int rank = transport.rank();
+                parts[rank]->spmv(xs[rank], ys[rank], transport);
+                });
+            doNotOptimize(ys);
+            });
+        if (r) {
+            r->counter("nnz", static_cast<double>(mat.size()));
+            r->counter("halo", static_cast<double>(halo));
+            r->counter("gflops", 2.0 * static_cast<double>(mat.size()) / r->stats.median);
+        }
+    }
+
+    void distributedSuite(Runner& runner) {
+        const std::string suite = "distributed";
+        const size_t n = runner.options().quick ? 20000 : 200000;
+        const int rankCounts[] = { 1, 2, 4, 8 };
+        for (int ranks : rankCounts) {
+            measure(runner, suite, "strong", n, ranks);
+        }
+        for (int ranks : rankCounts) {
+            measure(runner, suite, "weak", n / 4 * static_cast<size_t>(ranks), ranks);
+        }
+    }
+
+    bench::SuiteRegistrar reg("distributed", distributedSuite);
+
+}
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "benchHarness.hpp"
+#include "benchMatrices.hpp"
+#include "myVector.hpp"
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "mySellMatrix.hpp"
+#include "myAutoTune.hpp"
+#include "myMixed.hpp"
+#include "myCompressed.hpp"
+
+// Сравнение SpMV: SparseMatrix (хеш-таблица + дерево), CSR, автоматически
+// выбранный формат, формат от автотюнера, компактный CSR (32-битные индексы,
+// значения float / bfloat16), CSR со сжатыми индексами (varint, упаковка бит)
+// и SELL-C-sigma на матрицах разной структуры
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::Structure;
+    using bench::doNotOptimize;
+
+    // Векторные ядра SELL собираются только здесь (-march=native), тесты
+    // FthLabCpp проверяют скалярную версию - результат сверяется с CSR
+    void checkSameResult(const std::vector<double>& expected, const std::vector<double>& actual,
+        const std::string& what) {
+        if (actual.size() != expected.size()) {
+            throw std::runtime_error(what + ": result size differs from CSR");
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (std::abs(actual[i] - expected[i]) > 1e-9 * (1.0 + std::abs(expected[i]))) {
+                throw std::runtime_error(what + ": result differs from CSR in row " + std::to_string(i));
+            }
+        }
+    }
+
+    void formatsSuite(Runner& runner) {
+        const std::string suite = "formats";
+        const size_t n = runner.options().quick ? 5000 : 20000;
+        const double density = 16.0 / static_cast<double>(n);
+        const Structure structures[] = { Structure::Uniform, Structure::Banded, Structure::PowerLaw };
+
+        AutoTuner tuner(AutoTuner::Mode::Measure);
+        for (Structure s : structures) {
+            std::string key = suite + bench::structureName(s);
+            SparseMatrix<double> mat = bench::makeMatrix(n, density, s, runner.seedFor(key));
+            std::vector<double> x = bench::makeDenseVector(n, runner.seedFor(key + "x"));
+            SparseVector<double> xs(n);
+            for (size_t i = 0; i < n; ++i) xs.appendElement(i, x[i]);
+            std::vector<double> y;
+            double flops = 2.0 * static_cast<double>(mat.size());
+            auto tag = [&](bench::Result* r) {
+                if (!r) return;
+                r->counter("nnz", static_cast<double>(mat.size()));
+                r->counter("gflops", flops / r->stats.median);
+            };
+            auto params = [&](const std::string& format) {
+                return Params{ { "n", std::to_string(n) }, { "structure", bench::structureName(s) },
+                    { "format", format } };
+            };
+
+            tag(runner.run(suite, "spmv", params("hashmap"), [&] { doNotOptimize(mat * xs); }, { 3, 1 }));
+
+            CsrMatrix<double> csr(mat);
+            // Минимальный трафик CSR: значения и индексы, rowPtr, x и y по разу
+            double csrBytes = static_cast<double>(mat.size() * (sizeof(double) + sizeof(size_t))
+                + (n + 1) * sizeof(size_t) + 2 * n * sizeof(double));
+            auto rc = runner.run(suite, "spmv", params("csr"), [&] {
+                csr.spmv(x, y);
+                doNotOptimize(y);
+                });
+            tag(rc);
+            if (rc) rc->counter("bytes", csrBytes);
+
+            // Компактный CSR: тот же обход, меньше байт на ненулевой элемент
+            auto compact = [&](const auto& m, const std::string& format) {
+                auto r = runner.run(suite, "spmv", params(format), [&] {
+                    m.spmv(x, y);
+                    doNotOptimize(y);
+                    });
+                tag(r);
+                if (r) r->counter("bytes", static_cast<double>(m.bytes() + 2 * n * sizeof(double)));
+            };
+            compact(CompactCsrMatrix<double>(mat), "csr32-f64");
+            compact(CompactCsrMatrix<float>(mat), "csr32-f32");
+            compact(CompactCsrMatrix<bfloat16>(mat), "csr32-bf16");
+
+            // Сжатые индексы: степень сжатия, SpMV и отдельно скорость распаковки
+            const std::pair<IndexEncoding, const char*> encodings[] = {
+                { IndexEncoding::Varint, "varint" }, { IndexEncoding::BitPacked, "bitpacked" } };
+            for (const auto& [encoding, name] : encodings) {
+                CompressedCsrMatrix<double> packed(mat, encoding);
+                auto rp = runner.run(suite, "spmv", params(std::string("csr-") + name), [&] {
+                    packed.spmv(x, y);
+                    doNotOptimize(y);
+                    });
+                tag(rp);
+                if (rp) {
+                    rp->counter("ratio", packed.compressionRatio());
+                    rp->counter("bytes", static_cast<double>(packed.indexBytes() + mat.size() * sizeof(double)
+                        + 2 * n * sizeof(double)));
+                }
+                std::vector<size_t> cols(n);
+                auto rd = runner.run(suite, "decode", params(std::string("csr-") + name), [&] {
+                    size_t sum = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        packed.decodeRow(i, cols.data());
+                        if (packed.rowLength(i)) sum += cols[packed.rowLength(i) - 1];
+                    }
+                    doNotOptimize(sum);
+                    });
+                if (rd) {
+                    rd->counter("nnz", static_cast<double>(mat.size()));
+                    rd->counter("ratio", packed.compressionRatio());
+                    rd->counter("gindex_per_s", static_cast<double>(mat.size()) / rd->stats.median);
+                }
+            }
+
+            FormattedMatrix<double> formatted(mat);
+            tag(runner.run(suite, "spmv", params("auto"), [&] {
+                formatted.spmv(x, y);
+                doNotOptimize(y);
+                }));
+
+            TunedMatrix<double> tuned = tuner.prepare(mat);
+            auto rt = runner.run(suite, "spmv", params("tuned"), [&] {
+                tuned.spmv(x, y);
+                doNotOptimize(y);
+                });
+            tag(rt);
+            if (rt) rt->params.emplace_back("kernel", kernelName(tuned.decision().kernel) + std::string("x")
+                + std::to_string(tuned.decision().threads));
+
+            const size_t chunkHeights[] = { 4, 8, 16 };
+            const size_t sigmas[] = { 1, 64, 1024 };
+            for (size_t C : chunkHeights) {
+                for (size_t sigma : sigmas) {
+                    SellMatrix<double> sell(mat, C, sigma);
+                    checkSameResult(csr * x, sell * x, "sell-" + std::to_string(C) + "-" + std::to_string(sigma));
+                    auto r = runner.run(suite, "spmv",
+                        params("sell-" + std::to_string(C) + "-" + std::to_string(sigma)), [&] {
+                            sell.spmv(x, y);
+                            doNotOptimize(y);
+                        });
+                    tag(r);
+                    if (r) {
+                        // Дополнение нулями тоже читается из памяти
+                        double stored = static_cast<double>(mat.size()) / sell.fillEfficiency();
+                        r->counter("fill", sell.fillEfficiency());
+                        r->counter("bytes", stored * (sizeof(double) + sizeof(size_t)) + 2.0 * n * sizeof(double));
+                    }
+                }
+            }
+        }
+    }
+
+    bench::SuiteRegistrar reg("formats", formatsSuite);
+
+}
@@ -0,0 +1,69 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "benchMatrices.hpp"
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "myOutOfCore.hpp"
+
+// SpMV и SpGEMM по полосам с диска при разных бюджетах памяти против CSR
+// в памяти. Файл после записи обычно лежит в страничном кеше, поэтому
+// замер показывает накладные расходы полос и чтения, а не скорость диска.
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::doNotOptimize;
+
+    void outOfCoreSuite(Runner& runner) {
+        const std::string suite = "outofcore";
+        const size_t n = runner.options().quick ? 20000 : 200000;
+        const double density = 16.0 / static_cast<double>(n);
+        SparseMatrix<double> mat = bench::makeMatrix(n, density, bench::Structure::Banded, runner.seedFor(suite));
+        std::vector<double> x = bench::makeDenseVector(n, runner.seedFor(suite + "x"));
+        std::vector<double> y;
+        CsrMatrix<double> csr(mat);
+        CsrMatrix<double> right(bench::makeMatrix(n, 4.0 / static_cast<double>(n), bench::Structure::Uniform,
+            runner.seedFor(suite + "b")));
+        double matrixBytes = static_cast<double>(outofcore::panelBytes<double>(n, mat.size()));
+
+        auto params = [&](const std::string& mode) {
+            return Params{ { "n", std::to_string(n) }, { "mode", mode } };
+        };
+
+        auto r = runner.run(suite, "spmv", params("memory"), [&] {
+            csr.spmv(x, y);
+            doNotOptimize(y);
+            });
+        if (r) r->counter("bytes", matrixBytes);
+        r = runner.run(suite, "spgemm", params("memory"), [&] { doNotOptimize(csr * right); }, { 3, 1 });
+
+        namespace fs = std::filesystem;
+        std::string path = (fs::temp_directory_path() / "fth_bench_outofcore.panels").string();
+        std::string productPath = (fs::temp_directory_path() / "fth_bench_outofcore_ab.panels").string();
+        const size_t budgets[] = { size_t{ 1 } << 20, size_t{ 16 } << 20 };
+        for (size_t budget : budgets) {
+            OutOfCoreMatrix<double> ooc = OutOfCoreMatrix<double>::create(mat, path, budget);
+            std::string mode = "disk-" + std::to_string(budget >> 20) + "mb";
+            auto tag = [&](bench::Result* res) {
+                if (!res) return;
+                res->counter("panels", static_cast<double>(ooc.panelCount()));
+                res->counter("bytes", matrixBytes);
+            };
+            tag(runner.run(suite, "spmv", params(mode), [&] {
+                ooc.spmv(x, y);
+                doNotOptimize(y);
+                }));
+            tag(runner.run(suite, "spgemm", params(mode), [&] {
+                doNotOptimize(ooc.multiply(right, productPath).nnz());
+                }, { 3, 1 }));
+        }
+        fs::remove(path);
+        fs::remove(productPath);
+    }
+
+    bench::SuiteRegistrar reg("outofcore", outOfCoreSuite);
+
+}
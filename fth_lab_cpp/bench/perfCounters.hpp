@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// Аппаратные счетчики через perf_event_open: такты, инструкции, промахи
+// последнего уровня кэша и промахи предсказателя переходов. Считается только
+// пользовательский код (exclude_kernel), поэтому достаточно
+// perf_event_paranoid <= 2. В контейнерах без доступа к PMU счетчики не
+// открываются - available() == false, а reason() объясняет причину.
+namespace bench {
+
+    class PerfCounters {
+    public:
+        enum Event { Cycles, Instructions, LlcMisses, BranchMisses, EventCount };
+
+        static const char* eventName(int e) {
+            static const char* names[EventCount] = { "cycles", "instructions", "llc_misses", "branch_misses" };
+            return names[e];
+        }
+
+        struct Sample {
+            double values[EventCount] = {};
+            bool valid[EventCount] = {};
+        };
+
+        PerfCounters() {
+#if defined(__linux__)
+            const uint64_t configs[EventCount] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+            for (int e = 0; e < EventCount; ++e) {
+                fds_[e] = open(configs[e], e == Cycles ? -1 : fds_[Cycles]);
+                if (e == Cycles && fds_[e] < 0) {
+                    reason_ = std::string("perf_event_open failed: ") + std::strerror(errno);
+                    return;
+                }
+            }
+            available_ = true;
+#else
+            reason_ = "perf_event is only supported on Linux";
+#endif
+        }
+
+        ~PerfCounters() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) close(fd);
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available() const { return available_; }
+        const std::string& reason() const { return reason_; }
+
+        void start() {
+#if defined(__linux__)
+            if (!available_) return;
+            ioctl(fds_[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        // Значения с поправкой на мультиплексирование (time_enabled / time_running)
+        Sample stop() {
+            Sample s;
+#if defined(__linux__)
+            if (!available_) return s;
+            ioctl(fds_[Cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            for (int e = 0; e < EventCount; ++e) {
+                if (fds_[e] < 0) continue;
+                uint64_t buf[3] = {};
+                if (read(fds_[e], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[2] == 0) {
+                    continue;
+                }
+                s.values[e] = static_cast<double>(buf[0]) * static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+                s.valid[e] = true;
+            }
+#endif
+            return s;
+        }
+
+    private:
+        int fds_[EventCount] = { -1, -1, -1, -1 };
+        bool available_ = false;
+        std::string reason_;
+
+#if defined(__linux__)
+        static int open(uint64_t config, int groupFd) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = groupFd < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+        }
+#endif
+    };
+
+}
@@ -0,0 +1,82 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "myMixed.hpp"
+#include "mySolvers.hpp"
+
+// Решение A x = b: BiCGSTAB в double против итерационного уточнения
+// с внутренними решениями по float / bfloat16 копии матрицы
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::doNotOptimize;
+
+    // Несимметричная ленточная матрица с диагональным преобладанием
+    SparseMatrix<double> makeSystem(size_t n) {
+        SparseMatrix<double> mat(n, n);
+        mat.reserve(5 * n);
+        const long offsets[] = { -9, -1, 0, 1, 4 };
+        for (size_t i = 0; i < n; ++i) {
+            for (long d : offsets) {
+                long j = static_cast<long>(i) + d;
+                if (j < 0 || j >= static_cast<long>(n)) continue;
+                double value = d == 0 ? 3.0 + 0.001 * static_cast<double>(i % 13) : -0.5 / (1.0 + std::abs(d));
+                mat.appendElement(i, static_cast<size_t>(j), value);
+            }
+        }
+        return mat;
+    }
+
+    void solverSuite(Runner& runner) {
+        const std::string suite = "solvers";
+        const size_t n = runner.options().quick ? 20000 : 200000;
+        SparseMatrix<double> mat = makeSystem(n);
+        CsrMatrix<double> csr(mat);
+        CompactCsrMatrix<float> single(mat);
+        CompactCsrMatrix<bfloat16> half(mat);
+        std::vector<double> b(n);
+        for (size_t i = 0; i < n; ++i) b[i] = std::cos(static_cast<double>(i));
+        const double tol = 1e-12;
+
+        auto params = [&](const std::string& method) {
+            return Params{ { "n", std::to_string(n) }, { "method", method } };
+        };
+        auto tag = [&](bench::Result* r, const solvers::SolveResult& res) {
+            if (!r) return;
+            r->counter("outer", static_cast<double>(res.iterations));
+            r->counter("inner", static_cast<double>(res.innerIterations));
+            r->counter("residual", res.residualNorm);
+        };
+
+        solvers::SolveResult last;
+        std::vector<double> x;
+        auto r = runner.run(suite, "solve", params("bicgstab-f64"), [&] {
+            x.assign(n, 0.0);
+            last = solvers::bicgstab(csr, b, x, tol);
+            doNotOptimize(x);
+            }, { 3, 1 });
+        tag(r, last);
+
+        r = runner.run(suite, "solve", params("refine-f32"), [&] {
+            x.assign(n, 0.0);
+            last = solvers::refine(csr, single, b, x, tol);
+            doNotOptimize(x);
+            }, { 3, 1 });
+        tag(r, last);
+
+        r = runner.run(suite, "solve", params("refine-bf16"), [&] {
+            x.assign(n, 0.0);
+            last = solvers::refine(csr, half, b, x, tol);
+            doNotOptimize(x);
+            }, { 3, 1 });
+        tag(r, last);
+    }
+
+    bench::SuiteRegistrar reg("solvers", solverSuite);
+
+}
@@ -0,0 +1,239 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "benchMatrices.hpp"
+#include "myVector.hpp"
+#include "myMatrix.hpp"
+#include "myDense.hpp"
+
+// Покрытие всех операций SparseMatrix, SparseVector и плотных классов
+// с перебором размера, плотности и структуры матрицы. Сравнение (equality)
+// идет с копией, чтобы обходилась вся структура, а не первое несовпадение;
+// делитель cwiseQuotient - операнд * 2 (тот же шаблон, без деления на неявный ноль).
+// Не замеряются: доступ к размерам, итераторы по отдельности, clearAll,
+// identity / zeros и операторы !=, <, > (выражаются через замеренные).
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::Structure;
+    using bench::doNotOptimize;
+
+    const Structure kStructures[] = { Structure::Uniform, Structure::Banded, Structure::PowerLaw };
+
+    Params matrixParams(size_t n, double density, Structure s) {
+        return { { "n", std::to_string(n) }, { "density", std::to_string(density) },
+            { "structure", bench::structureName(s) } };
+    }
+
+    void sparseMatrixSuite(Runner& runner) {
+        const std::string suite = "sparse_matrix";
+        std::vector<size_t> sizes = runner.options().quick ? std::vector<size_t>{ 500 }
+        : std::vector<size_t>{ 1000, 4000 };
+        const double densities[] = { 0.001, 0.005 };
+
+        // Операции O(nnz)
+        for (size_t n : sizes) {
+            for (double density : densities) {
+                for (Structure s : kStructures) {
+                    Params p = matrixParams(n, density, s);
+                    std::string key = suite + std::to_string(n) + std::to_string(density) + bench::structureName(s);
+                    SparseMatrix<double> A = bench::makeMatrix(n, density, s, runner.seedFor(key + "A"));
+                    SparseMatrix<double> B = bench::makeMatrix(n, density, s, runner.seedFor(key + "B"));
+                    SparseVector<double> x = bench::makeVector(n, 1.0, runner.seedFor(key + "x"));
+                    SparseMatrix<double> Acopy = A;
+                    SparseMatrix<double> divisor = A * 2.0;
+                    double nnz = static_cast<double>(A.size());
+                    auto tag = [&](bench::Result* r, double flops) {
+                        if (!r) return;
+                        r->counter("nnz", nnz);
+                        if (flops > 0) r->counter("gflops", flops / r->stats.median);
+                    };
+
+                    tag(runner.run(suite, "build_setElement", p, [&] {
+                        SparseMatrix<double> C(n, n);
+                        for (auto it = A.cbegin(); it != A.cend(); ++it) {
+                            C.setElement(it->first.first, it->first.second, it->second);
+                        }
+                        doNotOptimize(C);
+                        }), 0);
+                    tag(runner.run(suite, "build_appendElement", p, [&] {
+                        SparseMatrix<double> C(n, n);
+                        C.reserve(A.size());
+                        for (auto it = A.cbegin(); it != A.cend(); ++it) {
+                            C.appendElement(it->first.first, it->first.second, it->second);
+                        }
+                        doNotOptimize(C);
+                        }), 0);
+                    tag(runner.run(suite, "access", p, [&] {
+                        double sum = 0;
+                        for (auto it = B.cbegin(); it != B.cend(); ++it) {
+                            sum += A(it->first.first, it->first.second);
+                        }
+                        doNotOptimize(sum);
+                        }), 0);
+                    tag(runner.runWithSetup(suite, "removeElement", p, [&] { return A; },
+                        [&](SparseMatrix<double>& C) {
+                            for (size_t i = 0; i < 32; ++i) C.removeElement(i % n, (i * 7) % n);
+                            doNotOptimize(C);
+                        }, { 3, 1 }), 0);
+                    tag(runner.run(suite, "transpose", p, [&] { doNotOptimize(A.transpose()); }), 0);
+                    tag(runner.run(suite, "add_scalar", p, [&] { doNotOptimize(A + 1.0); }), nnz);
+                    tag(runner.run(suite, "sub_scalar", p, [&] { doNotOptimize(A - 1.0); }), nnz);
+                    tag(runner.run(suite, "mul_scalar", p, [&] { doNotOptimize(A * 2.0); }), nnz);
+                    tag(runner.run(suite, "div_scalar", p, [&] { doNotOptimize(A / 2.0); }), nnz);
+                    tag(runner.run(suite, "add_matrix", p, [&] { doNotOptimize(A + B); }), nnz);
+                    tag(runner.run(suite, "sub_matrix", p, [&] { doNotOptimize(A - B); }), nnz);
+                    tag(runner.run(suite, "spmv", p, [&] { doNotOptimize(A * x); }), 2 * nnz);
+                    tag(runner.run(suite, "powerAll_int", p, [&] { doNotOptimize(A.powerAll(3.0)); }), 2 * nnz);
+                    tag(runner.run(suite, "powerAll_real", p, [&] { doNotOptimize(A.powerAll(0.5)); }), nnz);
+                    tag(runner.run(suite, "cwiseProduct", p, [&] { doNotOptimize(A.cwiseProduct(B)); }), 0);
+                    tag(runner.run(suite, "cwiseQuotient", p, [&] { doNotOptimize(A.cwiseQuotient(divisor)); }), nnz);
+                    tag(runner.run(suite, "cwiseMax", p, [&] { doNotOptimize(A.cwiseMax(B)); }), 0);
+                    tag(runner.run(suite, "cwiseMin", p, [&] { doNotOptimize(A.cwiseMin(B)); }), 0);
+                    tag(runner.run(suite, "cwiseSqrt", p, [&] { doNotOptimize(A.cwiseSqrt()); }), nnz);
+                    tag(runner.run(suite, "map", p, [&] {
+                        doNotOptimize(A.map([](double v) { return v * v + 1.0; }));
+                        }), 2 * nnz);
+                    tag(runner.run(suite, "reduce", p, [&] {
+                        doNotOptimize(A.reduce([](double acc, double v) { return acc + v; }));
+                        }), nnz);
+                    tag(runner.run(suite, "sum", p, [&] { doNotOptimize(A.sum()); }), nnz);
+                    tag(runner.run(suite, "rowSums", p, [&] { doNotOptimize(A.rowSums()); }), nnz);
+                    tag(runner.run(suite, "equality", p, [&] { doNotOptimize(A == Acopy); }), 0);
+                    tag(runner.run(suite, "frobeniusNorm", p, [&] { doNotOptimize(A.frobeniusNorm()); },
+                        { 3, 1 }), 0);
+                }
+            }
+        }
+
+        // Умножение и целая степень: текущая реализация O(nnz(A) * nnz(B))
+        std::vector<size_t> gemmSizes = runner.options().quick ? std::vector<size_t>{ 250 }
+        : std::vector<size_t>{ 250, 500, 1000 };
+        for (size_t n : gemmSizes) {
+            for (Structure s : kStructures) {
+                double density = 0.005;
+                Params p = matrixParams(n, density, s);
+                std::string key = suite + "gemm" + std::to_string(n) + bench::structureName(s);
+                SparseMatrix<double> A = bench::makeMatrix(n, density, s, runner.seedFor(key + "A"));
+                SparseMatrix<double> B = bench::makeMatrix(n, density, s, runner.seedFor(key + "B"));
+                if (auto r = runner.run(suite, "spgemm", p, [&] { doNotOptimize(A * B); }, { 3, 1 })) {
+                    r->counter("nnz", static_cast<double>(A.size()));
+                }
+                if (auto r = runner.run(suite, "integerPower_3", p, [&] { doNotOptimize(A.integerPower(3)); }, { 3, 1 })) {
+                    r->counter("nnz", static_cast<double>(A.size()));
+                }
+            }
+        }
+
+        // Обращение, экспонента и логарифм на малых плотных по сути матрицах
+        // (n <= 6 идет через SmallMatrix)
+        std::vector<size_t> smallSizes = runner.options().quick ? std::vector<size_t>{ 3, 8 }
+        : std::vector<size_t>{ 3, 6, 8, 16, 32 };
+        for (size_t n : smallSizes) {
+            Params p = { { "n", std::to_string(n) } };
+            SparseMatrix<double> A = bench::makeMatrix(n, 0.5, Structure::Uniform, runner.seedFor(suite + "small" + std::to_string(n)));
+            // Диагональное преобладание - матрица обратима
+            for (size_t i = 0; i < n; ++i) A.setElement(i, i, A(i, i) + static_cast<double>(n));
+            runner.run(suite, "inverse", p, [&] { doNotOptimize(A.inverse()); }, { 5, 1 });
+            SparseMatrix<double> E = A / (2.0 * A.frobeniusNorm());
+            runner.run(suite, "exp", p, [&] { doNotOptimize(E.exp()); }, { 5, 1 });
+            // log требует нормы меньше 1, а сходимость ряда - спектра A - I внутри
+            // единичного круга: берем c * I + малое возмущение
+            SparseMatrix<double> L = SparseMatrix<double>::identity(n) * (0.8 / std::sqrt(static_cast<double>(n))) + E * 0.1;
+            runner.run(suite, "log", p, [&] { doNotOptimize(L.log(20)); }, { 3, 1 });
+            runner.run(suite, "doublePower", p, [&] { doNotOptimize(L.doublePower(0.5)); }, { 3, 1 });
+        }
+    }
+
+    void sparseVectorSuite(Runner& runner) {
+        const std::string suite = "sparse_vector";
+        std::vector<size_t> sizes = runner.options().quick ? std::vector<size_t>{ 10000 }
+        : std::vector<size_t>{ 10000, 100000 };
+        const double densities[] = { 0.01, 0.1 };
+        for (size_t n : sizes) {
+            for (double density : densities) {
+                Params p = { { "n", std::to_string(n) }, { "density", std::to_string(density) } };
+                std::string key = suite + std::to_string(n) + std::to_string(density);
+                SparseVector<double> u = bench::makeVector(n, density, runner.seedFor(key + "u"));
+                SparseVector<double> v = bench::makeVector(n, density, runner.seedFor(key + "v"));
+                SparseVector<double> ucopy = u;
+                SparseVector<double> divisor = u * 2.0;
+                auto tag = [&](bench::Result* r) {
+                    if (r) r->counter("nnz", static_cast<double>(u.size()));
+                };
+
+                tag(runner.run(suite, "build_setElement", p, [&] {
+                    SparseVector<double> w(n);
+                    for (auto it = u.cbegin(); it != u.cend(); ++it) w.setElement(it->first, it->second);
+                    doNotOptimize(w);
+                    }));
+                tag(runner.run(suite, "access", p, [&] {
+                    double sum = 0;
+                    for (auto it = v.cbegin(); it != v.cend(); ++it) sum += u[it->first];
+                    doNotOptimize(sum);
+                    }));
+                tag(runner.runWithSetup(suite, "removeElement", p, [&] { return u; },
+                    [&](SparseVector<double>& w) {
+                        for (size_t i = 0; i < 32; ++i) w.removeElement((i * 7919) % n);
+                        doNotOptimize(w);
+                    }, { 3, 1 }));
+                tag(runner.run(suite, "negate", p, [&] { doNotOptimize(-u); }));
+                tag(runner.run(suite, "add_vector", p, [&] { doNotOptimize(u + v); }));
+                tag(runner.run(suite, "sub_vector", p, [&] { doNotOptimize(u - v); }));
+                tag(runner.run(suite, "add_scalar", p, [&] { doNotOptimize(u + 1.0); }));
+                tag(runner.run(suite, "sub_scalar", p, [&] { doNotOptimize(u - 1.0); }));
+                tag(runner.run(suite, "mul_scalar", p, [&] { doNotOptimize(u * 2.0); }));
+                tag(runner.run(suite, "div_scalar", p, [&] { doNotOptimize(u / 2.0); }));
+                tag(runner.run(suite, "powerAll_int", p, [&] { doNotOptimize(u.powerAll(3.0)); }));
+                tag(runner.run(suite, "cwiseProduct", p, [&] { doNotOptimize(u.cwiseProduct(v)); }));
+                tag(runner.run(suite, "cwiseQuotient", p, [&] { doNotOptimize(u.cwiseQuotient(divisor)); }));
+                tag(runner.run(suite, "cwiseMax", p, [&] { doNotOptimize(u.cwiseMax(v)); }));
+                tag(runner.run(suite, "cwiseMin", p, [&] { doNotOptimize(u.cwiseMin(v)); }));
+                tag(runner.run(suite, "cwiseSqrt", p, [&] { doNotOptimize(u.cwiseSqrt()); }));
+                tag(runner.run(suite, "map", p, [&] {
+                    doNotOptimize(u.map([](double x) { return x * x + 1.0; }));
+                    }));
+                tag(runner.run(suite, "reduce", p, [&] {
+                    doNotOptimize(u.reduce([](double acc, double x) { return acc + x; }));
+                    }));
+                tag(runner.run(suite, "sum", p, [&] { doNotOptimize(u.sum()); }));
+                tag(runner.run(suite, "dot", p, [&] { doNotOptimize(u.dot(v)); }));
+                tag(runner.run(suite, "equality", p, [&] { doNotOptimize(u == ucopy); }));
+            }
+        }
+    }
+
+    void denseSuite(Runner& runner) {
+        const std::string suite = "dense";
+        std::vector<size_t> sizes = runner.options().quick ? std::vector<size_t>{ 100 }
+        : std::vector<size_t>{ 100, 250, 500 };
+        for (size_t n : sizes) {
+            Params p = { { "n", std::to_string(n) } };
+            DenseMatrix<double> A = bench::toDense(bench::makeMatrix(n, 0.01, Structure::Uniform, runner.seedFor(suite + std::to_string(n) + "A")));
+            DenseMatrix<double> B = bench::toDense(bench::makeMatrix(n, 0.01, Structure::Uniform, runner.seedFor(suite + std::to_string(n) + "B")));
+            if (auto r = runner.run(suite, "matmul", p, [&] { doNotOptimize(A * B); }, { 3, 1 })) {
+                r->counter("gflops", 2.0 * n * n * n / r->stats.median);
+            }
+        }
+        for (size_t n : { size_t{ 10000 }, size_t{ 1000000 } }) {
+            Params p = { { "n", std::to_string(n) } };
+            std::vector<double> xs = bench::makeDenseVector(n, runner.seedFor(suite + "x"));
+            DenseVector<double> x(n), y(n);
+            for (size_t i = 0; i < n; ++i) {
+                x[i] = xs[i];
+                y[i] = xs[n - 1 - i];
+            }
+            if (auto r = runner.run(suite, "dot", p, [&] { doNotOptimize(x.dot(y)); })) {
+                r->counter("gflops", 2.0 * n / r->stats.median);
+            }
+        }
+    }
+
+    bench::SuiteRegistrar regMatrix("sparse_matrix", sparseMatrixSuite);
+    bench::SuiteRegistrar regVector("sparse_vector", sparseVectorSuite);
+    bench::SuiteRegistrar regDense("dense", denseSuite);
+
+}
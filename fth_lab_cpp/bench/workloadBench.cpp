@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchHarness.hpp"
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "myWorkload.hpp"
+
+// Генерация входных данных: mt19937_64 и распределения std (по одному
+// числу, SparseMatrix - так генерировались входы бенчмарков раньше) против
+// workload::sparseMatrix (счетчиковый генератор, сразу CSR) на 1..8 потоках;
+// то же для плотного вектора.
+
+namespace {
+
+    using bench::Params;
+    using bench::Runner;
+    using bench::doNotOptimize;
+
+    // rowLen случайных столбцов в строке, значения из [0.5, 1.5)
+    SparseMatrix<double> stdMatrix(size_t n, size_t rowLen, uint64_t seed) {
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<double> valDist(0.5, 1.5);
+        std::uniform_int_distribution<size_t> colDist(0, n - 1);
+        SparseMatrix<double> mat(n, n);
+        mat.reserve(rowLen * n);
+        std::vector<size_t> cols;
+        for (size_t i = 0; i < n; ++i) {
+            cols.clear();
+            for (size_t k = 0; k < rowLen; ++k) cols.push_back(colDist(gen));
+            std::sort(cols.begin(), cols.end());
+            cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+            for (size_t j : cols) mat.appendElement(i, j, valDist(gen));
+        }
+        return mat;
+    }
+
+    std::vector<double> stdVector(size_t n, uint64_t seed) {
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<double> u(0.5, 1.5);
+        std::vector<double> x(n);
+        for (auto& v : x) v = u(gen);
+        return x;
+    }
+
+    void workloadSuite(Runner& runner) {
+        const std::string suite = "workload";
+        const size_t n = runner.options().quick ? 20000 : 200000;
+        const double density = 20.0 / static_cast<double>(n);
+        const size_t vectorSize = runner.options().quick ? 1000000 : 10000000;
+        const size_t threadCounts[] = { 1, 2, 4, 8 };
+
+        auto params = [&](size_t size, const std::string& method, size_t threads) {
+            return Params{ { "n", std::to_string(size) }, { "method", method }, { "threads", std::to_string(threads) } };
+        };
+        auto tagNnz = [&](bench::Result* r, double nnz) {
+            if (!r) return;
+            r->counter("nnz", nnz);
+            r->counter("mnnz_per_s", nnz / r->stats.median * 1e3);
+        };
+        auto tagVector = [&](bench::Result* r) {
+            if (!r) return;
+            r->counter("mvalues_per_s", static_cast<double>(vectorSize) / r->stats.median * 1e3);
+        };
+
+        double nnz = static_cast<double>(stdMatrix(n, 20, 1).size());
+        tagNnz(runner.run(suite, "matrix", params(n, "mt19937", 1), [&] {
+            doNotOptimize(stdMatrix(n, 20, 1).size());
+            }, { 3, 1 }), nnz);
+        tagVector(runner.run(suite, "vector", params(vectorSize, "mt19937", 1), [&] {
+            doNotOptimize(stdVector(vectorSize, 1).size());
+            }, { 3, 1 }));
+
+        for (size_t threads : threadCounts) {
+            unsigned t = static_cast<unsigned>(threads);
+            tagNnz(runner.run(suite, "matrix", params(n, "counter", threads), [&] {
+                doNotOptimize(workload::sparseMatrix<double>(n, n, density, 1, workload::Pattern::Uniform, t).nnz());
+                }), nnz);
+            tagNnz(runner.run(suite, "matrix", params(n, "counter-zipf", threads), [&] {
+                doNotOptimize(workload::sparseMatrix<double>(n, n, density, 1, workload::Pattern::Zipf, t).nnz());
+                }), nnz);
+            tagVector(runner.run(suite, "vector", params(vectorSize, "counter", threads), [&] {
+                doNotOptimize(workload::denseVector<double>(vectorSize, 1, 0.5, 1.5, t).size());
+                }));
+        }
+    }
+
+    bench::SuiteRegistrar reg("workload", workloadSuite);
+
+}
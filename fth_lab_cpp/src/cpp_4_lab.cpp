@@ -1,142 +1,64 @@
 #include <cassert>
 #include <iostream>
-#include <chrono>
-#include <random>
+#include <sstream>
+#include <cstdio>
+#include <filesystem>
 #include "myVector.hpp" 
 #include "myMatrix.hpp"
+#include "myShifted.hpp"
+#include "myFormats.hpp"
+#include "mySellMatrix.hpp"
+#include "myReorder.hpp"
+#include "myProfiler.hpp"
+#include "myAutoTune.hpp"
+#include "mySmallMatrix.hpp"
+#include "myMixed.hpp"
+#include "mySolvers.hpp"
+#include "myCompressed.hpp"
+#include "myOutOfCore.hpp"
+#include "myDistributed.hpp"
+#include "myAssembly.hpp"
+#include "myWorkload.hpp"
 
 void testMatrixRealis();
 void testVectorRealis();
 void testAdvancedMatrixOperations();
-
-template<typename T>
-class DenseVector {
-public:
-    DenseVector(size_t size) : data_(size, T{}) {}
-    T& operator[](size_t i) { return data_[i]; }
-    const T& operator[](size_t i) const { return data_[i]; }
-    size_t size() const { return data_.size(); }
-
-    // Пример операции: скалярное произведение
-    T dot(const DenseVector& other) const {
-        if (other.size() != size()) throw std::invalid_argument("Size mismatch");
-        T result = T{};
-        for (size_t i = 0; i < size(); ++i) {
-            result += data_[i] * other.data_[i];
-        }
-        return result;
-    }
-
-private:
-    std::vector<T> data_;
-};
-
-// Плотная реализация матрицы 
-template<typename T>
-class DenseMatrix {
-public:
-    DenseMatrix(size_t rows, size_t cols) : rows_(rows), cols_(cols), data_(rows* cols, T{}) {}
-
-    T& operator()(size_t r, size_t c) {
-        return data_[r * cols_ + c];
-    }
-
-    const T& operator()(size_t r, size_t c) const {
-        return data_[r * cols_ + c];
-    }
-
-    size_t rows() const { return rows_; }
-    size_t cols() const { return cols_; }
-
-    // Пример операции: умножение матриц
-    DenseMatrix operator*(const DenseMatrix& other) const {
-        if (cols_ != other.rows_) {
-            throw std::invalid_argument("Dimension mismatch");
-        }
-        DenseMatrix result(rows_, other.cols_);
-        for (size_t i = 0; i < rows_; ++i) {
-            for (size_t j = 0; j < other.cols_; ++j) {
-                T sum = T{};
-                for (size_t k = 0; k < cols_; ++k) {
-                    sum += (*this)(i, k) * other(k, j);
-                }
-                result(i, j) = sum;
-            }
-        }
-        return result;
-    }
-
-private:
-    size_t rows_, cols_;
-    std::vector<T> data_;
-};
-
+void testShiftedOperations();
+void testElementwiseOperations();
+void testMatrixFormats();
+void testSellMatrix();
+void testReordering();
+void testProfiler();
+void testAutoTune();
+void testSmallMatrix();
+void testMixedPrecision();
+void testCompressedIndices();
+void testOutOfCore();
+void testDistributed();
+void testAssembly();
+void testWorkload();
 
 int main() {
     testVectorRealis();
     testMatrixRealis();
     testAdvancedMatrixOperations();
-
-    using T = double;
-
-    // Параметры теста
-    size_t n = 500; 
-    double sparsity = 0.01; // доля ненулевых элементов (1% ненулевых)
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<T> dist_val(0.0, 10.0);
-    std::uniform_real_distribution<double> dist_sparse(0.0, 1.0);
-
-    // Генерируем разреженную матрицу
-    SparseMatrix<T> sparseMat(n, n);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            double p = dist_sparse(gen);
-            if (p < sparsity) {
-                T val = dist_val(gen);
-                sparseMat.setElement(i, j, val);
-            }
-        }
-    }
-
-    // Генерируем плотную матрицу
-    DenseMatrix<T> denseMat(n, n);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            double p = dist_sparse(gen);
-            if (p < sparsity) {
-                denseMat(i, j) = dist_val(gen);
-            }
-            else {
-                denseMat(i, j) = 0.0;
-            }
-        }
-    }
-
-    // Сравним умножение матриц sparseMat*sparseMat и denseMat*denseMat
-    // Измеряем время для разреженной матрицы
-    auto start = std::chrono::high_resolution_clock::now();
-    auto sparseRes = sparseMat * sparseMat;
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> sparseTime = end - start;
-    std::cout << "Sparse multiplication time: " << sparseTime.count() << " s\n";
-
-    // Измеряем время для плотной матрицы
-    start = std::chrono::high_resolution_clock::now();
-    auto denseRes = denseMat * denseMat;
-    end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> denseTime = end - start;
-    std::cout << "Dense multiplication time: " << denseTime.count() << " s\n";
-
-    // Возведение в степень (целочисленное)
-    int exp = 2;
-    start = std::chrono::high_resolution_clock::now();
-    auto sparsePow = sparseMat.integerPower(exp);
-    end = std::chrono::high_resolution_clock::now();
-    std::cout << "Sparse integerPower time: " << (end - start).count() / 1e9 << " s\n";
-
-    std::cout << "All performance tests done.\n";
+    testShiftedOperations();
+    testElementwiseOperations();
+    testMatrixFormats();
+    testSellMatrix();
+    testReordering();
+    testProfiler();
+    testAutoTune();
+    testSmallMatrix();
+    testMixedPrecision();
+    testCompressedIndices();
+    testOutOfCore();
+    testDistributed();
+    testAssembly();
+    testWorkload();
+
+    // Замеры производительности вынесены в бенчмарки (make bench)
+    std::cout << "All tests done.\n";
 
     return 0;
 }
@@ -421,4 +343,999 @@ void testVectorRealis() {
     assert(vec.size() == 0);
 
     std::cout << "All tests passed successfully!" << std::endl;
-}
\ No newline at end of file
+}
+void testShiftedOperations() {
+    // A = [[1,0,0],[0,2,0],[0,0,3]], A + 5 для всех элементов
+    SparseMatrix<int> A(3, 3);
+    A.setElement(0, 0, 1);
+    A.setElement(1, 1, 2);
+    A.setElement(2, 2, 3);
+
+    auto S = shifted(A, 5);
+    // Хранятся только 3 элемента, но доступ дает сдвинутые значения
+    assert(S.base().size() == 3);
+    assert(S(0, 0) == 6);
+    assert(S(0, 1) == 5);
+    assert(S(2, 0) == 5);
+    assert(S.sum() == 6 + 45);
+
+    // SpMV: (A + 5*1*1^T) x = A x + 5 * sum(x) * 1
+    SparseVector<int> x(3);
+    x.setElement(0, 2);
+    x.setElement(2, 4);
+    auto y = S * x;
+    auto yRef = S.materialize() * x;
+    for (size_t i = 0; i < 3; ++i) {
+        assert(y[i] == yRef[i]);
+    }
+    assert(y[1] == 30);
+
+    // Умножение на сдвинутый вектор (x + 1)
+    auto xs = shifted(x, 1, 3);
+    auto z = S * xs;
+    auto zRef = S.materialize() * xs.materialize();
+    for (size_t i = 0; i < 3; ++i) {
+        assert(z[i] == zRef[i]);
+    }
+
+    // Скалярное произведение и нормы без уплотнения
+    auto ys = shifted(x, -1, 3);
+    assert(xs.dot(ys) == xs.materialize().dot(ys.materialize()));
+    assert(xs.norm1() == 3 + 1 + 5);
+    assert(xs.normInf() == 5);
+    assert(std::abs(S.frobeniusNorm() - S.materialize().frobeniusNorm()) < 1e-9);
+
+    // Поэлементные операции остаются в сдвинутом представлении
+    auto P = S.cwiseProduct(shifted(A, 2));
+    assert(P.shift() == 10);
+    assert(P(0, 0) == 6 * 3);
+    assert(P(1, 2) == 10);
+    assert((S * 2 - 10) == shifted(A * 2, 0));
+
+    std::cout << "All shifted matrix tests passed successfully!" << std::endl;
+}
+
+void testElementwiseOperations() {
+    // A = [[2,0,3],[0,4,0]], B = [[5,1,0],[0,2,-1]]
+    SparseMatrix<int> A(2, 3);
+    A.setElement(0, 0, 2);
+    A.setElement(0, 2, 3);
+    A.setElement(1, 1, 4);
+    SparseMatrix<int> B(2, 3);
+    B.setElement(0, 0, 5);
+    B.setElement(0, 1, 1);
+    B.setElement(1, 1, 2);
+    B.setElement(1, 2, -1);
+
+    // Адамарово произведение - только пересечение шаблонов
+    auto P = A.cwiseProduct(B);
+    assert(P.size() == 2);
+    assert(P(0, 0) == 10);
+    assert(P(1, 1) == 8);
+
+    // Деление на неявный ноль запрещено
+    auto Q = P.cwiseQuotient(B);
+    assert(Q == A.cwiseProduct(B).cwiseQuotient(B));
+    assert(Q(0, 0) == 2);
+    bool thrown = false;
+    try {
+        A.cwiseQuotient(B);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Максимум и минимум с неявными нулями
+    auto M = A.cwiseMax(B);
+    assert(M(0, 0) == 5 && M(0, 1) == 1 && M(0, 2) == 3 && M(1, 2) == 0);
+    assert(M.size() == 4);
+    auto m = A.cwiseMin(B);
+    assert(m(1, 2) == -1 && m(0, 1) == 0 && m(0, 0) == 2);
+
+    // map и reduce над хранимыми элементами
+    auto sq = A.map([](int v) { return v * v; });
+    assert(sq == A.powerAll(2));
+    assert(A.reduce([](int acc, int v) { return acc + v; }) == 9);
+    assert(A.reduce(std::plus<int>()) == 9 && A.reduce(std::plus<>(), 1) == 10);
+    // Функция с состоянием вызывается по порядку хранимых элементов
+    int counter = 0;
+    auto numbered = A.map([&counter](int) { return ++counter; });
+    assert(numbered.reduce([](int acc, int v) { return acc * 10 + v; }) == 123);
+    assert(A.powerAll(3)(0, 2) == 27);
+    assert(A.powerAll(0)(1, 1) == 1);
+
+    // Нецелый показатель идет через pow
+    SparseMatrix<double> D(2, 2);
+    D.setElement(0, 0, 4.0);
+    D.setElement(1, 1, 9.0);
+    assert(std::abs(D.powerAll(0.5)(1, 1) - 3.0) < 1e-12);
+    assert(D.cwiseSqrt() == D.powerAll(0.5));
+
+    // Векторные аналоги
+    SparseVector<int> u(5);
+    u.setElement(1, 3);
+    u.setElement(3, -2);
+    SparseVector<int> v(5);
+    v.setElement(1, 4);
+    v.setElement(4, 7);
+    assert(u.cwiseProduct(v).size() == 1);
+    assert(u.cwiseProduct(v)[1] == 12);
+    assert(u.cwiseMax(v)[3] == 0 && u.cwiseMax(v)[4] == 7);
+    assert(u.cwiseMin(v)[3] == -2 && u.cwiseMin(v)[4] == 0);
+    assert(u.map([](int x) { return 2 * x; }) == u * 2);
+    assert(u.reduce([](int acc, int x) { return std::max(acc, x); }) == 3);
+    assert(u.powerAll(2)[3] == 4);
+
+    // Сдвинутая матрица поэлементно с обычной остается разреженной
+    auto SB = shifted(A, 1).cwiseProduct(B);
+    assert(SB(0, 0) == 15 && SB(0, 1) == 1 && SB(1, 2) == -1);
+
+    std::cout << "All elementwise tests passed successfully!" << std::endl;
+}
+
+void testMatrixFormats() {
+    const size_t n = 12;
+
+    // Трехдиагональная матрица -> DIA
+    SparseMatrix<double> tri(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        tri.setElement(i, i, 4.0);
+        if (i > 0) tri.setElement(i, i - 1, -1.0);
+        if (i + 1 < n) tri.setElement(i, i + 1, -2.0);
+    }
+
+    // Блочно-диагональная с плотными блоками 4x4 -> BSR
+    SparseMatrix<double> blk(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = (i / 4) * 4; j < (i / 4) * 4 + 4; ++j) {
+            blk.setElement(i, j, 1.0 + i + 0.5 * j);
+        }
+    }
+
+    // Нерегулярная матрица -> CSR
+    SparseMatrix<double> irr(n, n);
+    irr.setElement(0, 7, 3.0);
+    irr.setElement(2, 11, 1.5);
+    irr.setElement(5, 0, -2.0);
+    irr.setElement(9, 4, 6.0);
+    irr.setElement(11, 11, 1.0);
+
+    std::vector<double> x(n);
+    SparseVector<double> xs(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 1.0 + 0.25 * i;
+        xs.setElement(i, x[i]);
+    }
+
+    auto checkSpmv = [&](const SparseMatrix<double>& A, const std::vector<double>& y) {
+        auto ref = A * xs;
+        for (size_t i = 0; i < A.rows(); ++i) {
+            assert(std::abs(y[i] - ref[i]) < 1e-9);
+        }
+    };
+    auto checkEqual = [](const SparseMatrix<double>& A, const SparseMatrix<double>& B) {
+        for (size_t i = 0; i < A.rows(); ++i) {
+            for (size_t j = 0; j < A.cols(); ++j) {
+                assert(std::abs(A(i, j) - B(i, j)) < 1e-9);
+            }
+        }
+    };
+
+    FormattedMatrix<double> fTri(tri), fBlk(blk), fIrr(irr);
+    FormattedMatrix<double> fId(SparseMatrix<double>::identity(n) * 3.0);
+    assert(fTri.format() == MatrixFormat::Dia);
+    assert(fBlk.format() == MatrixFormat::Bsr);
+    assert(fBlk.info().bestBlockSize == 4);
+    assert(fIrr.format() == MatrixFormat::Csr);
+    assert(fId.format() == MatrixFormat::Identity);
+
+    checkSpmv(tri, fTri * x);
+    checkSpmv(blk, fBlk * x);
+    checkSpmv(irr, fIrr * x);
+    checkSpmv(tri, CsrMatrix<double>(tri) * x);
+
+    // SpGEMM каждым ядром сверяем с общим умножением
+    checkEqual(fTri * fTri, tri * tri);
+    checkEqual(fBlk * fBlk, blk * blk);
+    checkEqual(fIrr * fIrr, irr * irr);
+    checkEqual(fTri * fBlk, tri * blk);
+    checkEqual(fId * fBlk, blk * 3.0);
+    checkEqual(fTri * fId, tri * 3.0);
+
+    // BSR с разными размерами блоков (4 и 2) - через CSR, а не исключение;
+    // блоки 2x2 по побочной диагонали, чтобы не выбиралась лента
+    SparseMatrix<double> blk2(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t first = n - 2 - (i / 2) * 2;
+        for (size_t j = first; j < first + 2; ++j) {
+            blk2.setElement(i, j, 2.0 - 0.5 * i + j);
+        }
+    }
+    FormattedMatrix<double> fBlk2(blk2);
+    assert(fBlk2.format() == MatrixFormat::Bsr);
+    assert(fBlk2.info().bestBlockSize == 2);
+    checkEqual(fBlk * fBlk2, blk * blk2);
+    checkEqual(fBlk2 * fBlk, blk2 * blk);
+
+    // Прямоугольные ленточная и блочная матрицы
+    SparseMatrix<double> rect(5, 8);
+    for (size_t i = 0; i < 5; ++i) {
+        rect.setElement(i, i + 2, 1.0 + i);
+        rect.setElement(i, i + 3, 2.0);
+    }
+    DiaMatrix<double> dRect(rect);
+    checkEqual((dRect * DiaMatrix<double>(rect.transpose())).toSparse(), rect * rect.transpose());
+    checkEqual(BsrMatrix<double>(rect, 3).toSparse(), rect);
+    checkEqual((BsrMatrix<double>(rect, 3) * BsrMatrix<double>(rect.transpose(), 3)).toSparse(),
+        rect * rect.transpose());
+
+    // Символьная единичная матрица
+    ScaledIdentity<double> I(n, 2.0);
+    checkEqual(tri * I, tri * 2.0);
+    checkEqual(I * tri, tri * 2.0);
+    assert((I * I).scale() == 4.0);
+    SparseVector<double> w(n);
+    w.setElement(1, 3.0);
+    assert((I * w)[1] == 6.0);
+    bool thrown = false;
+    try {
+        I * SparseVector<double>(n + 1);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(tri.integerPower(1) == tri);
+    checkEqual(tri.integerPower(3), tri * tri * tri);
+
+    std::cout << "All matrix format tests passed successfully!" << std::endl;
+}
+
+void testSellMatrix() {
+    // Строки разной длины: 0, 1, ..., 7 элементов, плюс пустые строки
+    const size_t n = 19;
+    SparseMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = 0; k < i % 8; ++k) {
+            A.setElement(i, (i * 7 + k * 3) % n, 1.0 + 0.5 * k - 0.1 * i);
+        }
+    }
+    std::vector<double> x(n);
+    SparseVector<double> xs(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 2.0 - 0.3 * i;
+        xs.setElement(i, x[i]);
+    }
+    auto ref = A * xs;
+
+    // Разные высоты чанка (в том числе не кратные ширине SIMD) и окна сортировки
+    const size_t chunkHeights[] = { 1, 3, 4, 8, 16 };
+    const size_t sigmas[] = { 1, 4, 100 };
+    for (size_t C : chunkHeights) {
+        for (size_t sigma : sigmas) {
+            SellMatrix<double> sell(A, C, sigma);
+            auto y = sell * x;
+            for (size_t i = 0; i < n; ++i) {
+                assert(std::abs(y[i] - ref[i]) < 1e-9);
+            }
+        }
+    }
+
+    // Сортировка внутри окна уменьшает дополнение нулями
+    assert(SellMatrix<double>(A, 4, 100).fillEfficiency() >= SellMatrix<double>(A, 4, 1).fillEfficiency());
+
+    SellMatrix<int> sellInt(SparseMatrix<int>::identity(5) * 3, 4, 2);
+    std::vector<int> yInt = sellInt * std::vector<int>{ 1, 2, 3, 4, 5 };
+    assert(yInt == (std::vector<int>{ 3, 6, 9, 12, 15 }));
+
+    std::cout << "All SELL matrix tests passed successfully!" << std::endl;
+}
+
+void testReordering() {
+    // Сетка 8x8 (5-точечный лапласиан) с перемешанной нумерацией узлов
+    const size_t side = 8;
+    const size_t n = side * side;
+    std::vector<size_t> scramble(n);
+    for (size_t i = 0; i < n; ++i) scramble[i] = (i * 37 + 11) % n;
+    SparseMatrix<double> grid(n, n);
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            size_t v = scramble[r * side + c];
+            grid.setElement(v, v, 4.0);
+            if (r > 0) grid.setElement(v, scramble[(r - 1) * side + c], -1.0);
+            if (r + 1 < side) grid.setElement(v, scramble[(r + 1) * side + c], -1.0);
+            if (c > 0) grid.setElement(v, scramble[r * side + c - 1], -1.0);
+            if (c + 1 < side) grid.setElement(v, scramble[r * side + c + 1], -1.0);
+        }
+    }
+
+    auto isPermutation = [n](std::vector<size_t> p) {
+        std::sort(p.begin(), p.end());
+        for (size_t i = 0; i < n; ++i) {
+            if (p[i] != i) return false;
+        }
+        return p.size() == n;
+    };
+
+    auto before = bandwidthMetrics(grid);
+    auto rcm = reverseCuthillMcKee(grid);
+    assert(isPermutation(rcm));
+    auto gridRcm = permute(grid, rcm);
+    auto after = bandwidthMetrics(gridRcm);
+    // Для сетки side x side RCM дает ленту порядка side
+    assert(after.bandwidth <= side + 1);
+    assert(after.bandwidth < before.bandwidth);
+    assert(after.profile < before.profile);
+
+    // Перестановка сохраняет значения и обращается обратной
+    assert(gridRcm.size() == grid.size());
+    assert(permute(gridRcm, invertPermutation(rcm)) == grid);
+    SparseVector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x.setElement(i, 1.0 + i);
+    auto y = grid * x;
+    auto yPerm = gridRcm * permute(x, rcm);
+    for (size_t i = 0; i < n; ++i) {
+        assert(std::abs(yPerm[i] - y[rcm[i]]) < 1e-12);
+    }
+    bool thrown = false;
+    try {
+        permute(x, std::vector<size_t>(rcm.begin(), rcm.end() - 1));
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Несимметричная перестановка P * A * Q^T
+    std::vector<size_t> q(n);
+    for (size_t i = 0; i < n; ++i) q[i] = n - 1 - i;
+    auto pq = permute(grid, rcm, q);
+    assert(pq(0, 0) == grid(rcm[0], q[0]));
+    assert(pq(5, 17) == grid(rcm[5], q[17]));
+
+    // AMD: "стрелочная" матрица - центральный узел исключается в самом конце
+    // (при равных степенях он может опередить последний лист)
+    SparseMatrix<double> arrow(10, 10);
+    for (size_t i = 0; i < 10; ++i) {
+        arrow.setElement(i, i, 2.0);
+        arrow.setElement(0, i, 1.0);
+        arrow.setElement(i, 0, 1.0);
+    }
+    auto amd = approximateMinimumDegree(arrow);
+    assert(amd.size() == 10 && (amd[8] == 0 || amd[9] == 0));
+    assert(isPermutation(approximateMinimumDegree(grid)));
+
+    // Многоуровневая бисекция выравнивает блоки по связности сетки
+    auto bis = multilevelBisectionOrdering(grid, 8);
+    assert(isPermutation(bis));
+    assert(bandwidthMetrics(permute(grid, bis)).averageDistance < before.averageDistance);
+
+    std::cout << "All reordering tests passed successfully!" << std::endl;
+}
+
+// Счетчики проверяются только в сборке с -DSPARSE_PROFILING,
+// без флага API должен возвращать пустые снимки
+void testProfiler() {
+    profiler::reset();
+    profiler::setTracing(true);
+
+    SparseMatrix<double> A(3, 3);
+    A.setElement(0, 0, 1.0);
+    A.setElement(1, 1, 2.0);
+    A.setElement(2, 0, 3.0);
+    SparseVector<double> x(3);
+    x.setElement(0, 1.0);
+    x.setElement(1, 1.0);
+    auto y = A * x;
+    auto E = (A * 0.1).exp(5);
+    assert(y[1] == 2.0 && E.size() > 0);
+
+    profiler::Snapshot snap = profiler::snapshot();
+    std::ostringstream trace;
+    profiler::writeChromeTrace(trace);
+    assert(trace.str().find("traceEvents") != std::string::npos);
+    profiler::setTracing(false);
+
+    if constexpr (profiler::enabled) {
+        const profiler::OpStats* set = snap.find("SparseMatrix::setElement");
+        assert(set && set->calls >= 3 && set->allocations >= 6);
+
+        const profiler::OpStats* spmv = snap.find("SparseMatrix::spmv");
+        assert(spmv && spmv->calls == 1);
+        assert(spmv->flops == 6 && spmv->nnzIn == 5 && spmv->nnzOut == 3);
+
+        // exp включает вложенные умножения: полное время не меньше собственного,
+        // выделения узлов результатов засчитываются и exp
+        const profiler::OpStats* exp = snap.find("SparseMatrix::exp");
+        const profiler::OpStats* gemm = snap.find("SparseMatrix::spgemm");
+        assert(exp && gemm && exp->calls == 1 && gemm->calls == 3);
+        assert(exp->totalNs >= exp->selfNs);
+        assert(exp->flops >= gemm->flops && exp->allocations > 0);
+
+        assert(trace.str().find("\"SparseMatrix::spgemm\"") != std::string::npos);
+    }
+    else {
+        assert(snap.ops.empty());
+    }
+
+    std::cout << "All profiler tests passed successfully!" << std::endl;
+}
+
+void testAutoTune() {
+    // Фиксированная модель машины - решения не зависят от замеров
+    MachineModel machine;
+    machine.threads = 4;
+
+    const size_t n = 200;
+    SparseMatrix<double> tri(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        tri.setElement(i, i, 2.0);
+        if (i > 0) tri.setElement(i, i - 1, -1.0);
+        if (i + 1 < n) tri.setElement(i, i + 1, -1.0);
+    }
+    TuneFeatures f = computeFeatures(tri);
+    assert(f.bandwidth == 1 && f.structure.numDiagonals == 3 && f.maxRowLength == 3);
+    assert(std::abs(f.meanRowLength - 598.0 / n) < 1e-12);
+    assert(f.rowLengthVariance > 0 && f.sellFill > 0.9);
+
+    // Хеш зависит от шаблона, но не от значений...
+    assert(structureHash(tri) == structureHash(tri * 3.0));
+    SparseMatrix<double> triMod = tri;
+    triMod.setElement(0, 5, 1.0);
+    assert(structureHash(triMod) != structureHash(tri));
+    // ...и типа значений: решение для float не переносится на double
+    SparseMatrix<float> triFloat(n, n);
+    for (auto it = tri.cbegin(); it != tri.cend(); ++it) {
+        triFloat.setElement(it->first.first, it->first.second, static_cast<float>(it->second));
+    }
+    assert(structureHash(triFloat) != structureHash(tri));
+
+    // Лента: по модели DIA дешевле CSR, и SpGEMM тоже в DIA
+    AutoTuner predictor(AutoTuner::Mode::Predict);
+    predictor.setMachine(machine);
+    TuneDecision d = predictor.tune(tri);
+    assert(d.kernel == SpmvKernel::Dia && d.threads == 1 && d.spgemmFormat == MatrixFormat::Dia);
+    assert(predictor.misses() == 1);
+    predictor.tune(tri * 2.0);
+    assert(predictor.hits() == 1 && predictor.cacheSize() == 1);
+
+    // DIA SpGEMM пробуется только без раздувания: лента - да, 64 редко
+    // заполненные разбросанные диагонали большой матрицы - нет
+    assert(diaSpgemmFits(computeFeatures(tri)));
+    const size_t big = 20000;
+    SparseMatrix<double> scattered(big, big);
+    for (size_t k = 0; k < 64; ++k) {
+        size_t offset = k * 311;
+        for (size_t i = 0; i + offset < big; i += 997) scattered.setElement(i, i + offset, 1.0);
+    }
+    assert(computeFeatures(scattered).structure.numDiagonals == 64);
+    assert(!diaSpgemmFits(computeFeatures(scattered)));
+
+    // Все ядра дают одинаковый результат
+    SparseMatrix<double> irregular(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; j += 1 + (i * 7 + j) % 23) {
+            irregular.setElement(i, j, 0.5 + static_cast<double>((i + 3 * j) % 11));
+        }
+    }
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = 1.0 + 0.01 * static_cast<double>(i);
+    std::vector<double> expected = CsrMatrix<double>(irregular) * x;
+    const SpmvKernel kernels[] = { SpmvKernel::Csr, SpmvKernel::Sell, SpmvKernel::Dia, SpmvKernel::Bsr, SpmvKernel::Dense };
+    for (SpmvKernel k : kernels) {
+        for (unsigned threads : { 1u, 3u }) {
+            TuneDecision forced;
+            forced.kernel = k;
+            forced.threads = threads;
+            forced.blockSize = 4;
+            auto y = TunedMatrix<double>(irregular, forced) * x;
+            for (size_t i = 0; i < n; ++i) {
+                assert(std::abs(y[i] - expected[i]) < 1e-9 * std::abs(expected[i]) + 1e-12);
+            }
+        }
+    }
+
+    // Замер + постоянный кэш: новый тюнер находит решение в файле
+    std::string path = (std::filesystem::temp_directory_path() / "fth_autotune_test.cache").string();
+    std::remove(path.c_str());
+    TuneDecision measured;
+    {
+        AutoTuner tuner(AutoTuner::Mode::Measure, path);
+        tuner.setMachine(machine);
+        measured = tuner.tune(irregular);
+        assert(measured.measuredNs > 0 && tuner.misses() == 1);
+        auto tuned = tuner.prepare(irregular);
+        assert(tuner.hits() == 1);
+        auto y = tuned * x;
+        assert(std::abs(y[7] - expected[7]) < 1e-9 * expected[7]);
+        assert(tuner.multiply(tri, tri) == tri * tri);
+    }
+    {
+        AutoTuner reloaded(AutoTuner::Mode::Measure, path);
+        assert(reloaded.cacheSize() == 2 && reloaded.contains(structureHash(irregular)));
+        TuneDecision again = reloaded.tune(irregular);
+        assert(reloaded.hits() == 1 && reloaded.misses() == 0);
+        assert(again.kernel == measured.kernel && again.threads == measured.threads);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "All autotune tests passed successfully!" << std::endl;
+}
+
+void testSmallMatrix() {
+    // Явные формулы 2x2 и 3x3
+    SmallMatrix<double, 2, 2> a;
+    a(0, 0) = 1; a(0, 1) = 2;
+    a(1, 0) = 3; a(1, 1) = 4;
+    assert(a.determinant() == -2.0);
+    auto aInv = a.inverse();
+    assert(std::abs(aInv(0, 0) + 2.0) < 1e-12 && std::abs(aInv(1, 0) - 1.5) < 1e-12);
+    assert(a * aInv == (SmallMatrix<double, 2, 2>::identity()));
+
+    // Произведение разных размеров и транспонирование
+    SmallMatrix<int, 2, 3> b;
+    SmallMatrix<int, 3, 2> c;
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            b(i, j) = static_cast<int>(i + j);
+            c(j, i) = static_cast<int>(i * j + 1);
+        }
+    }
+    auto bc = b * c;
+    static_assert(decltype(bc)::rows() == 2 && decltype(bc)::cols() == 2, "2x3 * 3x2 = 2x2");
+    assert(bc(0, 0) == 0 * 1 + 1 * 1 + 2 * 1 && bc(1, 1) == 1 * 1 + 2 * 2 + 3 * 3);
+    assert(b.transpose()(2, 1) == 3);
+    std::array<int, 3> v = { 1, 1, 1 };
+    assert((b * v)[1] == 6);
+
+    // LU для 6x6: A * A^-1 = I, определитель треугольной - произведение диагонали
+    SmallMatrix<double, 6, 6> m;
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            m(i, j) = (i == j) ? 10.0 : 1.0 / static_cast<double>(1 + i + 2 * j);
+        }
+    }
+    auto check = m * m.inverse();
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            assert(std::abs(check(i, j) - (i == j ? 1.0 : 0.0)) < 1e-12);
+        }
+    }
+    SmallMatrix<double, 4, 4> upper;
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = i; j < 4; ++j) upper(i, j) = static_cast<double>(i + j + 1);
+    }
+    assert(std::abs(upper.determinant() - 1.0 * 3.0 * 5.0 * 7.0) < 1e-9);
+
+    // Вырожденная матрица
+    SmallMatrix<double, 4, 4> singular;
+    bool thrown = false;
+    try {
+        singular.inverse();
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // SparseMatrix сама переходит на фиксированный размер
+    SparseMatrix<double> sparse(6, 6);
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 6; ++j) sparse.setElement(i, j, m(i, j));
+    }
+    assert((SmallMatrix<double, 6, 6>(sparse) == m));
+    auto sparseInv = sparse.inverse();
+    auto smallInv = m.inverse();
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 6; ++j) assert(sparseInv(i, j) == smallInv(i, j));
+    }
+    auto product = sparse * sparseInv;
+    assert(product.rows() == 6 && std::abs(product(3, 3) - 1.0) < 1e-12);
+    assert(m.toSparse() == sparse);
+
+    std::cout << "All small matrix tests passed successfully!" << std::endl;
+}
+
+void testMixedPrecision() {
+    // bfloat16: точные малые целые, округление к ближайшему четному
+    assert(static_cast<float>(bfloat16(1.0f)) == 1.0f);
+    assert(static_cast<float>(bfloat16(-3.0f)) == -3.0f);
+    assert(static_cast<float>(bfloat16(1.0f + 1.0f / 256)) == 1.0f);
+    assert(static_cast<float>(bfloat16(1.0f + 3.0f / 256)) == 1.0f + 1.0f / 64);
+    assert(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+
+    // Несимметричная матрица с диагональным преобладанием
+    const size_t n = 200;
+    SparseMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        A.appendElement(i, i, 4.0 + 0.01 * static_cast<double>(i % 7));
+        if (i + 1 < n) A.appendElement(i, i + 1, -1.0 / 3.0);
+        if (i + 7 < n) A.appendElement(i, i + 7, 0.1);
+        if (i >= 2) A.setElement(i, i - 2, -0.7);
+    }
+    std::vector<double> xTrue(n);
+    for (size_t i = 0; i < n; ++i) xTrue[i] = std::sin(static_cast<double>(i));
+    CsrMatrix<double> csr(A);
+    std::vector<double> b = csr * xTrue;
+
+    // Компактные форматы: SpMV совпадает с точностью хранения значений
+    CompactCsrMatrix<float> single(A);
+    CompactCsrMatrix<bfloat16> half(A);
+    CompactCsrMatrix<double> full(A);
+    assert(single.nnz() == A.size() && half.nnz() == A.size());
+    assert(half.bytes() < single.bytes() && single.bytes() < full.bytes());
+    assert(full(5, 6) == -1.0 / 3.0 && full(5, 9) == 0.0);
+    std::vector<double> yFull = full * xTrue;
+    std::vector<double> ySingle = single * xTrue;
+    std::vector<double> yHalf;
+    half.spmv(xTrue, yHalf, 2);
+    for (size_t i = 0; i < n; ++i) {
+        assert(std::abs(yFull[i] - b[i]) < 1e-12);
+        assert(std::abs(ySingle[i] - b[i]) < 1e-6);
+        assert(std::abs(yHalf[i] - b[i]) < 5e-2);
+    }
+
+    // BiCGSTAB в double
+    std::vector<double> x;
+    auto direct = solvers::bicgstab(csr, b, x, 1e-12);
+    assert(direct.converged);
+    for (size_t i = 0; i < n; ++i) assert(std::abs(x[i] - xTrue[i]) < 1e-9);
+
+    // Уточнение: внутренние решения по float / bfloat16, ответ с точностью double
+    std::vector<double> xSingle, xHalf;
+    auto refSingle = solvers::refine(csr, single, b, xSingle, 1e-12);
+    auto refHalf = solvers::refine(csr, half, b, xHalf, 1e-12);
+    assert(refSingle.converged && refHalf.converged);
+    assert(refSingle.iterations > 1 && refHalf.iterations >= refSingle.iterations);
+    for (size_t i = 0; i < n; ++i) {
+        assert(std::abs(xSingle[i] - xTrue[i]) < 1e-9);
+        assert(std::abs(xHalf[i] - xTrue[i]) < 1e-9);
+    }
+
+    // Только bfloat16 без уточнения дает лишь ~2-3 верных знака
+    std::vector<double> xLow;
+    solvers::bicgstab(half, b, xLow, 1e-12);
+    double lowError = 0.0;
+    for (size_t i = 0; i < n; ++i) lowError = std::max(lowError, std::abs(xLow[i] - xTrue[i]));
+    assert(lowError > 1e-6);
+
+    // Нулевая правая часть и несовпадение размеров
+    std::vector<double> zero(n, 0.0), xZero(n, 1.0);
+    assert(solvers::refine(csr, single, zero, xZero).converged && xZero[0] == 0.0);
+    bool thrown = false;
+    try {
+        std::vector<double> shortB(n - 1, 1.0);
+        solvers::bicgstab(csr, shortB, x);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All mixed precision tests passed successfully!" << std::endl;
+}
+
+void testCompressedIndices() {
+    // Пустые строки, сплошной участок (ширина 0), большие разности
+    const size_t n = 300;
+    SparseMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 10 == 3) continue;
+        if (i % 10 == 5) {
+            for (size_t j = 100; j < 140; ++j) A.appendElement(i, j, static_cast<double>(j));
+            continue;
+        }
+        for (size_t j = i % 17; j < n; j += 1 + (i * j) % 23) {
+            A.appendElement(i, j, 1.0 + static_cast<double>(i + j) / 7.0);
+        }
+    }
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = 1.0 / static_cast<double>(i + 1);
+    std::vector<double> expected = CsrMatrix<double>(A) * x;
+
+    for (IndexEncoding encoding : { IndexEncoding::Varint, IndexEncoding::BitPacked }) {
+        CompressedCsrMatrix<double> c(A, encoding);
+        assert(c.encoding() == encoding && c.nnz() == A.size());
+        assert(c.rowLength(3) == 0 && c.rowLength(5) == 40);
+        std::vector<size_t> row5 = c.decodeRow(5);
+        assert(row5.front() == 100 && row5.back() == 139);
+        assert(c.toSparse() == A);
+        std::vector<double> y = c * x;
+        std::vector<double> yThreads;
+        c.spmv(x, yThreads, 3);
+        for (size_t i = 0; i < n; ++i) {
+            assert(std::abs(y[i] - expected[i]) < 1e-9);
+            assert(y[i] == yThreads[i]);
+        }
+        assert(c.compressionRatio() > 2.0);
+    }
+
+    // Столбцы за пределами 32 бит: разности шире 32 бит тоже восстанавливаются
+    const size_t huge = size_t{ 1 } << 40;
+    SparseMatrix<float> wide(2, huge);
+    wide.appendElement(0, 7, 1.0f);
+    wide.appendElement(0, huge / 3, 2.0f);
+    wide.appendElement(0, huge - 1, 3.0f);
+    wide.appendElement(1, huge - 2, 4.0f);
+    for (IndexEncoding encoding : { IndexEncoding::Varint, IndexEncoding::BitPacked }) {
+        CompressedCsrMatrix<float> c(wide, encoding);
+        std::vector<size_t> row0 = c.decodeRow(0);
+        assert(row0.size() == 3 && row0[0] == 7 && row0[1] == huge / 3 && row0[2] == huge - 1);
+        assert(c.decodeRow(1)[0] == huge - 2);
+        assert(c.toSparse() == wide);
+    }
+
+    // Несовпадение размеров
+    bool thrown = false;
+    try {
+        CompressedCsrMatrix<double>(A) * std::vector<double>(n + 1, 1.0);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All compressed index tests passed successfully!" << std::endl;
+}
+
+void testOutOfCore() {
+    namespace fs = std::filesystem;
+    std::string path = (fs::temp_directory_path() / "fth_outofcore_a.panels").string();
+    std::string productPath = (fs::temp_directory_path() / "fth_outofcore_ab.panels").string();
+
+    const size_t n = 300;
+    SparseMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 50 == 7) continue;      // пустые строки
+        for (size_t j = i % 5; j < n; j += 29) {
+            A.appendElement(i, j, static_cast<double>(i + 1) / static_cast<double>(j + 2));
+        }
+    }
+    SparseMatrix<double> B(n, 40);
+    for (size_t i = 0; i < n; i += 3) {
+        B.appendElement(i, i % 40, 1.0 + static_cast<double>(i));
+        B.appendElement(i, (i * 7) % 40 == i % 40 ? (i + 1) % 40 : (i * 7) % 40, -0.5);
+    }
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = std::cos(static_cast<double>(i));
+
+    // Бюджет 8 КБ: полосы по 2 КБ, матрица делится на десятки полос
+    const size_t budget = 8192;
+    {
+        OutOfCoreMatrix<double> ooc = OutOfCoreMatrix<double>::create(A, path, budget);
+        assert(ooc.rows() == n && ooc.cols() == n && ooc.nnz() == A.size());
+        assert(ooc.panelCount() > 10 && 4 * ooc.maxPanelBytes() <= budget);
+        assert(ooc.toSparse() == A);
+
+        std::vector<double> expected = CsrMatrix<double>(A) * x;
+        std::vector<double> y = ooc * x;
+        for (size_t i = 0; i < n; ++i) assert(std::abs(y[i] - expected[i]) < 1e-12);
+
+        // SpGEMM: результат тоже на диске и тоже полосами
+        CsrMatrix<double> csrB(B);
+        OutOfCoreMatrix<double> product = ooc.multiply(csrB, productPath);
+        assert(product.rows() == n && product.cols() == 40);
+        assert(4 * product.maxPanelBytes() <= budget);
+        assert(product.toSparse() == (CsrMatrix<double>(A) * csrB).toSparse());
+
+        // Повторное открытие существующего файла
+        OutOfCoreMatrix<double> reopened(path, budget);
+        assert(reopened.panelCount() == ooc.panelCount() && reopened.toSparse() == A);
+
+        // Впритык для SpMV, но полоса результата SpGEMM уже не помещается
+        OutOfCoreMatrix<double> tight(path, 2 * ooc.maxPanelBytes());
+        assert(tight * x == y);
+        bool thrown = false;
+        try {
+            tight.multiply(csrB, productPath);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Полосы не помещаются в бюджет, чужой файл, неверные размеры
+    bool thrown = false;
+    try {
+        OutOfCoreMatrix<double> tooSmall(path, 1024);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        OutOfCoreMatrix<float> wrongType(path, budget);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        OutOfCoreMatrix<double>(path, budget) * std::vector<double>(n + 1, 1.0);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    fs::remove(path);
+    fs::remove(productPath);
+    std::cout << "All out-of-core tests passed successfully!" << std::endl;
+}
+
+void testDistributed() {
+    // Разбиения: равные блоки, по числу ненулевых, владелец индекса
+    assert((distributed::rowBlocks(10, 3) == std::vector<size_t>{ 0, 3, 6, 10 }));
+    assert(distributed::owner({ 0, 3, 6, 10 }, 0) == 0 && distributed::owner({ 0, 3, 6, 10 }, 6) == 2);
+
+    const size_t n = 120;
+    SparseMatrix<double> A(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        A.appendElement(i, i, 4.0);
+        if (i >= 1) A.setElement(i, i - 1, -1.0);
+        if (i + 1 < n) A.setElement(i, i + 1, -1.0);
+        if (i % 10 == 0) A.setElement(i, (i * 37 + 11) % n, 0.5);     // дальние связи
+    }
+    // Тяжелые строки в начале: сбалансированные блоки короче равных
+    for (size_t j = 0; j < n; j += 2) A.setElement(0, j, 1.0);
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<double>(i % 13) - 6.0;
+    std::vector<double> expected = CsrMatrix<double>(A) * x;
+
+    for (int ranks : { 1, 3, 4 }) {
+        for (bool balanced : { false, true }) {
+            std::vector<size_t> bounds = balanced ? distributed::balancedRowBlocks(A, ranks)
+                : distributed::rowBlocks(n, ranks);
+            assert(bounds.size() == static_cast<size_t>(ranks) + 1 && bounds.back() == n);
+            std::vector<double> y(n, 0.0);
+            std::vector<size_t> haloSizes(ranks);
+            LocalHub hub(ranks);
+            distributed::runLocal(hub, [&](Transport& transport) {
+                auto dist = DistributedMatrix<double>::fromGlobal(A, bounds, transport);
+                haloSizes[transport.rank()] = dist.haloSize();
+                std::vector<double> yLocal;
+                // Два умножения подряд: сообщения не перепутываются
+                dist.spmv(dist.localPart(x), yLocal, transport);
+                dist.spmv(dist.localPart(x), yLocal, transport);
+                std::copy(yLocal.begin(), yLocal.end(), y.begin() + dist.rowBegin());
+                });
+            for (size_t i = 0; i < n; ++i) assert(std::abs(y[i] - expected[i]) < 1e-12);
+            if (ranks == 1) assert(haloSizes[0] == 0);
+            else assert(haloSizes[1] > 0);
+        }
+    }
+    assert(distributed::balancedRowBlocks(A, 4)[1] < distributed::rowBlocks(n, 4)[1]);
+
+    // Блок не совпадает с разбиением
+    bool thrown = false;
+    LocalHub single(1);
+    try {
+        LocalTransport transport(single, 0);
+        DistributedMatrix<double>(CsrMatrix<double>(A), { 0, n / 2 }, transport);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All distributed tests passed successfully!" << std::endl;
+}
+
+void testAssembly() {
+    // Одномерные линейные элементы: элемент e связывает узлы e и e + 1,
+    // локальная матрица жесткости [[1, -1], [-1, 1]]
+    const size_t elements = 1000;
+    const size_t nodes = elements + 1;
+    SparseMatrix<double> expected(nodes, nodes);
+    for (size_t e = 0; e < elements; ++e) {
+        const size_t idx[2] = { e, e + 1 };
+        const double local[2][2] = { { 1.0, -1.0 }, { -1.0, 1.0 } };
+        for (size_t a = 0; a < 2; ++a) {
+            for (size_t b = 0; b < 2; ++b) {
+                expected.setElement(idx[a], idx[b], expected(idx[a], idx[b]) + local[a][b]);
+            }
+        }
+    }
+
+    for (size_t threads : { 1, 3, 8 }) {
+        MatrixAssembler<double> assembler(nodes, nodes, threads);
+        assert(assembler.slots() == threads);
+        // Каждый поток пишет только в свой slot
+        parallel::forEachPart(parallel::uniformPartition(elements, threads), [&](size_t slot, size_t first, size_t last) {
+            assembler.reserve(slot, 4 * (last - first));
+            for (size_t e = first; e < last; ++e) {
+                assembler.add(slot, e, e, 1.0);
+                assembler.add(slot, e, e + 1, -1.0);
+                assembler.add(slot, e + 1, e, -1.0);
+                assembler.add(slot, e + 1, e + 1, 1.0);
+            }
+            });
+        assert(assembler.size() == 4 * elements);
+        for (unsigned finalizeThreads : { 1u, 4u }) {
+            MatrixAssembler<double> copy = assembler;
+            CsrMatrix<double> csr = copy.finalizeCsr(finalizeThreads);
+            assert(copy.size() == 0);
+            assert(csr.nnz() == 3 * nodes - 2);
+            assert(csr.toSparse() == expected);
+        }
+        assert(assembler.finalize() == expected);
+    }
+
+    // Взаимно сокращающиеся вклады не хранятся, пустые строки сохраняются
+    MatrixAssembler<int> cancel(4, 4, 2);
+    cancel.add(0, 1, 2, 5);
+    cancel.add(1, 1, 2, -5);
+    cancel.add(1, 3, 0, 7);
+    cancel.add(0, 3, 0, 1);
+    CsrMatrix<int> small = cancel.finalizeCsr(2);
+    assert(small.nnz() == 1 && small.rowPtr() == (std::vector<size_t>{ 0, 0, 0, 0, 1 }));
+    assert(small.values()[0] == 8);
+
+    bool thrown = false;
+    try {
+        cancel.add(0, 4, 0, 1);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All assembly tests passed successfully!" << std::endl;
+}
+
+void testWorkload() {
+    // Счетчиковый генератор: fill совпадает с поштучными значениями
+    workload::CounterRng rng(42, 7);
+    std::vector<uint64_t> draws(1000);
+    rng.fill(100, draws.data(), draws.size());
+    for (size_t k = 0; k < draws.size(); ++k) {
+        assert(draws[k] == rng(100 + k));
+    }
+    assert(workload::CounterRng(42, 8)(0) != rng(0));
+    assert(workload::CounterRng(43, 7)(0) != rng(0));
+
+    // Xoshiro: один сид - одна последовательность, jump и stream дают другие
+    workload::Xoshiro256 a(1), b(1), c(1), d(1, 1);
+    c.jump();
+    uint64_t first = a();
+    assert(first == b() && first != c() && first != d());
+    for (int k = 0; k < 1000; ++k) {
+        assert(a.uniform() >= 0.0 && a.uniform() < 1.0);
+    }
+    assert(workload::below(~uint64_t{ 0 }, 10) == 9 && workload::below(0, 10) == 0);
+
+    // Матрица не зависит от числа потоков
+    const size_t n = 2000;
+    CsrMatrix<double> base = workload::sparseMatrix<double>(n, n, 0.005, 123, workload::Pattern::Uniform, 1);
+    for (unsigned threads : { 2u, 5u }) {
+        CsrMatrix<double> other = workload::sparseMatrix<double>(n, n, 0.005, 123, workload::Pattern::Uniform, threads);
+        assert(other.rowPtr() == base.rowPtr() && other.colIdx() == base.colIdx() && other.values() == base.values());
+    }
+    assert(base.nnz() > 9 * n && base.nnz() <= 10 * n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = base.rowPtr()[i]; k < base.rowPtr()[i + 1]; ++k) {
+            assert(base.colIdx()[k] < n && base.values()[k] >= 0.5 && base.values()[k] < 1.5);
+            assert(k == base.rowPtr()[i] || base.colIdx()[k - 1] < base.colIdx()[k]);
+        }
+    }
+    assert(workload::sparseMatrix<double>(n, n, 0.005, 124, workload::Pattern::Uniform, 1).colIdx() != base.colIdx());
+
+    // Zipf: первые столбцы заметно чаще последних
+    CsrMatrix<float> zipf = workload::sparseMatrix<float>(n, n, 0.005, 5, workload::Pattern::Zipf, 3, 1.2);
+    size_t head = 0, tail = 0;
+    for (size_t col : zipf.colIdx()) {
+        if (col < 10) ++head;
+        if (col >= n - 10) ++tail;
+    }
+    assert(head > 50 * (tail + 1));
+
+    std::vector<double> x = workload::denseVector<double>(5000, 9, -1.0, 1.0, 3);
+    assert(x == workload::denseVector<double>(5000, 9, -1.0, 1.0, 1));
+    assert(*std::min_element(x.begin(), x.end()) >= -1.0 && *std::max_element(x.begin(), x.end()) < 1.0);
+
+    std::cout << "All workload tests passed successfully!" << std::endl;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "myParallel.hpp"
+
+// Параллельная сборка матрицы (например, конечноэлементной): вклады
+// (строка, столбец, значение) копятся в буферах потоков без блокировок,
+// finalize сортирует буферы и сливает их с суммированием совпадающих позиций.
+//
+// Потокобезопасность:
+//  - add(slot, ...) с разными slot можно вызывать одновременно из разных
+//    потоков; один slot в каждый момент использует не больше одного потока;
+//  - finalize / finalizeCsr / clear / size не вызываются одновременно с add;
+//  - после finalize буферы пусты и сборку можно повторять.
+template <typename T>
+class MatrixAssembler {
+public:
+    MatrixAssembler(size_t rows, size_t cols, size_t slots)
+        : rows_(rows), cols_(cols), buffers_(std::max<size_t>(slots, 1)) {}
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t slots() const { return buffers_.size(); }
+
+    // Ожидаемое число вкладов в slot
+    void reserve(size_t slot, size_t entries) {
+        buffers_[slot].entries.reserve(entries);
+    }
+
+    // Вклад в элемент (row, col); повторные вклады суммируются
+    void add(size_t slot, size_t row, size_t col, const T& value) {
+        if (row >= rows_ || col >= cols_) {
+            throw std::invalid_argument("Index out of matrix bounds.");
+        }
+        buffers_[slot].entries.push_back({ row, col, value });
+    }
+
+    // Число накопленных вкладов (с повторами)
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& b : buffers_) total += b.entries.size();
+        return total;
+    }
+
+    void clear() {
+        for (auto& b : buffers_) b.entries.clear();
+    }
+
+    // Сборка в CSR на threads потоках: сортировка буферов, затем слияние
+    // по полосам строк. Нулевые суммы не хранятся.
+    CsrMatrix<T> finalizeCsr(unsigned threads = parallel::hardwareThreads()) {
+        // 1. Сортировка каждого буфера по (строка, столбец)
+        parallel::forEachPart(parallel::uniformPartition(buffers_.size(), threads),
+            [&](size_t, size_t first, size_t last) {
+                for (size_t b = first; b < last; ++b) {
+                    auto& e = buffers_[b].entries;
+                    std::sort(e.begin(), e.end(), [](const Entry& a, const Entry& c) {
+                        return std::tie(a.row, a.col) < std::tie(c.row, c.col);
+                        });
+                }
+            });
+
+        // 2. Полосы строк с примерно равным числом вкладов
+        std::vector<size_t> rowCounts(rows_ + 1, 0);
+        for (const auto& b : buffers_) {
+            for (const Entry& e : b.entries) ++rowCounts[e.row + 1];
+        }
+        for (size_t i = 0; i < rows_; ++i) rowCounts[i + 1] += rowCounts[i];
+        std::vector<size_t> bands = parallel::balancedPartition(rowCounts, threads);
+        size_t parts = bands.size() - 1;
+
+        // 3. Слияние полосы из всех буферов с суммированием
+        std::vector<std::vector<size_t>> partCols(parts);
+        std::vector<std::vector<T>> partValues(parts);
+        std::vector<size_t> rowPtr(rows_ + 1, 0);
+        parallel::forEachPart(bands, [&](size_t part, size_t firstRow, size_t lastRow) {
+            merge(firstRow, lastRow, rowPtr, partCols[part], partValues[part]);
+            });
+
+        // 4. Склейка полос
+        std::vector<size_t> partOffset(parts + 1, 0);
+        for (size_t p = 0; p < parts; ++p) partOffset[p + 1] = partOffset[p] + partCols[p].size();
+        for (size_t i = 0; i < rows_; ++i) rowPtr[i + 1] += rowPtr[i];
+        std::vector<size_t> colIdx(partOffset[parts]);
+        std::vector<T> values(partOffset[parts]);
+        parallel::forEachPart(parallel::uniformPartition(parts, threads), [&](size_t, size_t first, size_t last) {
+            for (size_t p = first; p < last; ++p) {
+                std::copy(partCols[p].begin(), partCols[p].end(), colIdx.begin() + partOffset[p]);
+                std::copy(partValues[p].begin(), partValues[p].end(), values.begin() + partOffset[p]);
+            }
+            });
+        clear();
+        return CsrMatrix<T>(rows_, cols_, std::move(rowPtr), std::move(colIdx), std::move(values));
+    }
+
+    SparseMatrix<T> finalize(unsigned threads = parallel::hardwareThreads()) {
+        return finalizeCsr(threads).toSparse();
+    }
+
+private:
+    struct Entry {
+        size_t row;
+        size_t col;
+        T value;
+    };
+
+    // Буферы на отдельных кеш-линиях, чтобы потоки не делили их заголовки
+    struct alignas(64) Buffer {
+        std::vector<Entry> entries;
+    };
+
+    size_t rows_;
+    size_t cols_;
+    std::vector<Buffer> buffers_;
+
+    // Строки [firstRow, lastRow): rowPtr[i + 1] - число элементов строки i
+    void merge(size_t firstRow, size_t lastRow, std::vector<size_t>& rowPtr,
+        std::vector<size_t>& cols, std::vector<T>& values) const {
+        struct Cursor {
+            const Entry* pos;
+            const Entry* end;
+        };
+        // Куча курсоров по буферам с наименьшей позицией наверху
+        auto later = [](const Cursor& a, const Cursor& b) {
+            return std::tie(a.pos->row, a.pos->col) > std::tie(b.pos->row, b.pos->col);
+        };
+        auto byRow = [](const Entry& e, size_t row) { return e.row < row; };
+        std::vector<Cursor> heap;
+        for (const auto& b : buffers_) {
+            const Entry* data = b.entries.data();
+            const Entry* dataEnd = data + b.entries.size();
+            const Entry* begin = std::lower_bound(data, dataEnd, firstRow, byRow);
+            const Entry* end = std::lower_bound(begin, dataEnd, lastRow, byRow);
+            if (begin != end) heap.push_back({ begin, end });
+        }
+        std::make_heap(heap.begin(), heap.end(), later);
+        while (!heap.empty()) {
+            size_t row = heap.front().pos->row;
+            size_t col = heap.front().pos->col;
+            T sum = T{};
+            while (!heap.empty() && heap.front().pos->row == row && heap.front().pos->col == col) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Cursor& cur = heap.back();
+                while (cur.pos != cur.end && cur.pos->row == row && cur.pos->col == col) {
+                    sum += cur.pos->value;
+                    ++cur.pos;
+                }
+                if (cur.pos == cur.end) {
+                    heap.pop_back();
+                }
+                else {
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+            if (sum != T{}) {
+                cols.push_back(col);
+                values.push_back(sum);
+                ++rowPtr[row + 1];
+            }
+        }
+    }
+};
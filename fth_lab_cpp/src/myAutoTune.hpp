@@ -0,0 +1,499 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <map>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "mySellMatrix.hpp"
+#include "myReorder.hpp"
+#include "myDense.hpp"
+#include "myParallel.hpp"
+
+// Автовыбор формата и числа потоков для SpMV (и формата для SpGEMM).
+//
+// 1. Дешевые признаки структуры: длины строк (среднее, дисперсия, максимум),
+//    ширина ленты, число и заполненность диагоналей, заполненность блоков,
+//    оценка дополнения SELL.
+// 2. Модель в духе roofline: время кандидата = max(байты / пропускная
+//    способность, flops / пиковая скорость) + накладные расходы на строки и
+//    потоки, с учетом дисбаланса по самой длинной строке.
+// 3. В режиме Measure лучшие по модели кандидаты дополнительно замеряются.
+// Решение кэшируется по хешу шаблона (без значений) и может сохраняться в
+// файл, после чего TunedMatrix выбирает ядро без повторной настройки.
+
+enum class SpmvKernel { Csr, Sell, Dia, Bsr, Dense };
+
+inline const char* kernelName(SpmvKernel k) {
+    switch (k) {
+    case SpmvKernel::Csr: return "csr";
+    case SpmvKernel::Sell: return "sell";
+    case SpmvKernel::Dia: return "dia";
+    case SpmvKernel::Bsr: return "bsr";
+    default: return "dense";
+    }
+}
+
+struct TuneFeatures {
+    StructureInfo structure;
+    double meanRowLength = 0.0;
+    double rowLengthVariance = 0.0;
+    size_t maxRowLength = 0;
+    size_t bandwidth = 0;
+    double density = 0.0;
+    double sellFill = 1.0;      // доля полезных элементов SELL-8-256
+    uint64_t hash = 0;
+};
+
+// Тег типа значений для ключа кэша: решение для float не годится для double
+template <typename T>
+constexpr uint64_t valueTypeTag() {
+    return sizeof(T) | (uint64_t{ std::is_floating_point_v<T> } << 8) | (uint64_t{ std::is_signed_v<T> } << 9);
+}
+
+// Хеш шаблона: тип значений, размеры и позиции ненулевых элементов (FNV-1a)
+template <typename T>
+uint64_t structureHash(const SparseMatrix<T>& mat) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&](uint64_t v) {
+        for (int i = 0; i < 8; ++i) {
+            h = (h ^ ((v >> (8 * i)) & 0xFF)) * 1099511628211ULL;
+        }
+    };
+    mix(valueTypeTag<T>());
+    mix(mat.rows());
+    mix(mat.cols());
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        mix(it->first.first);
+        mix(it->first.second);
+    }
+    return h;
+}
+
+template <typename T>
+TuneFeatures computeFeatures(const SparseMatrix<T>& mat) {
+    TuneFeatures f;
+    f.structure = analyzeStructure(mat);
+    f.hash = structureHash(mat);
+    f.bandwidth = bandwidthMetrics(mat).bandwidth;
+    size_t rows = mat.rows();
+    f.density = static_cast<double>(mat.size()) / (static_cast<double>(rows) * static_cast<double>(mat.cols()));
+
+    std::vector<size_t> rowLen(rows, 0);
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        ++rowLen[it->first.first];
+    }
+    f.meanRowLength = static_cast<double>(mat.size()) / static_cast<double>(rows);
+    for (size_t len : rowLen) {
+        double d = static_cast<double>(len) - f.meanRowLength;
+        f.rowLengthVariance += d * d;
+        f.maxRowLength = std::max(f.maxRowLength, len);
+    }
+    f.rowLengthVariance /= static_cast<double>(rows);
+
+    // Дополнение SELL-8-256: сортировка длин внутри окон, ширина чанка - максимум
+    const size_t C = 8, sigma = 256;
+    size_t stored = 0;
+    for (size_t w = 0; w < rows; w += sigma) {
+        size_t last = std::min(rows, w + sigma);
+        std::sort(rowLen.begin() + w, rowLen.begin() + last, std::greater<size_t>());
+        for (size_t c = w; c < last; c += C) {
+            stored += rowLen[c] * C;
+        }
+    }
+    f.sellFill = stored ? static_cast<double>(mat.size()) / static_cast<double>(stored) : 1.0;
+    return f;
+}
+
+// Параметры машины для модели. probe() измеряет пропускную способность
+// (триада на массивах больше кэша), скорость FMA и стоимость запуска потока
+struct MachineModel {
+    double bandwidth = 10.0;        // байт/нс (= ГБ/с)
+    double flopRate = 2.0;          // flop/нс
+    double rowOverheadNs = 1.0;     // обработка одной строки/чанка
+    double threadOverheadNs = 30000.0;
+    unsigned threads = 1;
+
+    static MachineModel probe() {
+        using clock = std::chrono::steady_clock;
+        MachineModel m;
+        m.threads = parallel::hardwareThreads();
+
+        const size_t n = size_t{ 1 } << 21;
+        std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 0.0);
+        double best = 1e300;
+        for (int rep = 0; rep < 3; ++rep) {
+            auto start = clock::now();
+            for (size_t i = 0; i < n; ++i) c[i] = a[i] + 0.5 * b[i];
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+            best = std::min(best, ns);
+        }
+        m.bandwidth = 3.0 * n * sizeof(double) / std::max(best, 1.0);
+
+        double acc[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+        const size_t iters = size_t{ 1 } << 20;
+        auto start = clock::now();
+        for (size_t i = 0; i < iters; ++i) {
+            for (double& v : acc) v = v * 0.999999 + 1e-9;
+        }
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        m.flopRate = 16.0 * iters / std::max(ns, 1.0);
+        volatile double sink = acc[0] + acc[7] + c[n / 2];
+        (void)sink;
+
+        if (m.threads > 1) {
+            start = clock::now();
+            parallel::forEachPart(parallel::uniformPartition(m.threads, m.threads), [](size_t, size_t, size_t) {});
+            ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+            m.threadOverheadNs = ns / static_cast<double>(m.threads - 1);
+        }
+        return m;
+    }
+};
+
+struct TuneCandidate {
+    SpmvKernel kernel = SpmvKernel::Csr;
+    unsigned threads = 1;
+    double predictedNs = 0.0;
+};
+
+struct TuneDecision {
+    SpmvKernel kernel = SpmvKernel::Csr;
+    unsigned threads = 1;
+    size_t blockSize = 1;                         // для BSR
+    MatrixFormat spgemmFormat = MatrixFormat::Csr;
+    double predictedNs = 0.0;
+    double measuredNs = 0.0;                      // 0 - решение только по модели
+};
+
+// Кандидаты, отсортированные по предсказанному времени SpMV
+template <typename T>
+std::vector<TuneCandidate> predictCandidates(const TuneFeatures& f, const MachineModel& m) {
+    const StructureInfo& s = f.structure;
+    const double valueBytes = sizeof(T);
+    const double indexBytes = sizeof(size_t);
+    const double nnz = static_cast<double>(s.nnz);
+    const double rows = static_cast<double>(s.rows);
+    const double cols = static_cast<double>(s.cols);
+    const double vecBytes = (rows + cols) * valueBytes;
+
+    auto roofline = [&](double bytes, double flops, double units) {
+        return std::max(bytes / m.bandwidth, flops / m.flopRate) + units * m.rowOverheadNs;
+    };
+    // Параллельная версия: дисбаланс из-за самой длинной строки и запуск потоков
+    auto scaled = [&](double single, unsigned t) {
+        if (t == 1 || nnz == 0) return single;
+        double perThread = nnz / t;
+        double imbalance = std::max(perThread, static_cast<double>(f.maxRowLength)) / perThread;
+        return single / t * imbalance + m.threadOverheadNs * (t - 1);
+    };
+
+    std::vector<TuneCandidate> out;
+    double csr = roofline(nnz * (valueBytes + indexBytes) + (rows + 1) * indexBytes + vecBytes, 2 * nnz, rows);
+    for (unsigned t = 1; t <= m.threads; t *= 2) {
+        out.push_back({ SpmvKernel::Csr, t, scaled(csr, t) });
+    }
+
+    double sellStored = nnz / f.sellFill;
+    out.push_back({ SpmvKernel::Sell, 1,
+        roofline(sellStored * (valueBytes + indexBytes) + rows * indexBytes + vecBytes, 2 * sellStored, rows / 8) });
+
+    // DIA и плотный формат - только если хранение не раздувается слишком сильно
+    double diaStored = static_cast<double>(s.numDiagonals) * rows;
+    if (s.nnz > 0 && diaStored <= 8 * nnz + rows) {
+        out.push_back({ SpmvKernel::Dia, 1, roofline(diaStored * valueBytes + vecBytes, 2 * diaStored, 0) });
+    }
+    if (s.bestBlockSize > 1 && s.bsrFill > 0) {
+        double b = static_cast<double>(s.bestBlockSize);
+        double bsrStored = nnz / s.bsrFill;
+        out.push_back({ SpmvKernel::Bsr, 1,
+            roofline(bsrStored * valueBytes + bsrStored / (b * b) * indexBytes + vecBytes, 2 * bsrStored, rows / b) });
+    }
+    double denseStored = rows * cols;
+    if (denseStored * valueBytes <= 128.0 * 1024 * 1024 && denseStored <= 64 * nnz + rows) {
+        double dense = roofline(denseStored * valueBytes + vecBytes, 2 * denseStored, 0);
+        for (unsigned t = 1; t <= m.threads; t *= 2) {
+            out.push_back({ SpmvKernel::Dense, t, t == 1 ? dense : dense / t + m.threadOverheadNs * (t - 1) });
+        }
+    }
+
+    std::stable_sort(out.begin(), out.end(), [](const TuneCandidate& a, const TuneCandidate& b) {
+        return a.predictedNs < b.predictedNs;
+        });
+    return out;
+}
+
+// Пробное DIA x DIA (A * A): хранение множителя ограничено, как у SpMV-кандидата,
+// а у произведения до min(d(d+1)/2, 2n-1) диагоналей (суммы смещений) - их
+// хранение не больше 8 верхних оценок числа ненулевых CSR-произведения
+inline bool diaSpgemmFits(const TuneFeatures& f) {
+    const StructureInfo& s = f.structure;
+    if (s.nnz == 0 || s.rows != s.cols || s.numDiagonals > 64) return false;
+    const double nnz = static_cast<double>(s.nnz);
+    const double rows = static_cast<double>(s.rows);
+    const double d = static_cast<double>(s.numDiagonals);
+    if (d * rows > 8 * nnz + rows) return false;
+    double productStored = std::min(d * (d + 1) / 2, 2 * rows - 1) * rows;
+    double productNnz = std::min(nnz * static_cast<double>(f.maxRowLength), rows * rows);
+    return productStored <= 8 * productNnz + rows;
+}
+
+// Матрица в формате, выбранном автотюнером; SpMV без повторного выбора
+template <typename T>
+class TunedMatrix {
+public:
+    TunedMatrix(const SparseMatrix<T>& mat, const TuneDecision& decision)
+        : decision_(decision), rows_(mat.rows()), cols_(mat.cols()) {
+        switch (decision_.kernel) {
+        case SpmvKernel::Sell:
+            data_.template emplace<SellMatrix<T>>(mat);
+            break;
+        case SpmvKernel::Dia:
+            data_ = DiaMatrix<T>(mat);
+            break;
+        case SpmvKernel::Bsr:
+            data_ = BsrMatrix<T>(mat, decision_.blockSize);
+            break;
+        case SpmvKernel::Dense: {
+            DenseMatrix<T> dense(mat.rows(), mat.cols());
+            for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+                dense(it->first.first, it->first.second) = it->second;
+            }
+            data_ = std::move(dense);
+            break;
+        }
+        default:
+            data_ = CsrMatrix<T>(mat);
+            break;
+        }
+    }
+
+    const TuneDecision& decision() const { return decision_; }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        unsigned threads = decision_.threads;
+        std::visit([&](const auto& m) {
+            using M = std::decay_t<decltype(m)>;
+            if constexpr (std::is_same_v<M, CsrMatrix<T>>) {
+                m.spmv(x, y, threads);
+            }
+            else if constexpr (std::is_same_v<M, DenseMatrix<T>>) {
+                m.multiply(x, y, threads);
+            }
+            else {
+                m.spmv(x, y);
+            }
+            }, data_);
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+private:
+    TuneDecision decision_;
+    size_t rows_;
+    size_t cols_;
+    std::variant<CsrMatrix<T>, SellMatrix<T>, DiaMatrix<T>, BsrMatrix<T>, DenseMatrix<T>> data_;
+};
+
+// Настройка и кэш решений. Файл кэша - текст, одна строка на шаблон;
+// при другом числе аппаратных потоков файл игнорируется
+class AutoTuner {
+public:
+    enum class Mode { Predict, Measure };
+
+    explicit AutoTuner(Mode mode = Mode::Measure, std::string cachePath = "")
+        : mode_(mode), cachePath_(std::move(cachePath)) {
+        if (!cachePath_.empty()) load();
+    }
+
+    // Модель машины задается явно (например, для воспроизводимых тестов)
+    void setMachine(const MachineModel& machine) {
+        machine_ = machine;
+        hasMachine_ = true;
+    }
+
+    const MachineModel& machine() {
+        if (!hasMachine_) {
+            machine_ = MachineModel::probe();
+            hasMachine_ = true;
+        }
+        return machine_;
+    }
+
+    template <typename T>
+    TuneDecision tune(const SparseMatrix<T>& mat) {
+        uint64_t hash = structureHash(mat);
+        auto it = cache_.find(hash);
+        if (it != cache_.end()) {
+            ++hits_;
+            return it->second;
+        }
+        ++misses_;
+        TuneFeatures f = computeFeatures(mat);
+        TuneDecision d = mode_ == Mode::Measure ? measure(mat, f) : predict<T>(f);
+        cache_[hash] = d;
+        if (!cachePath_.empty()) save();
+        return d;
+    }
+
+    template <typename T>
+    TunedMatrix<T> prepare(const SparseMatrix<T>& mat) {
+        return TunedMatrix<T>(mat, tune(mat));
+    }
+
+    // SpGEMM в специальном формате, только если он выбран для обоих
+    // множителей (лента одного и общий шаблон другого раздули бы DIA)
+    template <typename T>
+    SparseMatrix<T> multiply(const SparseMatrix<T>& a, const SparseMatrix<T>& b) {
+        TuneDecision da = tune(a);
+        TuneDecision db = tune(b);
+        bool same = da.spgemmFormat == db.spgemmFormat
+            && (da.spgemmFormat != MatrixFormat::Bsr || da.blockSize == db.blockSize);
+        return multiplyAs(same ? da.spgemmFormat : MatrixFormat::Csr, da.blockSize, a, b);
+    }
+
+    bool contains(uint64_t hash) const { return cache_.count(hash) != 0; }
+    size_t cacheSize() const { return cache_.size(); }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+    void save() const {
+        std::ofstream out(cachePath_);
+        if (!out) return;
+        out << "sparse-autotune 2 " << parallel::hardwareThreads() << "\n";
+        for (const auto& [hash, d] : cache_) {
+            out << hash << ' ' << static_cast<int>(d.kernel) << ' ' << d.threads << ' ' << d.blockSize << ' '
+                << static_cast<int>(d.spgemmFormat) << ' ' << d.predictedNs << ' ' << d.measuredNs << "\n";
+        }
+    }
+
+    void load() {
+        std::ifstream in(cachePath_);
+        std::string magic;
+        int version = 0;
+        unsigned threads = 0;
+        if (!(in >> magic >> version >> threads) || magic != "sparse-autotune" || version != 2
+            || threads != parallel::hardwareThreads()) {
+            return;
+        }
+        uint64_t hash;
+        int kernel, format;
+        TuneDecision d;
+        while (in >> hash >> kernel >> d.threads >> d.blockSize >> format >> d.predictedNs >> d.measuredNs) {
+            d.kernel = static_cast<SpmvKernel>(kernel);
+            d.spgemmFormat = static_cast<MatrixFormat>(format);
+            cache_[hash] = d;
+        }
+    }
+
+private:
+    Mode mode_;
+    std::string cachePath_;
+    MachineModel machine_;
+    bool hasMachine_ = false;
+    std::map<uint64_t, TuneDecision> cache_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    template <typename T>
+    TuneDecision predict(const TuneFeatures& f) {
+        TuneCandidate best = predictCandidates<T>(f, machine()).front();
+        TuneDecision d;
+        d.kernel = best.kernel;
+        d.threads = best.threads;
+        d.predictedNs = best.predictedNs;
+        d.blockSize = f.structure.bestBlockSize;
+        MatrixFormat format = chooseFormat(f.structure);
+        d.spgemmFormat = format == MatrixFormat::Identity ? MatrixFormat::Csr : format;
+        return d;
+    }
+
+    // Замер кандидатов, которые по модели не более чем в 4 раза хуже лучшего
+    template <typename T>
+    TuneDecision measure(const SparseMatrix<T>& mat, const TuneFeatures& f) {
+        TuneDecision d = predict<T>(f);
+        std::vector<TuneCandidate> candidates = predictCandidates<T>(f, machine());
+        std::vector<T> x(mat.cols(), T{ 1 });
+        std::vector<T> y;
+        double bestNs = 0.0;
+        size_t tried = 0;
+        for (const TuneCandidate& c : candidates) {
+            if (tried == 6 || c.predictedNs > 4 * candidates.front().predictedNs) break;
+            ++tried;
+            TuneDecision trial = d;
+            trial.kernel = c.kernel;
+            trial.threads = c.threads;
+            TunedMatrix<T> tuned(mat, trial);
+            double ns = medianNs([&] { tuned.spmv(x, y); });
+            if (bestNs == 0.0 || ns < bestNs) {
+                bestNs = ns;
+                d.kernel = c.kernel;
+                d.threads = c.threads;
+                d.predictedNs = c.predictedNs;
+            }
+        }
+        d.measuredNs = bestNs;
+
+        // SpGEMM: A * A для применимых форматов (квадратные матрицы)
+        if (mat.rows() == mat.cols() && mat.size() > 0) {
+            std::vector<MatrixFormat> formats = { MatrixFormat::Csr };
+            if (diaSpgemmFits(f)) formats.push_back(MatrixFormat::Dia);
+            if (f.structure.bestBlockSize > 1 && f.structure.bsrFill >= 0.3) formats.push_back(MatrixFormat::Bsr);
+            double bestGemm = 0.0;
+            for (MatrixFormat format : formats) {
+                auto start = std::chrono::steady_clock::now();
+                SparseMatrix<T> c = multiplyAs(format, d.blockSize, mat, mat);
+                double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+                if (bestGemm == 0.0 || ns < bestGemm) {
+                    bestGemm = ns;
+                    d.spgemmFormat = format;
+                }
+            }
+        }
+        return d;
+    }
+
+    template <typename F>
+    static double medianNs(F f) {
+        f();
+        std::vector<double> samples;
+        for (int i = 0; i < 5; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            samples.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    template <typename T>
+    static SparseMatrix<T> multiplyAs(MatrixFormat format, size_t blockSize,
+        const SparseMatrix<T>& a, const SparseMatrix<T>& b) {
+        switch (format) {
+        case MatrixFormat::Dia:
+            return (DiaMatrix<T>(a) * DiaMatrix<T>(b)).toSparse();
+        case MatrixFormat::Bsr:
+            return (BsrMatrix<T>(a, blockSize) * BsrMatrix<T>(b, blockSize)).toSparse();
+        default:
+            return (CsrMatrix<T>(a) * CsrMatrix<T>(b)).toSparse();
+        }
+    }
+};
@@ -0,0 +1,229 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "myMatrix.hpp"
+#include "myParallel.hpp"
+
+// CSR со сжатыми индексами столбцов для очень больших матриц. Внутри строки
+// хранится первый столбец и разности между соседними (минус 1, так как
+// столбцы строго возрастают), в одном из двух кодирований:
+//  - Varint: LEB128, 1 байт на разность до 128;
+//  - BitPacked: все разности строки упакованы с общей шириной w бит.
+// Строка: [varint первый столбец][байт w (только BitPacked)][разности].
+// SpMV распаковывает по одной строке в буфер, не разворачивая всю матрицу.
+
+enum class IndexEncoding { Varint, BitPacked };
+
+template <typename T>
+class CompressedCsrMatrix {
+public:
+    CompressedCsrMatrix() = default;
+
+    explicit CompressedCsrMatrix(const SparseMatrix<T>& mat, IndexEncoding encoding = IndexEncoding::BitPacked)
+        : rows_(mat.rows()), cols_(mat.cols()), encoding_(encoding),
+        rowPtr_(mat.rows() + 1, 0), rowStart_(mat.rows() + 1, 0) {
+        values_.reserve(mat.size());
+        std::vector<size_t> rowCols;
+        auto it = mat.cbegin();
+        for (size_t i = 0; i < rows_; ++i) {
+            rowCols.clear();
+            for (; it != mat.cend() && it->first.first == i; ++it) {
+                rowCols.push_back(it->first.second);
+                values_.push_back(it->second);
+            }
+            rowStart_[i] = stream_.size();
+            encodeRow(rowCols);
+            rowPtr_[i + 1] = values_.size();
+            maxRowLength_ = std::max(maxRowLength_, rowCols.size());
+        }
+        rowStart_[rows_] = stream_.size();
+        // Запас под невыровненное чтение 8 байт в конце потока
+        stream_.resize(stream_.size() + sizeof(uint64_t), 0);
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+    IndexEncoding encoding() const { return encoding_; }
+
+    // Байты на индексы: смещения строк и поток столбцов
+    size_t indexBytes() const {
+        return (rowPtr_.size() + rowStart_.size()) * sizeof(size_t) + stream_.size();
+    }
+
+    // Во сколько раз индексы меньше пар (size_t, size_t) SparseMatrix
+    double compressionRatio() const {
+        size_t bytes = indexBytes();
+        return bytes ? static_cast<double>(nnz() * 2 * sizeof(size_t)) / static_cast<double>(bytes) : 1.0;
+    }
+
+    size_t rowLength(size_t row) const { return rowPtr_[row + 1] - rowPtr_[row]; }
+
+    // Столбцы строки row в out (не меньше rowLength(row) элементов)
+    void decodeRow(size_t row, size_t* out) const {
+        size_t count = rowLength(row);
+        if (count == 0) return;
+        const uint8_t* p = stream_.data() + rowStart_[row];
+        out[0] = readVarint(p);
+        if (encoding_ == IndexEncoding::Varint) {
+            for (size_t k = 1; k < count; ++k) {
+                out[k] = out[k - 1] + readVarint(p) + 1;
+            }
+            return;
+        }
+        unsigned width = *p++;
+        uint64_t mask = (uint64_t{ 1 } << width) - 1;
+        // Извлечения независимы друг от друга и векторизуются,
+        // префиксная сумма восстанавливает столбцы отдельным проходом
+#pragma omp simd
+        for (size_t k = 1; k < count; ++k) {
+            size_t bit = (k - 1) * width;
+            uint64_t word;
+            std::memcpy(&word, p + (bit >> 3), sizeof(word));
+            out[k] = static_cast<size_t>((word >> (bit & 7)) & mask);
+        }
+        for (size_t k = 1; k < count; ++k) {
+            out[k] += out[k - 1] + 1;
+        }
+    }
+
+    std::vector<size_t> decodeRow(size_t row) const {
+        std::vector<size_t> out(rowLength(row));
+        decodeRow(row, out.data());
+        return out;
+    }
+
+    // y = A x
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        spmvRows(x.data(), y.data(), 0, rows_);
+    }
+
+    // y = A x в threads потоках; строки делятся поровну по числу ненулевых
+    void spmv(const std::vector<T>& x, std::vector<T>& y, unsigned threads) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        parallel::forEachPart(parallel::balancedPartition(rowPtr_, threads),
+            [&](size_t, size_t first, size_t last) { spmvRows(x.data(), y.data(), first, last); });
+    }
+
+    // Строки [first, last) произведения
+    void spmvRows(const T* x, T* y, size_t first, size_t last) const {
+        size_t* cols = rowScratch();
+        for (size_t i = first; i < last; ++i) {
+            decodeRow(i, cols);
+            const T* val = values_.data() + rowPtr_[i];
+            size_t count = rowLength(i);
+            T sum = T{};
+            for (size_t k = 0; k < count; ++k) {
+                sum += val[k] * x[cols[k]];
+            }
+            y[i] = sum;
+        }
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(rows_, cols_);
+        result.reserve(nnz());
+        size_t* cols = rowScratch();
+        for (size_t i = 0; i < rows_; ++i) {
+            decodeRow(i, cols);
+            for (size_t k = 0; k < rowLength(i); ++k) {
+                result.appendElement(i, cols[k], values_[rowPtr_[i] + k]);
+            }
+        }
+        return result;
+    }
+
+private:
+    // Больше 57 бит разность не помещается в одно 8-байтовое чтение со сдвигом до 7
+    static constexpr unsigned maxWidth_ = 57;
+
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    IndexEncoding encoding_ = IndexEncoding::BitPacked;
+    size_t maxRowLength_ = 0;
+    std::vector<size_t> rowPtr_;        // смещения значений строк
+    std::vector<size_t> rowStart_;      // смещения строк в потоке индексов
+    std::vector<uint8_t> stream_;
+    std::vector<T> values_;
+
+    // Буфер распакованных столбцов строки: свой у каждого потока и общий
+    // для всех матриц, растет до самой длинной строки и не освобождается,
+    // чтобы SpMV не выделял память на каждый вызов
+    size_t* rowScratch() const {
+        thread_local std::vector<size_t> cols;
+        if (cols.size() < maxRowLength_) cols.resize(maxRowLength_);
+        return cols.data();
+    }
+
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            stream_.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        stream_.push_back(static_cast<uint8_t>(value));
+    }
+
+    static size_t readVarint(const uint8_t*& p) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        uint8_t byte;
+        do {
+            byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return static_cast<size_t>(value);
+    }
+
+    void encodeRow(const std::vector<size_t>& rowCols) {
+        if (rowCols.empty()) return;
+        writeVarint(rowCols[0]);
+        if (encoding_ == IndexEncoding::Varint) {
+            for (size_t k = 1; k < rowCols.size(); ++k) {
+                writeVarint(rowCols[k] - rowCols[k - 1] - 1);
+            }
+            return;
+        }
+        uint64_t maxGap = 0;
+        for (size_t k = 1; k < rowCols.size(); ++k) {
+            maxGap = std::max<uint64_t>(maxGap, rowCols[k] - rowCols[k - 1] - 1);
+        }
+        unsigned width = 0;
+        while (width < 64 && (maxGap >> width) != 0) ++width;
+        if (width > maxWidth_) {
+            throw std::invalid_argument("Matrix too large for index type.");
+        }
+        stream_.push_back(static_cast<uint8_t>(width));
+        size_t base = stream_.size();
+        size_t bits = (rowCols.size() - 1) * width;
+        size_t bytes = (bits + 7) / 8;
+        // Запись 8-байтовыми словами, хвост после строки остается нулевым
+        stream_.resize(base + bytes + sizeof(uint64_t), 0);
+        for (size_t k = 1; k < rowCols.size(); ++k) {
+            uint64_t gap = rowCols[k] - rowCols[k - 1] - 1;
+            size_t bit = (k - 1) * width;
+            uint64_t word;
+            std::memcpy(&word, stream_.data() + base + (bit >> 3), sizeof(word));
+            word |= gap << (bit & 7);
+            std::memcpy(stream_.data() + base + (bit >> 3), &word, sizeof(word));
+        }
+        stream_.resize(base + bytes);
+    }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "myParallel.hpp"
+
+// Плотные вектор и матрица для сравнения с разреженными реализациями
+template<typename T>
+class DenseVector {
+public:
+    DenseVector(size_t size) : data_(size, T{}) {}
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return data_.size(); }
+
+    // Пример операции: скалярное произведение
+    T dot(const DenseVector& other) const {
+        if (other.size() != size()) throw std::invalid_argument("Size mismatch");
+        T result = T{};
+        for (size_t i = 0; i < size(); ++i) {
+            result += data_[i] * other.data_[i];
+        }
+        return result;
+    }
+
+private:
+    std::vector<T> data_;
+};
+
+// Плотная реализация матрицы 
+template<typename T>
+class DenseMatrix {
+public:
+    DenseMatrix(size_t rows, size_t cols) : rows_(rows), cols_(cols), data_(rows* cols, T{}) {}
+
+    T& operator()(size_t r, size_t c) {
+        return data_[r * cols_ + c];
+    }
+
+    const T& operator()(size_t r, size_t c) const {
+        return data_[r * cols_ + c];
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    // y = A x, строки делятся между threads потоками
+    void multiply(const std::vector<T>& x, std::vector<T>& y, unsigned threads = 1) const {
+        if (x.size() != cols_) {
+            throw std::invalid_argument("Dimension mismatch");
+        }
+        y.resize(rows_);
+        parallel::forEachPart(parallel::uniformPartition(rows_, threads), [&](size_t, size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                const T* row = data_.data() + i * cols_;
+                T sum = T{};
+                for (size_t k = 0; k < cols_; ++k) {
+                    sum += row[k] * x[k];
+                }
+                y[i] = sum;
+            }
+            });
+    }
+
+    // Пример операции: умножение матриц
+    DenseMatrix operator*(const DenseMatrix& other) const {
+        if (cols_ != other.rows_) {
+            throw std::invalid_argument("Dimension mismatch");
+        }
+        DenseMatrix result(rows_, other.cols_);
+        for (size_t i = 0; i < rows_; ++i) {
+            for (size_t j = 0; j < other.cols_; ++j) {
+                T sum = T{};
+                for (size_t k = 0; k < cols_; ++k) {
+                    sum += (*this)(i, k) * other(k, j);
+                }
+                result(i, j) = sum;
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t rows_, cols_;
+    std::vector<T> data_;
+};
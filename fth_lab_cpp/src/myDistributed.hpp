@@ -0,0 +1,354 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+#include "myParallel.hpp"
+#ifdef SPARSE_WITH_MPI
+#include <mpi.h>
+#endif
+
+// Распределенное SpMV с разбиением по блокам строк. Каждый ранг хранит
+// свои строки матрицы и такой же блок векторов x и y. Столбцы вне своего
+// блока (гало) ранг получает от владельцев через Transport:
+//  - LocalTransport - ранги как потоки одного процесса (тесты, бенчмарки);
+//  - MpiTransport - MPI_COMM_WORLD, при сборке с -DSPARSE_WITH_MPI (make MPI=1).
+// Пересылка гало перекрывается с умножением на локальную часть блока.
+
+// Передача сообщений между рангами: send не ждет получателя, recv блокирует
+class Transport {
+public:
+    virtual ~Transport() = default;
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+    virtual void send(int dest, int tag, std::vector<char> data) = 0;
+    virtual std::vector<char> recv(int src, int tag) = 0;
+    // Дождаться завершения всех отправок этого ранга
+    virtual void flush() {}
+};
+
+namespace distributed {
+
+    template <typename T>
+    void sendValues(Transport& transport, int dest, int tag, const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "Transported values must be trivially copyable.");
+        std::vector<char> data(values.size() * sizeof(T));
+        if (!values.empty()) std::memcpy(data.data(), values.data(), data.size());
+        transport.send(dest, tag, std::move(data));
+    }
+
+    template <typename T>
+    std::vector<T> recvValues(Transport& transport, int src, int tag) {
+        static_assert(std::is_trivially_copyable_v<T>, "Transported values must be trivially copyable.");
+        std::vector<char> data = transport.recv(src, tag);
+        std::vector<T> values(data.size() / sizeof(T));
+        if (!values.empty()) std::memcpy(values.data(), data.data(), values.size() * sizeof(T));
+        return values;
+    }
+
+    // Равные блоки строк
+    inline std::vector<size_t> rowBlocks(size_t rows, int ranks) {
+        std::vector<size_t> bounds(static_cast<size_t>(ranks) + 1);
+        for (size_t p = 0; p < bounds.size(); ++p) {
+            bounds[p] = rows * p / static_cast<size_t>(ranks);
+        }
+        return bounds;
+    }
+
+    // Блоки с примерно равным числом ненулевых
+    template <typename T>
+    std::vector<size_t> balancedRowBlocks(const SparseMatrix<T>& mat, int ranks) {
+        std::vector<size_t> prefix(mat.rows() + 1, 0);
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) ++prefix[it->first.first + 1];
+        for (size_t i = 0; i < mat.rows(); ++i) prefix[i + 1] += prefix[i];
+        std::vector<size_t> bounds = parallel::balancedPartition(prefix, static_cast<size_t>(ranks));
+        // Рангов больше, чем строк: лишние получают пустые блоки
+        bounds.resize(static_cast<size_t>(ranks) + 1, mat.rows());
+        return bounds;
+    }
+
+    // Ранг-владелец индекса при разбиении bounds
+    inline int owner(const std::vector<size_t>& bounds, size_t index) {
+        return static_cast<int>(std::upper_bound(bounds.begin(), bounds.end(), index) - bounds.begin()) - 1;
+    }
+
+}
+
+// Почтовые ящики для рангов-потоков одного процесса
+class LocalHub {
+public:
+    explicit LocalHub(int size) : size_(size) {
+        if (size <= 0) {
+            throw std::invalid_argument("Number of ranks must be positive.");
+        }
+    }
+
+    int size() const { return size_; }
+
+    void post(int src, int dest, int tag, std::vector<char> data) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            boxes_[{ src, dest, tag }].push_back(std::move(data));
+        }
+        ready_.notify_all();
+    }
+
+    std::vector<char> take(int src, int dest, int tag) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto& box = boxes_[{ src, dest, tag }];
+        ready_.wait(lock, [&] { return !box.empty(); });
+        std::vector<char> data = std::move(box.front());
+        box.pop_front();
+        return data;
+    }
+
+private:
+    int size_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::map<std::tuple<int, int, int>, std::deque<std::vector<char>>> boxes_;
+};
+
+class LocalTransport : public Transport {
+public:
+    LocalTransport(LocalHub& hub, int rank) : hub_(hub), rank_(rank) {}
+
+    int rank() const override { return rank_; }
+    int size() const override { return hub_.size(); }
+
+    void send(int dest, int tag, std::vector<char> data) override {
+        hub_.post(rank_, dest, tag, std::move(data));
+    }
+
+    std::vector<char> recv(int src, int tag) override {
+        return hub_.take(src, rank_, tag);
+    }
+
+private:
+    LocalHub& hub_;
+    int rank_;
+};
+
+namespace distributed {
+
+    // f(transport) на каждом ранге hub, ранг 0 - в вызывающем потоке
+    template <typename F>
+    void runLocal(LocalHub& hub, F f) {
+        parallel::forEachPart(parallel::uniformPartition(static_cast<size_t>(hub.size()), static_cast<size_t>(hub.size())),
+            [&](size_t part, size_t, size_t) {
+                LocalTransport transport(hub, static_cast<int>(part));
+                f(static_cast<Transport&>(transport));
+            });
+    }
+
+}
+
+#ifdef SPARSE_WITH_MPI
+// MPI_COMM_WORLD; MPI_Init/MPI_Finalize остаются за вызывающим кодом
+class MpiTransport : public Transport {
+public:
+    MpiTransport() {
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+        MPI_Comm_size(MPI_COMM_WORLD, &size_);
+    }
+
+    ~MpiTransport() override { flush(); }
+
+    int rank() const override { return rank_; }
+    int size() const override { return size_; }
+
+    // Буфер живет до flush(), пока MPI_Isend не завершится
+    void send(int dest, int tag, std::vector<char> data) override {
+        pending_.push_back(std::move(data));
+        requests_.emplace_back();
+        MPI_Isend(pending_.back().data(), static_cast<int>(pending_.back().size()), MPI_BYTE,
+            dest, tag, MPI_COMM_WORLD, &requests_.back());
+    }
+
+    std::vector<char> recv(int src, int tag) override {
+        MPI_Status status;
+        MPI_Probe(src, tag, MPI_COMM_WORLD, &status);
+        int bytes = 0;
+        MPI_Get_count(&status, MPI_BYTE, &bytes);
+        std::vector<char> data(static_cast<size_t>(bytes));
+        MPI_Recv(data.data(), bytes, MPI_BYTE, src, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        return data;
+    }
+
+    void flush() override {
+        if (!requests_.empty()) {
+            MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+        }
+        requests_.clear();
+        pending_.clear();
+    }
+
+private:
+    int rank_ = 0;
+    int size_ = 1;
+    std::deque<std::vector<char>> pending_;
+    std::vector<MPI_Request> requests_;
+};
+#endif
+
+// Блок строк [rowBegin, rowEnd) распределенной матрицы на одном ранге.
+// Блок делится на локальную часть (столбцы своего блока x) и удаленную
+// (столбцы гало, перенумерованные подряд).
+template <typename T>
+class DistributedMatrix {
+public:
+    // block - строки этого ранга с глобальными номерами столбцов; bounds -
+    // границы блоков строк (и блоков x) всех рангов. Конструктор
+    // коллективный: ранги обмениваются списками нужных столбцов.
+    DistributedMatrix(const CsrMatrix<T>& block, std::vector<size_t> bounds, Transport& transport)
+        : bounds_(std::move(bounds)), rank_(transport.rank()) {
+        if (bounds_.size() != static_cast<size_t>(transport.size()) + 1
+            || block.rows() != bounds_[rank_ + 1] - bounds_[rank_] || block.cols() != bounds_.back()) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        size_t first = bounds_[rank_];
+        size_t last = bounds_[rank_ + 1];
+
+        // Гало: столбцы вне своего блока, по возрастанию (значит, и по владельцам)
+        for (size_t c : block.colIdx()) {
+            if (c < first || c >= last) halo_.push_back(c);
+        }
+        std::sort(halo_.begin(), halo_.end());
+        halo_.erase(std::unique(halo_.begin(), halo_.end()), halo_.end());
+
+        std::vector<size_t> localPtr{ 0 }, remotePtr{ 0 }, localCol, remoteCol;
+        std::vector<T> localVal, remoteVal;
+        for (size_t i = 0; i < block.rows(); ++i) {
+            for (size_t k = block.rowPtr()[i]; k < block.rowPtr()[i + 1]; ++k) {
+                size_t c = block.colIdx()[k];
+                if (c >= first && c < last) {
+                    localCol.push_back(c - first);
+                    localVal.push_back(block.values()[k]);
+                }
+                else {
+                    remoteCol.push_back(static_cast<size_t>(std::lower_bound(halo_.begin(), halo_.end(), c) - halo_.begin()));
+                    remoteVal.push_back(block.values()[k]);
+                }
+            }
+            localPtr.push_back(localCol.size());
+            remotePtr.push_back(remoteCol.size());
+        }
+        local_ = CsrMatrix<T>(block.rows(), last - first, std::move(localPtr), std::move(localCol), std::move(localVal));
+        remote_ = CsrMatrix<T>(block.rows(), halo_.size(), std::move(remotePtr), std::move(remoteCol), std::move(remoteVal));
+
+        // Сколько значений гало придет от каждого ранга
+        int ranks = transport.size();
+        recvOffset_.assign(static_cast<size_t>(ranks) + 1, 0);
+        for (size_t c : halo_) ++recvOffset_[distributed::owner(bounds_, c) + 1];
+        for (int q = 0; q < ranks; ++q) recvOffset_[q + 1] += recvOffset_[q];
+
+        // Каждый владелец узнает, какие свои элементы x отправлять
+        for (int q = 0; q < ranks; ++q) {
+            if (q == rank_) continue;
+            std::vector<uint64_t> wanted(halo_.begin() + recvOffset_[q], halo_.begin() + recvOffset_[q + 1]);
+            distributed::sendValues(transport, q, setupTag_, wanted);
+        }
+        sendIndices_.assign(static_cast<size_t>(ranks), {});
+        for (int q = 0; q < ranks; ++q) {
+            if (q == rank_) continue;
+            for (uint64_t c : distributed::recvValues<uint64_t>(transport, q, setupTag_)) {
+                sendIndices_[q].push_back(static_cast<size_t>(c) - first);
+            }
+        }
+        transport.flush();
+    }
+
+    // Строки своего ранга из глобальной матрицы (удобно, когда она есть у всех)
+    static DistributedMatrix fromGlobal(const SparseMatrix<T>& global, std::vector<size_t> bounds, Transport& transport) {
+        size_t first = bounds[transport.rank()];
+        size_t last = bounds[transport.rank() + 1];
+        std::vector<size_t> rowPtr(last - first + 1, 0), colIdx;
+        std::vector<T> values;
+        for (auto it = global.cbegin(); it != global.cend(); ++it) {
+            size_t i = it->first.first;
+            if (i < first) continue;
+            if (i >= last) break;
+            ++rowPtr[i - first + 1];
+            colIdx.push_back(it->first.second);
+            values.push_back(it->second);
+        }
+        for (size_t i = 0; i < last - first; ++i) rowPtr[i + 1] += rowPtr[i];
+        CsrMatrix<T> block(last - first, global.cols(), std::move(rowPtr), std::move(colIdx), std::move(values));
+        return DistributedMatrix(block, std::move(bounds), transport);
+    }
+
+    size_t rowBegin() const { return bounds_[rank_]; }
+    size_t rowEnd() const { return bounds_[rank_ + 1]; }
+    size_t localRows() const { return rowEnd() - rowBegin(); }
+    size_t haloSize() const { return halo_.size(); }
+    const std::vector<size_t>& halo() const { return halo_; }
+    const std::vector<size_t>& bounds() const { return bounds_; }
+
+    // Число соседей, от которых приходит гало
+    size_t neighbours() const {
+        size_t count = 0;
+        for (size_t q = 0; q + 1 < recvOffset_.size(); ++q) count += recvOffset_[q + 1] > recvOffset_[q];
+        return count;
+    }
+
+    // Свой блок глобального вектора
+    std::vector<T> localPart(const std::vector<T>& global) const {
+        return std::vector<T>(global.begin() + rowBegin(), global.begin() + rowEnd());
+    }
+
+    // y = A x для своего блока; коллективная операция всех рангов
+    void spmv(const std::vector<T>& x, std::vector<T>& y, Transport& transport) const {
+        if (x.size() != localRows()) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        // 1. Отправка своих значений соседям
+        std::vector<T> packed;
+        for (size_t q = 0; q < sendIndices_.size(); ++q) {
+            if (sendIndices_[q].empty()) continue;
+            packed.resize(sendIndices_[q].size());
+            for (size_t k = 0; k < packed.size(); ++k) packed[k] = x[sendIndices_[q][k]];
+            distributed::sendValues(transport, static_cast<int>(q), haloTag_, packed);
+        }
+        // 2. Локальная часть, пока сообщения в пути
+        y.resize(localRows());
+        local_.spmvRows(x.data(), y.data(), 0, localRows());
+        // 3. Прием гало и удаленная часть
+        if (!halo_.empty()) {
+            std::vector<T> haloValues(halo_.size());
+            for (size_t q = 0; q + 1 < recvOffset_.size(); ++q) {
+                if (recvOffset_[q + 1] == recvOffset_[q]) continue;
+                std::vector<T> part = distributed::recvValues<T>(transport, static_cast<int>(q), haloTag_);
+                if (part.size() != recvOffset_[q + 1] - recvOffset_[q]) {
+                    throw std::runtime_error("Unexpected halo message size.");
+                }
+                std::copy(part.begin(), part.end(), haloValues.begin() + recvOffset_[q]);
+            }
+            std::vector<T> remoteY(localRows());
+            remote_.spmvRows(haloValues.data(), remoteY.data(), 0, localRows());
+            for (size_t i = 0; i < localRows(); ++i) y[i] += remoteY[i];
+        }
+        transport.flush();
+    }
+
+private:
+    static constexpr int setupTag_ = 1;
+    static constexpr int haloTag_ = 2;
+
+    std::vector<size_t> bounds_;
+    int rank_;
+    CsrMatrix<T> local_;
+    CsrMatrix<T> remote_;
+    std::vector<size_t> halo_;                      // глобальные номера столбцов гало
+    std::vector<size_t> recvOffset_;                // гало от ранга q: [recvOffset_[q], recvOffset_[q + 1])
+    std::vector<std::vector<size_t>> sendIndices_;  // локальные индексы x для ранга q
+};
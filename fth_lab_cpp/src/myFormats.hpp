@@ -0,0 +1,614 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <variant>
+#include "myMatrix.hpp"
+#include "myParallel.hpp"
+
+// Специализированные форматы хранения поверх SparseMatrix.
+// Все форматы строятся из SparseMatrix за один проход по упорядоченным
+// данным и умножаются на плотные векторы std::vector<T>.
+
+// CSR: непрерывные массивы смещений строк, столбцов и значений
+template <typename T>
+class CsrMatrix {
+public:
+    CsrMatrix() = default;
+
+    explicit CsrMatrix(const SparseMatrix<T>& mat)
+        : rows_(mat.rows()), cols_(mat.cols()), rowPtr_(mat.rows() + 1, 0) {
+        colIdx_.reserve(mat.size());
+        values_.reserve(mat.size());
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            ++rowPtr_[it->first.first + 1];
+            colIdx_.push_back(it->first.second);
+            values_.push_back(it->second);
+        }
+        for (size_t i = 0; i < rows_; ++i) {
+            rowPtr_[i + 1] += rowPtr_[i];
+        }
+    }
+
+    CsrMatrix(size_t rows, size_t cols, std::vector<size_t> rowPtr,
+        std::vector<size_t> colIdx, std::vector<T> values)
+        : rows_(rows), cols_(cols), rowPtr_(std::move(rowPtr)),
+        colIdx_(std::move(colIdx)), values_(std::move(values)) {}
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+
+    const std::vector<size_t>& rowPtr() const { return rowPtr_; }
+    const std::vector<size_t>& colIdx() const { return colIdx_; }
+    const std::vector<T>& values() const { return values_; }
+
+    // y = A x
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        spmvRows(x.data(), y.data(), 0, rows_);
+    }
+
+    // y = A x в threads потоках; строки делятся поровну по числу ненулевых
+    void spmv(const std::vector<T>& x, std::vector<T>& y, unsigned threads) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        parallel::forEachPart(parallel::balancedPartition(rowPtr_, threads),
+            [&](size_t, size_t first, size_t last) { spmvRows(x.data(), y.data(), first, last); });
+    }
+
+    // Строки [first, last) произведения
+    void spmvRows(const T* x, T* y, size_t first, size_t last) const {
+        for (size_t i = first; i < last; ++i) {
+            T sum = T{};
+            for (size_t k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k) {
+                sum += values_[k] * x[colIdx_[k]];
+            }
+            y[i] = sum;
+        }
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    // SpGEMM по Густавсону: плотный аккумулятор строки и маркеры столбцов
+    CsrMatrix operator*(const CsrMatrix& other) const {
+        if (cols_ != other.rows_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        std::vector<size_t> rowPtr(rows_ + 1, 0);
+        std::vector<size_t> colIdx;
+        std::vector<T> values;
+        std::vector<T> acc(other.cols_, T{});
+        std::vector<size_t> marker(other.cols_, SIZE_MAX);
+        std::vector<size_t> rowCols;
+
+        for (size_t i = 0; i < rows_; ++i) {
+            multiplyRow(other, i, i, acc, marker, rowCols);
+            for (size_t j : rowCols) {
+                colIdx.push_back(j);
+                values.push_back(acc[j]);
+            }
+            rowPtr[i + 1] = colIdx.size();
+        }
+        return CsrMatrix(rows_, other.cols_, std::move(rowPtr), std::move(colIdx), std::move(values));
+    }
+
+    // Строка i произведения this * other: rowCols - ее ненулевые столбцы
+    // по возрастанию, значения в acc[j]. acc и marker размера other.cols(),
+    // marker изначально SIZE_MAX; stamp - метка, своя для каждой строки
+    void multiplyRow(const CsrMatrix& other, size_t i, size_t stamp, std::vector<T>& acc,
+        std::vector<size_t>& marker, std::vector<size_t>& rowCols) const {
+        rowCols.clear();
+        for (size_t ka = rowPtr_[i]; ka < rowPtr_[i + 1]; ++ka) {
+            size_t k = colIdx_[ka];
+            T valA = values_[ka];
+            for (size_t kb = other.rowPtr_[k]; kb < other.rowPtr_[k + 1]; ++kb) {
+                size_t j = other.colIdx_[kb];
+                if (marker[j] != stamp) {
+                    marker[j] = stamp;
+                    acc[j] = T{};
+                    rowCols.push_back(j);
+                }
+                acc[j] += valA * other.values_[kb];
+            }
+        }
+        std::sort(rowCols.begin(), rowCols.end());
+        rowCols.erase(std::remove_if(rowCols.begin(), rowCols.end(), [&](size_t j) { return acc[j] == T{}; }),
+            rowCols.end());
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(rows_, cols_);
+        result.reserve(nnz());
+        for (size_t i = 0; i < rows_; ++i) {
+            for (size_t k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k) {
+                result.appendElement(i, colIdx_[k], values_[k]);
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<size_t> rowPtr_{ 0 };
+    std::vector<size_t> colIdx_;
+    std::vector<T> values_;
+};
+
+// DIA: хранение по диагоналям. Диагональ со смещением off хранит
+// элементы A(i, i + off) для всех строк i подряд, поэтому SpMV по каждой
+// диагонали - непрерывный векторизуемый цикл без индексов столбцов
+template <typename T>
+class DiaMatrix {
+public:
+    DiaMatrix() = default;
+
+    explicit DiaMatrix(const SparseMatrix<T>& mat) : rows_(mat.rows()), cols_(mat.cols()) {
+        std::vector<long long> offsets;
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            offsets.push_back(static_cast<long long>(it->first.second) - static_cast<long long>(it->first.first));
+        }
+        std::sort(offsets.begin(), offsets.end());
+        offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+        offsets_ = offsets;
+        data_.assign(offsets_.size() * rows_, T{});
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            long long off = static_cast<long long>(it->first.second) - static_cast<long long>(it->first.first);
+            size_t d = diagonalIndex(off);
+            data_[d * rows_ + it->first.first] = it->second;
+        }
+    }
+
+    // Ленточная матрица из заданных диагоналей (каждая длины rows)
+    DiaMatrix(size_t rows, size_t cols, std::vector<long long> offsets, std::vector<T> data)
+        : rows_(rows), cols_(cols), offsets_(std::move(offsets)), data_(std::move(data)) {
+        if (data_.size() != offsets_.size() * rows_) {
+            throw std::invalid_argument("Diagonal data size mismatch.");
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t numDiagonals() const { return offsets_.size(); }
+    const std::vector<long long>& offsets() const { return offsets_; }
+
+    // Число ненулевых элементов
+    size_t nnz() const {
+        return static_cast<size_t>(std::count_if(data_.begin(), data_.end(), [](const T& v) {
+            return v != T{};
+            }));
+    }
+
+    T operator()(size_t row, size_t col) const {
+        long long off = static_cast<long long>(col) - static_cast<long long>(row);
+        auto it = std::lower_bound(offsets_.begin(), offsets_.end(), off);
+        if (it == offsets_.end() || *it != off) return T{};
+        return data_[static_cast<size_t>(it - offsets_.begin()) * rows_ + row];
+    }
+
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.assign(rows_, T{});
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            size_t begin, end;
+            rowRange(offsets_[d], begin, end);
+            const T* diag = data_.data() + d * rows_;
+            const T* xs = x.data();
+            T* ys = y.data();
+            // сложение по модулю 2^64 корректно и для отрицательных смещений
+            size_t shift = static_cast<size_t>(offsets_[d]);
+#pragma omp simd
+            for (size_t i = begin; i < end; ++i) {
+                ys[i] += diag[i] * xs[i + shift];
+            }
+        }
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    // Произведение ленточных матриц снова ленточное:
+    // диагональ o1 из A и o2 из B дают вклад в диагональ o1 + o2
+    DiaMatrix operator*(const DiaMatrix& other) const {
+        if (cols_ != other.rows_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        std::vector<long long> offsets;
+        for (long long o1 : offsets_) {
+            for (long long o2 : other.offsets_) {
+                long long o = o1 + o2;
+                if (o > -static_cast<long long>(rows_) && o < static_cast<long long>(other.cols_)) {
+                    offsets.push_back(o);
+                }
+            }
+        }
+        std::sort(offsets.begin(), offsets.end());
+        offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+        DiaMatrix result(rows_, other.cols_, offsets, std::vector<T>(offsets.size() * rows_, T{}));
+
+        for (size_t d1 = 0; d1 < offsets_.size(); ++d1) {
+            long long o1 = offsets_[d1];
+            size_t begin, end;
+            rowRange(o1, begin, end);
+            for (size_t d2 = 0; d2 < other.offsets_.size(); ++d2) {
+                long long o2 = other.offsets_[d2];
+                long long o = o1 + o2;
+                if (o <= -static_cast<long long>(rows_) || o >= static_cast<long long>(other.cols_)) {
+                    continue;
+                }
+                // строка k = i + o1 матрицы B, столбец j = k + o2 результата
+                size_t b2, e2;
+                other.rowRange(o2, b2, e2);
+                long long lo = std::max<long long>(static_cast<long long>(begin), static_cast<long long>(b2) - o1);
+                long long hi = std::min<long long>(static_cast<long long>(end), static_cast<long long>(e2) - o1);
+                if (lo >= hi) continue;
+                const T* a = data_.data() + d1 * rows_;
+                const T* b = other.data_.data() + d2 * other.rows_;
+                T* c = result.data_.data() + result.diagonalIndex(o) * rows_;
+                size_t shift = static_cast<size_t>(o1);
+#pragma omp simd
+                for (size_t i = static_cast<size_t>(lo); i < static_cast<size_t>(hi); ++i) {
+                    c[i] += a[i] * b[i + shift];
+                }
+            }
+        }
+        return result;
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(rows_, cols_);
+        for (size_t d = 0; d < offsets_.size(); ++d) {
+            size_t begin, end;
+            rowRange(offsets_[d], begin, end);
+            for (size_t i = begin; i < end; ++i) {
+                result.setElement(i, i + static_cast<size_t>(offsets_[d]), data_[d * rows_ + i]);
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<long long> offsets_;
+    std::vector<T> data_;
+
+    size_t diagonalIndex(long long off) const {
+        return static_cast<size_t>(std::lower_bound(offsets_.begin(), offsets_.end(), off) - offsets_.begin());
+    }
+
+    // Строки i, для которых столбец i + off лежит внутри матрицы
+    void rowRange(long long off, size_t& begin, size_t& end) const {
+        begin = off < 0 ? static_cast<size_t>(-off) : 0;
+        long long last = static_cast<long long>(cols_) - off;
+        end = static_cast<size_t>(std::max<long long>(0, std::min<long long>(static_cast<long long>(rows_), last)));
+        begin = std::min(begin, end);
+    }
+};
+
+// BSR: плотные блоки b x b, индексируемые как CSR по блочным строкам
+template <typename T>
+class BsrMatrix {
+public:
+    BsrMatrix() = default;
+
+    BsrMatrix(const SparseMatrix<T>& mat, size_t blockSize)
+        : rows_(mat.rows()), cols_(mat.cols()), b_(blockSize) {
+        if (b_ == 0) {
+            throw std::invalid_argument("Block size must be positive.");
+        }
+        size_t blockRows = (rows_ + b_ - 1) / b_;
+        blockRowPtr_.assign(blockRows + 1, 0);
+
+        // Данные упорядочены по строкам - обрабатываем по одной блочной строке
+        auto it = mat.cbegin();
+        std::vector<size_t> blockCols;
+        for (size_t I = 0; I < blockRows; ++I) {
+            auto rowBegin = it;
+            blockCols.clear();
+            while (it != mat.cend() && it->first.first / b_ == I) {
+                blockCols.push_back(it->first.second / b_);
+                ++it;
+            }
+            std::sort(blockCols.begin(), blockCols.end());
+            blockCols.erase(std::unique(blockCols.begin(), blockCols.end()), blockCols.end());
+            size_t first = blockCol_.size();
+            blockCol_.insert(blockCol_.end(), blockCols.begin(), blockCols.end());
+            blocks_.resize(blockCol_.size() * b_ * b_, T{});
+            for (auto jt = rowBegin; jt != it; ++jt) {
+                size_t J = jt->first.second / b_;
+                size_t pos = first + static_cast<size_t>(std::lower_bound(blockCols.begin(), blockCols.end(), J) - blockCols.begin());
+                blocks_[pos * b_ * b_ + (jt->first.first % b_) * b_ + (jt->first.second % b_)] = jt->second;
+            }
+            blockRowPtr_[I + 1] = blockCol_.size();
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t blockSize() const { return b_; }
+    size_t numBlocks() const { return blockCol_.size(); }
+
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.assign(rows_, T{});
+        std::vector<T> acc(b_);
+        for (size_t I = 0; I + 1 < blockRowPtr_.size(); ++I) {
+            std::fill(acc.begin(), acc.end(), T{});
+            for (size_t k = blockRowPtr_[I]; k < blockRowPtr_[I + 1]; ++k) {
+                size_t col0 = blockCol_[k] * b_;
+                size_t bc = std::min(b_, cols_ - col0);
+                const T* block = blocks_.data() + k * b_ * b_;
+                for (size_t r = 0; r < b_; ++r) {
+                    T sum = T{};
+                    for (size_t c = 0; c < bc; ++c) {
+                        sum += block[r * b_ + c] * x[col0 + c];
+                    }
+                    acc[r] += sum;
+                }
+            }
+            size_t row0 = I * b_;
+            size_t br = std::min(b_, rows_ - row0);
+            for (size_t r = 0; r < br; ++r) {
+                y[row0 + r] = acc[r];
+            }
+        }
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    // Блочный Густавсон: C(I,J) += A(I,K) * B(K,J) плотными блоками
+    BsrMatrix operator*(const BsrMatrix& other) const {
+        if (cols_ != other.rows_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        if (b_ != other.b_) {
+            throw std::invalid_argument("Block sizes must match.");
+        }
+        BsrMatrix result;
+        result.rows_ = rows_;
+        result.cols_ = other.cols_;
+        result.b_ = b_;
+        result.blockRowPtr_.assign(blockRowPtr_.size(), 0);
+        size_t bb = b_ * b_;
+        size_t blockColsC = (other.cols_ + b_ - 1) / b_;
+        std::vector<size_t> slot(blockColsC, SIZE_MAX);
+        std::vector<size_t> rowCols;
+        std::vector<T> acc;
+
+        for (size_t I = 0; I + 1 < blockRowPtr_.size(); ++I) {
+            rowCols.clear();
+            acc.clear();
+            for (size_t ka = blockRowPtr_[I]; ka < blockRowPtr_[I + 1]; ++ka) {
+                size_t K = blockCol_[ka];
+                const T* a = blocks_.data() + ka * bb;
+                for (size_t kb = other.blockRowPtr_[K]; kb < other.blockRowPtr_[K + 1]; ++kb) {
+                    size_t J = other.blockCol_[kb];
+                    if (slot[J] == SIZE_MAX) {
+                        slot[J] = rowCols.size();
+                        rowCols.push_back(J);
+                        acc.resize(acc.size() + bb, T{});
+                    }
+                    T* c = acc.data() + slot[J] * bb;
+                    const T* b = other.blocks_.data() + kb * bb;
+                    for (size_t r = 0; r < b_; ++r) {
+                        for (size_t m = 0; m < b_; ++m) {
+                            T av = a[r * b_ + m];
+                            for (size_t q = 0; q < b_; ++q) {
+                                c[r * b_ + q] += av * b[m * b_ + q];
+                            }
+                        }
+                    }
+                }
+            }
+            std::vector<size_t> sorted = rowCols;
+            std::sort(sorted.begin(), sorted.end());
+            for (size_t J : sorted) {
+                const T* c = acc.data() + slot[J] * bb;
+                result.blockCol_.push_back(J);
+                result.blocks_.insert(result.blocks_.end(), c, c + bb);
+                slot[J] = SIZE_MAX;
+            }
+            result.blockRowPtr_[I + 1] = result.blockCol_.size();
+        }
+        return result;
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(rows_, cols_);
+        for (size_t I = 0; I + 1 < blockRowPtr_.size(); ++I) {
+            for (size_t r = 0; r < b_ && I * b_ + r < rows_; ++r) {
+                for (size_t k = blockRowPtr_[I]; k < blockRowPtr_[I + 1]; ++k) {
+                    size_t col0 = blockCol_[k] * b_;
+                    for (size_t c = 0; c < b_ && col0 + c < cols_; ++c) {
+                        result.appendElement(I * b_ + r, col0 + c, blocks_[k * b_ * b_ + r * b_ + c]);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t b_ = 1;
+    std::vector<size_t> blockRowPtr_{ 0 };
+    std::vector<size_t> blockCol_;
+    std::vector<T> blocks_;
+};
+
+// Структурные признаки матрицы для выбора формата
+struct StructureInfo {
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t nnz = 0;
+    size_t numDiagonals = 0;
+    double diaFill = 0.0;       // nnz / (numDiagonals * rows)
+    size_t bestBlockSize = 1;
+    double bsrFill = 0.0;       // nnz / (numBlocks * b * b) для лучшего b
+    bool scaledIdentity = false;
+};
+
+enum class MatrixFormat { Identity, Dia, Bsr, Csr };
+
+template <typename T>
+StructureInfo analyzeStructure(const SparseMatrix<T>& mat) {
+    StructureInfo info;
+    info.rows = mat.rows();
+    info.cols = mat.cols();
+    info.nnz = mat.size();
+    if (info.nnz == 0) return info;
+
+    std::vector<long long> offsets;
+    offsets.reserve(info.nnz);
+    bool diagonalOnly = true;
+    T first = mat.cbegin()->second;
+    bool sameValue = true;
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        long long off = static_cast<long long>(it->first.second) - static_cast<long long>(it->first.first);
+        offsets.push_back(off);
+        diagonalOnly = diagonalOnly && off == 0;
+        sameValue = sameValue && it->second == first;
+    }
+    info.scaledIdentity = diagonalOnly && sameValue && info.rows == info.cols && info.nnz == info.rows;
+
+    std::sort(offsets.begin(), offsets.end());
+    info.numDiagonals = static_cast<size_t>(std::unique(offsets.begin(), offsets.end()) - offsets.begin());
+    info.diaFill = static_cast<double>(info.nnz) / static_cast<double>(info.numDiagonals * info.rows);
+
+    // Заполненность блоков для нескольких кандидатов b
+    const size_t candidates[] = { 2, 3, 4, 6, 8 };
+    std::vector<std::pair<size_t, size_t>> blocks;
+    blocks.reserve(info.nnz);
+    for (size_t b : candidates) {
+        if (b > info.rows || b > info.cols) break;
+        blocks.clear();
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            blocks.emplace_back(it->first.first / b, it->first.second / b);
+        }
+        std::sort(blocks.begin(), blocks.end());
+        size_t numBlocks = static_cast<size_t>(std::unique(blocks.begin(), blocks.end()) - blocks.begin());
+        double fill = static_cast<double>(info.nnz) / static_cast<double>(numBlocks * b * b);
+        // Больший блок выгоднее при той же заполненности
+        if (fill >= info.bsrFill * 0.95) {
+            info.bsrFill = fill;
+            info.bestBlockSize = b;
+        }
+    }
+    return info;
+}
+
+// Пороги: лента выгодна при заполнении диагоналей >= 60% и их числе не
+// больше 64; блоки - при заполнении >= 70%
+inline MatrixFormat chooseFormat(const StructureInfo& info) {
+    if (info.scaledIdentity) return MatrixFormat::Identity;
+    if (info.nnz > 0 && info.numDiagonals <= 64 && info.diaFill >= 0.6) return MatrixFormat::Dia;
+    if (info.bestBlockSize > 1 && info.bsrFill >= 0.7) return MatrixFormat::Bsr;
+    return MatrixFormat::Csr;
+}
+
+// Матрица в автоматически выбранном формате
+template <typename T>
+class FormattedMatrix {
+public:
+    explicit FormattedMatrix(const SparseMatrix<T>& mat) : info_(analyzeStructure(mat)) {
+        switch (chooseFormat(info_)) {
+        case MatrixFormat::Identity:
+            data_ = ScaledIdentity<T>(info_.rows, mat.cbegin()->second);
+            break;
+        case MatrixFormat::Dia:
+            data_ = DiaMatrix<T>(mat);
+            break;
+        case MatrixFormat::Bsr:
+            data_ = BsrMatrix<T>(mat, info_.bestBlockSize);
+            break;
+        default:
+            data_ = CsrMatrix<T>(mat);
+            break;
+        }
+    }
+
+    MatrixFormat format() const {
+        return std::visit([](const auto& m) { return formatOf(m); }, data_);
+    }
+    const StructureInfo& info() const { return info_; }
+
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        std::visit([&](const auto& m) { m.spmv(x, y); }, data_);
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    // SpGEMM: одинаковые форматы (BSR - с одним размером блока) умножаются
+    // своим ядром, единичная матрица сводится к масштабированию, остальное -
+    // через CSR
+    SparseMatrix<T> operator*(const FormattedMatrix& other) const {
+        if (auto id = std::get_if<ScaledIdentity<T>>(&data_)) {
+            return (*id) * other.toSparse();
+        }
+        if (auto id = std::get_if<ScaledIdentity<T>>(&other.data_)) {
+            return toSparse() * (*id);
+        }
+        if (data_.index() == other.data_.index() && sameBlockSize(other)) {
+            return std::visit([&](const auto& m) -> SparseMatrix<T> {
+                using M = std::decay_t<decltype(m)>;
+                return (m * std::get<M>(other.data_)).toSparse();
+                }, data_);
+        }
+        return (toCsr() * other.toCsr()).toSparse();
+    }
+
+    SparseMatrix<T> toSparse() const {
+        return std::visit([](const auto& m) { return m.toSparse(); }, data_);
+    }
+
+private:
+    StructureInfo info_;
+    std::variant<ScaledIdentity<T>, DiaMatrix<T>, BsrMatrix<T>, CsrMatrix<T>> data_{ ScaledIdentity<T>(0) };
+
+    // Явное соответствие, не зависящее от порядка альтернатив data_
+    static MatrixFormat formatOf(const ScaledIdentity<T>&) { return MatrixFormat::Identity; }
+    static MatrixFormat formatOf(const DiaMatrix<T>&) { return MatrixFormat::Dia; }
+    static MatrixFormat formatOf(const BsrMatrix<T>&) { return MatrixFormat::Bsr; }
+    static MatrixFormat formatOf(const CsrMatrix<T>&) { return MatrixFormat::Csr; }
+
+    // Ядро BSR x BSR требует одинаковых блоков; у остальных форматов условия нет
+    bool sameBlockSize(const FormattedMatrix& other) const {
+        auto a = std::get_if<BsrMatrix<T>>(&data_);
+        auto b = std::get_if<BsrMatrix<T>>(&other.data_);
+        return !a || !b || a->blockSize() == b->blockSize();
+    }
+
+    CsrMatrix<T> toCsr() const {
+        if (auto csr = std::get_if<CsrMatrix<T>>(&data_)) return *csr;
+        return CsrMatrix<T>(toSparse());
+    }
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+// Поэлементные ядра над непрерывными массивами значений.
+// Циклы написаны без зависимостей между итерациями и помечены omp simd
+// (сборка с -fopenmp-simd), чтобы компилятор векторизовал их.
+namespace kernels {
+
+    template <typename T>
+    void product(const T* a, const T* b, T* out, size_t n) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    template <typename T>
+    void quotient(const T* a, const T* b, T* out, size_t n) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] / b[i];
+        }
+    }
+
+    template <typename T>
+    void maximum(const T* a, const T* b, T* out, size_t n) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] > b[i] ? a[i] : b[i];
+        }
+    }
+
+    template <typename T>
+    void minimum(const T* a, const T* b, T* out, size_t n) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = a[i] < b[i] ? a[i] : b[i];
+        }
+    }
+
+    // f должна быть чистой: под omp simd итерации идут в любом порядке.
+    // Только для внутренних лямбд; пользовательские функции - mapInOrder
+    template <typename T, typename F>
+    void map(const T* a, T* out, size_t n, F f) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = f(a[i]);
+        }
+    }
+
+    // Применение f строго по порядку элементов (f может иметь состояние)
+    template <typename T, typename F>
+    void mapInOrder(const T* a, T* out, size_t n, F& f) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = f(a[i]);
+        }
+    }
+
+    // Свертка произвольной операцией (порядок слева направо)
+    template <typename T, typename Op>
+    T reduce(const T* a, size_t n, T init, Op op) {
+        T result = init;
+        for (size_t i = 0; i < n; ++i) {
+            result = op(result, a[i]);
+        }
+        return result;
+    }
+
+    // Сумма с векторизованной редукцией
+    template <typename T>
+    T sum(const T* a, size_t n) {
+        T result = T{};
+#pragma omp simd reduction(+:result)
+        for (size_t i = 0; i < n; ++i) {
+            result += a[i];
+        }
+        return result;
+    }
+
+    // Свертка: std::plus - векторизованной суммой (порядок сложения
+    // меняется), остальные операции - reduce слева направо
+    template <typename T, typename Op>
+    T fold(const T* a, size_t n, T init, Op op) {
+        if constexpr (std::is_same_v<Op, std::plus<T>> || std::is_same_v<Op, std::plus<>>) {
+            return init + sum(a, n);
+        }
+        else {
+            return reduce(a, n, init, op);
+        }
+    }
+
+    // Целая степень повторным умножением (двоичное возведение)
+    template <typename T>
+    T integerPow(T base, unsigned long long exp) {
+        T result = T{ 1 };
+        while (exp > 0) {
+            if (exp & 1) {
+                result *= base;
+            }
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+
+    // Возведение в одну и ту же целую степень: общий для всех элементов
+    // цикл по битам показателя, внутренний цикл по элементам векторизуется
+    template <typename T>
+    void integerPow(const T* a, T* out, size_t n, unsigned long long exp) {
+        std::vector<T> base(a, a + n);
+        std::vector<T> acc(n, T{ 1 });
+        T* pb = base.data();
+        T* pa = acc.data();
+        while (exp > 0) {
+            if (exp & 1) {
+#pragma omp simd
+                for (size_t i = 0; i < n; ++i) {
+                    pa[i] *= pb[i];
+                }
+            }
+            exp >>= 1;
+            if (exp > 0) {
+#pragma omp simd
+                for (size_t i = 0; i < n; ++i) {
+                    pb[i] *= pb[i];
+                }
+            }
+        }
+        std::copy(acc.begin(), acc.end(), out);
+    }
+
+    // Показатель степени целый и неотрицательный - можно обойтись без pow
+    template <typename T>
+    bool isNonNegativeInteger(const T& exponent, unsigned long long& result) {
+        double e = static_cast<double>(exponent);
+        if (e < 0 || e > 64 || std::floor(e) != e) {
+            return false;
+        }
+        result = static_cast<unsigned long long>(e);
+        return true;
+    }
+
+    // Корень поэлементно (векторизуется при сборке с -fno-math-errno,
+    // иначе компилятор сохраняет скалярный вызов ради errno)
+    template <typename T>
+    void sqrt(const T* a, T* out, size_t n) {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::sqrt(a[i]);
+        }
+    }
+
+}
@@ -8,7 +8,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cassert>
+#include <vector>
+#include <type_traits>
 #include "myVector.hpp"
+#include "myKernels.hpp"
+#include "myProfiler.hpp"
+#include "mySmallMatrix.hpp"
 
 struct pair_hash {
     size_t operator()(const std::pair<size_t, size_t>& p) const {
@@ -18,6 +23,9 @@ struct pair_hash {
     }
 };
 
+template <typename T>
+class ScaledIdentity;
+
 template <typename T>
 class SparseMatrix {
 public:
@@ -36,6 +44,7 @@ public:
 
     // Установка элемента
     void setElement(size_t row, size_t col, const T& value) {
+        SPARSE_PROFILE_POINT("SparseMatrix::setElement");
         Position pos = { row, col };
         auto it = mainData_.find(pos);
         if (it != mainData_.end()) {
@@ -53,6 +62,7 @@ public:
             if (value != T{}) {
                 mainData_[pos] = value;
                 orderedData_[pos] = value;
+                SPARSE_PROFILE_ALLOC(2);
             }
         }
         maxRow_ = std::max(maxRow_, row);
@@ -61,6 +71,7 @@ public:
 
     // Удаление элемента
     void removeElement(size_t row, size_t col) {
+        SPARSE_PROFILE_POINT("SparseMatrix::removeElement");
         Position pos = { row, col };
         mainData_.erase(pos);
         orderedData_.erase(pos);
@@ -73,6 +84,46 @@ public:
         return mainData_.size();
     }
 
+    // Размерность матрицы
+    size_t rows() const { return maxRow_ + 1; }
+    size_t cols() const { return maxCol_ + 1; }
+
+    // Сумма всех элементов
+    T sum() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::sum");
+        T result = T{};
+        for (auto& kv : orderedData_) {
+            result += kv.second;
+        }
+        SPARSE_PROFILE_FLOPS(orderedData_.size());
+        SPARSE_PROFILE_IO(orderedData_.size(), 0, entryBytes_);
+        return result;
+    }
+
+    // Суммы по строкам (A * 1)
+    SparseVector<T> rowSums() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::rowSums");
+        SparseVector<T> result(maxRow_ + 1);
+        T acc = T{};
+        size_t row = 0;
+        bool hasRow = false;
+        for (auto& kv : orderedData_) {
+            if (hasRow && kv.first.first != row) {
+                result.setElement(row, acc);
+                acc = T{};
+            }
+            row = kv.first.first;
+            hasRow = true;
+            acc += kv.second;
+        }
+        if (hasRow) {
+            result.setElement(row, acc);
+        }
+        SPARSE_PROFILE_FLOPS(orderedData_.size());
+        SPARSE_PROFILE_IO(orderedData_.size(), result.size(), entryBytes_);
+        return result;
+    }
+
     // Очистка
     void clearAll() {
         mainData_.clear();
@@ -81,6 +132,31 @@ public:
         maxCol_ = 0;
     }
 
+    // Резервирование места под nnz элементов
+    void reserve(size_t nnz) {
+        mainData_.reserve(nnz);
+    }
+
+    // Добавление элемента в конец (порядок строка-столбец) за O(1):
+    // позиция с подсказкой вставки, без поиска по дереву.
+    // Если порядок нарушен, выполняется обычный setElement
+    void appendElement(size_t row, size_t col, const T& value) {
+        SPARSE_PROFILE_POINT("SparseMatrix::appendElement");
+        Position pos = { row, col };
+        if (!orderedData_.empty() && !(orderedData_.rbegin()->first < pos)) {
+            setElement(row, col, value);
+            return;
+        }
+        if (value == T{}) {
+            return;
+        }
+        orderedData_.emplace_hint(orderedData_.end(), pos, value);
+        mainData_.emplace(pos, value);
+        SPARSE_PROFILE_ALLOC(2);
+        maxRow_ = std::max(maxRow_, row);
+        maxCol_ = std::max(maxCol_, col);
+    }
+
     Iterator begin() {
         return orderedData_.begin();
     }
@@ -99,26 +175,33 @@ public:
 
     // Транспонирование матрицы
     SparseMatrix transpose() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::transpose");
         SparseMatrix result(maxCol_ + 1, maxRow_ + 1);
         for (auto& kv : mainData_) {
             auto pos = kv.first;
             result.setElement(pos.second, pos.first, kv.second);
         }
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
-    // Сложение с числом
+    // Сложение с числом (затрагивает только хранимые ненулевые элементы;
+    // сдвиг всех элементов матрицы без уплотнения - ShiftedSparseMatrix)
     SparseMatrix operator+(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::addScalar");
         SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
         for (auto& kv : mainData_) {
             auto pos = kv.first;
             T val = kv.second + scalar;
             result.setElement(pos.first, pos.second, val);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     SparseMatrix operator-(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::sub");
         checkDimensions(other);
 
         SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
@@ -136,30 +219,39 @@ public:
             }
         }
 
+        SPARSE_PROFILE_FLOPS(size() + other.size());
+        SPARSE_PROFILE_IO(size() + other.size(), result.size(), entryBytes_);
         return result;
     }
 
     SparseMatrix operator-(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::subScalar");
         SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
         for (auto& kv : mainData_) {
             auto pos = kv.first;
             T val = kv.second - scalar;
             result.setElement(pos.first, pos.second, val);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     SparseMatrix operator*(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::mulScalar");
         SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
         for (auto& kv : mainData_) {
             auto pos = kv.first;
             T val = kv.second * scalar;
             result.setElement(pos.first, pos.second, val);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     SparseMatrix operator/(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::divScalar");
         if (scalar == T{}) {
             throw std::invalid_argument("Division by zero");
         }
@@ -169,11 +261,14 @@ public:
             T val = kv.second / scalar;
             result.setElement(pos.first, pos.second, val);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     // Сложение матриц
     SparseMatrix operator+(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::add");
         checkDimensions(other);
 
         SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
@@ -186,11 +281,14 @@ public:
             T val = result(kv.first.first, kv.first.second) + kv.second;
             result.setElement(kv.first.first, kv.first.second, val);
         }
+        SPARSE_PROFILE_FLOPS(other.size());
+        SPARSE_PROFILE_IO(size() + other.size(), result.size(), entryBytes_);
         return result;
     }
 
     // Матрично-векторное умножение
     SparseVector<T> operator*(const SparseVector<T>& vec) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::spmv");
         SparseVector<T> result(maxRow_ + 1);
         for (auto& kv : mainData_) {
             size_t row = kv.first.first;
@@ -198,14 +296,35 @@ public:
             T val = result[row] + kv.second * vec[col];
             result.setElement(row, val);
         }
+        SPARSE_PROFILE_FLOPS(2 * size());
+        SPARSE_PROFILE_IO(size() + vec.size(), result.size(), entryBytes_);
         return result;
     }
 
+    // Умножение на символьную s*I - без прохода по единичной матрице
+    SparseMatrix operator*(const ScaledIdentity<T>& id) const {
+        if (maxCol_ + 1 != id.size()) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        return (id.scale() == T{ 1 }) ? *this : (*this) * id.scale();
+    }
+
     // Матричное умножение
     SparseMatrix operator*(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::spgemm");
         if (maxCol_ != other.maxRow_) {
             throw std::runtime_error("Matrix dimensions do not match for multiplication.");
         }
+        // Малые квадратные матрицы - развернутое произведение на стеке
+        if (isSquare() && other.isSquare() && maxRow_ + 1 <= SmallMatrixMaxSize) {
+            SparseMatrix small;
+            withSmallSize(maxRow_ + 1, [&](auto n) {
+                constexpr size_t N = decltype(n)::value;
+                small = (SmallMatrix<T, N, N>(*this) * SmallMatrix<T, N, N>(other)).toSparse();
+                });
+            return small;
+        }
+
         SparseMatrix result(maxRow_ + 1, other.maxCol_ + 1);
 
         // Умножение матриц: (A * B)[i,j] = sum_over_k A[i,k]*B[k,j]
@@ -220,25 +339,167 @@ public:
                     T valB = kvB.second;
                     T current = result(i, j) + valA * valB;
                     result.setElement(i, j, current);
+                    SPARSE_PROFILE_FLOPS(2);
                 }
             }
         }
 
+        SPARSE_PROFILE_IO(size() + other.size(), result.size(), entryBytes_);
         return result;
     }
 
-    // Поэлементное возведение в степень
+    // Поэлементное возведение в степень.
+    // Для целых неотрицательных показателей - повторное умножение вместо pow
     SparseMatrix powerAll(const T& exponent) const {
-        SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
-        for (auto& kv : mainData_) {
-            auto pos = kv.first;
-            T val = std::pow(kv.second, exponent);
-            result.setElement(pos.first, pos.second, val);
+        SPARSE_PROFILE_SCOPE("SparseMatrix::powerAll");
+        std::vector<Position> pos;
+        std::vector<T> vals;
+        gatherValues(pos, vals);
+        std::vector<T> out(vals.size());
+        unsigned long long intExp = 0;
+        if (kernels::isNonNegativeInteger(exponent, intExp)) {
+            kernels::integerPow(vals.data(), out.data(), vals.size(), intExp);
         }
-        return result;
+        else {
+            kernels::map(vals.data(), out.data(), vals.size(), [&](const T& v) {
+                return static_cast<T>(std::pow(v, exponent));
+                });
+        }
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Поэлементное (адамарово) произведение: ненулевые только на пересечении шаблонов
+    SparseMatrix cwiseProduct(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::cwiseProduct");
+        checkDimensions(other);
+        std::vector<Position> pos;
+        std::vector<T> a, b;
+        auto it = orderedData_.begin();
+        auto jt = other.orderedData_.begin();
+        while (it != orderedData_.end() && jt != other.orderedData_.end()) {
+            if (it->first < jt->first) {
+                ++it;
+            }
+            else if (jt->first < it->first) {
+                ++jt;
+            }
+            else {
+                pos.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(jt->second);
+                ++it;
+                ++jt;
+            }
+        }
+        std::vector<T> out(a.size());
+        kernels::product(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Поэлементное деление: шаблон результата совпадает с шаблоном this,
+    // деление ненулевого элемента на неявный ноль - ошибка
+    SparseMatrix cwiseQuotient(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::cwiseQuotient");
+        checkDimensions(other);
+        std::vector<Position> pos;
+        std::vector<T> a, b;
+        pos.reserve(orderedData_.size());
+        a.reserve(orderedData_.size());
+        b.reserve(orderedData_.size());
+        auto jt = other.orderedData_.begin();
+        for (auto& kv : orderedData_) {
+            while (jt != other.orderedData_.end() && jt->first < kv.first) {
+                ++jt;
+            }
+            if (jt == other.orderedData_.end() || kv.first < jt->first) {
+                throw std::invalid_argument("Division by zero");
+            }
+            pos.push_back(kv.first);
+            a.push_back(kv.second);
+            b.push_back(jt->second);
+        }
+        std::vector<T> out(a.size());
+        kernels::quotient(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Поэлементный максимум/минимум (неявные нули участвуют в сравнении)
+    SparseMatrix cwiseMax(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::cwiseMax");
+        std::vector<Position> pos;
+        std::vector<T> a, b;
+        gatherUnion(other, pos, a, b);
+        std::vector<T> out(a.size());
+        kernels::maximum(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    SparseMatrix cwiseMin(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::cwiseMin");
+        std::vector<Position> pos;
+        std::vector<T> a, b;
+        gatherUnion(other, pos, a, b);
+        std::vector<T> out(a.size());
+        kernels::minimum(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Поэлементный корень
+    SparseMatrix cwiseSqrt() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::cwiseSqrt");
+        std::vector<Position> pos;
+        std::vector<T> vals;
+        gatherValues(pos, vals);
+        std::vector<T> out(vals.size());
+        kernels::sqrt(vals.data(), out.data(), vals.size());
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Применение функции к каждому хранимому элементу (как powerAll,
+    // неявные нули не затрагиваются); f вызывается по порядку элементов
+    template <typename F>
+    SparseMatrix map(F f) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::map");
+        std::vector<Position> pos;
+        std::vector<T> vals;
+        gatherValues(pos, vals);
+        std::vector<T> out(vals.size());
+        kernels::mapInOrder(vals.data(), out.data(), vals.size(), f);
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(pos, out);
+    }
+
+    // Свертка хранимых элементов по порядку; для std::plus - векторизованная
+    // сумма (порядок сложения другой, для float возможна иная погрешность)
+    template <typename Op>
+    T reduce(Op op, T init = T{}) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::reduce");
+        std::vector<T> vals;
+        vals.reserve(orderedData_.size());
+        for (auto& kv : orderedData_) {
+            vals.push_back(kv.second);
+        }
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), 0, entryBytes_);
+        return kernels::fold(vals.data(), vals.size(), init, op);
     }
 
     bool operator==(const SparseMatrix& other) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::equals");
+        SPARSE_PROFILE_IO(size() + other.size(), 0, entryBytes_);
         if (maxRow_ != other.maxRow_ || maxCol_ != other.maxCol_)
             return false;
         for (auto& kv : mainData_) {
@@ -260,11 +521,15 @@ public:
         return maxRow_ == maxCol_;
     }
 
+    // Явная единичная матрица (n хранимых элементов);
+    // символьная O(1) версия - ScaledIdentity
     static SparseMatrix identity(size_t size) {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::identity");
         SparseMatrix result(size, size);
         for (size_t i = 0; i < size; ++i) {
             result.setElement(i, i, 1);
         }
+        SPARSE_PROFILE_IO(0, size, entryBytes_);
         return result;
     }
 
@@ -275,6 +540,7 @@ public:
 
     // Возведение в целочисленную степень
     SparseMatrix integerPower(int n) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::integerPower");
         if (!isSquare()) {
             throw std::invalid_argument("Matrix must be square to raise to a power.");
         }
@@ -286,30 +552,51 @@ public:
             return inv.integerPower(-n);
         }
         else {
-            // Двоичное возведение в степень
+            // Двоичное возведение в степень. Результат не начинается с
+            // единичной матрицы: первое умножение I * base заменяется копией,
+            // а лишнее возведение base в квадрат на последнем шаге пропускается
             SparseMatrix base = *this;
-            SparseMatrix result = SparseMatrix::identity(maxRow_ + 1);
+            SparseMatrix result;
+            bool hasResult = false;
             int exp = n;
 
             while (exp > 0) {
                 if (exp & 1) {
-                    result = result * base;
+                    result = hasResult ? result * base : base;
+                    hasResult = true;
                 }
-                base = base * base;
                 exp >>= 1;
+                if (exp > 0) {
+                    base = base * base;
+                }
             }
 
+            SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
             return result;
         }
     }
 
     // Обращение матрицы (метод Гаусса) - упрощенная версия
     SparseMatrix inverse() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::inverse");
         if (!isSquare()) {
             throw std::invalid_argument("Matrix must be square to invert.");
         }
 
         size_t n = maxRow_ + 1;
+        // Малые размеры - LU/явные формулы без хеш-таблиц (mySmallMatrix.hpp).
+        // Только для вещественных T: целочисленный Гаусс-Жордан ниже делит нацело
+        if constexpr (std::is_floating_point_v<T>) {
+            if (n <= SmallMatrixMaxSize) {
+                SparseMatrix small;
+                withSmallSize(n, [&](auto size) {
+                    constexpr size_t N = decltype(size)::value;
+                    small = SmallMatrix<T, N, N>(*this).inverse().toSparse();
+                    });
+                return small;
+            }
+        }
+
         SparseMatrix aug(n, n * 2);
         // Формируем [A|I]
         for (size_t i = 0; i < n; ++i) {
@@ -371,12 +658,16 @@ public:
             }
         }
 
+        // Гаусс-Жордан по [A|I]: n строк * n исключений * 2n столбцов * 2
+        SPARSE_PROFILE_FLOPS(4 * n * n * n);
+        SPARSE_PROFILE_IO(size(), inverseMat.size(), entryBytes_);
         return inverseMat;
     }
 
     // Возведение в вещественную степень: A^p = exp(p * log(A))
     // Требует логарифма и экспоненты матрицы
     SparseMatrix doublePower(double p) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::doublePower");
         if (!isSquare()) {
             throw std::invalid_argument("Matrix must be square to raise to a real power.");
         }
@@ -387,6 +678,9 @@ public:
 
     // Простая оценка нормы Фробениуса для проверки условий вычислений
     double frobeniusNorm() const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::frobeniusNorm");
+        SPARSE_PROFILE_FLOPS(2 * (maxRow_ + 1) * (maxCol_ + 1));
+        SPARSE_PROFILE_IO(size(), 0, entryBytes_);
         double norm = 0.0;
         for (size_t i = 0; i <= maxRow_; ++i) {
             for (size_t j = 0; j <= maxCol_; ++j) {
@@ -399,6 +693,7 @@ public:
 
     // Приблизительный логарифм матрицы через ряд
     SparseMatrix log(int approxOrder = 50) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::log");
         if (!isSquare()) {
             throw std::invalid_argument("Matrix must be square.");
         }
@@ -428,11 +723,13 @@ public:
             }
         }
 
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     // Приблизительная экспонента матрицы
     SparseMatrix exp(int approxOrder = 20) const {
+        SPARSE_PROFILE_SCOPE("SparseMatrix::exp");
         if (!isSquare()) {
             throw std::invalid_argument("Matrix must be square to compute exp.");
         }
@@ -448,6 +745,7 @@ public:
             result = result + term;
         }
 
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
@@ -458,6 +756,23 @@ private:
     size_t maxRow_ = 0;
     size_t maxCol_ = 0;
 
+    // Оценка байт на элемент для счетчиков профилировщика
+    static constexpr size_t entryBytes_ = sizeof(Position) + sizeof(T);
+
+    // f(integral_constant<size_t, n>) для 1 <= n <= SmallMatrixMaxSize
+    template <typename F>
+    static void withSmallSize(size_t n, F f) {
+        switch (n) {
+        case 1: f(std::integral_constant<size_t, 1>{}); break;
+        case 2: f(std::integral_constant<size_t, 2>{}); break;
+        case 3: f(std::integral_constant<size_t, 3>{}); break;
+        case 4: f(std::integral_constant<size_t, 4>{}); break;
+        case 5: f(std::integral_constant<size_t, 5>{}); break;
+        case 6: f(std::integral_constant<size_t, 6>{}); break;
+        default: throw std::invalid_argument("Size exceeds SmallMatrixMaxSize.");
+        }
+    }
+
     void recalcMaxIndices() {
         maxRow_ = 0;
         maxCol_ = 0;
@@ -467,9 +782,127 @@ private:
         }
     }
 
+    // Выгрузка позиций и значений в непрерывные массивы
+    void gatherValues(std::vector<Position>& pos, std::vector<T>& vals) const {
+        pos.reserve(orderedData_.size());
+        vals.reserve(orderedData_.size());
+        for (auto& kv : orderedData_) {
+            pos.push_back(kv.first);
+            vals.push_back(kv.second);
+        }
+    }
+
+    // Объединение шаблонов двух матриц с неявными нулями
+    void gatherUnion(const SparseMatrix& other, std::vector<Position>& pos,
+        std::vector<T>& a, std::vector<T>& b) const {
+        checkDimensions(other);
+        auto it = orderedData_.begin();
+        auto jt = other.orderedData_.begin();
+        while (it != orderedData_.end() || jt != other.orderedData_.end()) {
+            if (jt == other.orderedData_.end() || (it != orderedData_.end() && it->first < jt->first)) {
+                pos.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(T{});
+                ++it;
+            }
+            else if (it == orderedData_.end() || jt->first < it->first) {
+                pos.push_back(jt->first);
+                a.push_back(T{});
+                b.push_back(jt->second);
+                ++jt;
+            }
+            else {
+                pos.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(jt->second);
+                ++it;
+                ++jt;
+            }
+        }
+    }
+
+    // Сборка результата из упорядоченных позиций (размер как у this)
+    SparseMatrix fromSorted(const std::vector<Position>& pos, const std::vector<T>& vals) const {
+        SparseMatrix result(maxRow_ + 1, maxCol_ + 1);
+        result.reserve(pos.size());
+        for (size_t i = 0; i < pos.size(); ++i) {
+            result.appendElement(pos[i].first, pos[i].second, vals[i]);
+        }
+        return result;
+    }
+
     void checkDimensions(const SparseMatrix& other) const {
         if (maxRow_ != other.maxRow_ || maxCol_ != other.maxCol_) {
             throw std::invalid_argument("Matrices must have the same dimensions.");
         }
     }
 };
+
+
+// Символьная матрица s * I размера n x n: хранит только размер и множитель,
+// произведения с ней сводятся к умножению на скаляр
+template <typename T>
+class ScaledIdentity {
+public:
+    explicit ScaledIdentity(size_t size, const T& scale = T{ 1 }) : size_(size), scale_(scale) {}
+
+    size_t size() const { return size_; }
+    T scale() const { return scale_; }
+
+    T operator()(size_t row, size_t col) const {
+        return (row == col && row < size_) ? scale_ : T{};
+    }
+
+    ScaledIdentity operator*(const ScaledIdentity& other) const {
+        checkSize(other.size_);
+        return ScaledIdentity(size_, scale_ * other.scale_);
+    }
+
+    ScaledIdentity operator*(const T& scalar) const {
+        return ScaledIdentity(size_, scale_ * scalar);
+    }
+
+    ScaledIdentity operator+(const ScaledIdentity& other) const {
+        checkSize(other.size_);
+        return ScaledIdentity(size_, scale_ + other.scale_);
+    }
+
+    SparseMatrix<T> operator*(const SparseMatrix<T>& mat) const {
+        checkSize(mat.rows());
+        return (scale_ == T{ 1 }) ? mat : mat * scale_;
+    }
+
+    // size() у SparseVector - число ненулевых, сверяется размерность
+    SparseVector<T> operator*(const SparseVector<T>& vec) const {
+        checkSize(vec.dimension());
+        return (scale_ == T{ 1 }) ? vec : vec * scale_;
+    }
+
+    // Плотный вектор: y = s * x
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        checkSize(x.size());
+        y.resize(size_);
+        for (size_t i = 0; i < size_; ++i) {
+            y[i] = scale_ * x[i];
+        }
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(size_, size_);
+        result.reserve(size_);
+        for (size_t i = 0; i < size_; ++i) {
+            result.appendElement(i, i, scale_);
+        }
+        return result;
+    }
+
+private:
+    size_t size_;
+    T scale_;
+
+    void checkSize(size_t n) const {
+        if (n != size_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+    }
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "myMatrix.hpp"
+#include "myParallel.hpp"
+
+// Смешанная точность для SpMV: компактные индексы (32 бита вместо пары
+// size_t) и хранение значений в float или bfloat16 при накоплении в double.
+// На элемент приходится 4 + 4 (float) или 4 + 2 (bfloat16) байта вместо
+// 8 + 16 у SparseMatrix<double> и 8 + 8 у CsrMatrix<double>.
+
+// bfloat16: старшие 16 бит float (8 бит порядка, 7 бит мантиссы)
+struct bfloat16 {
+    uint16_t bits = 0;
+
+    bfloat16() = default;
+
+    // Округление к ближайшему, при равенстве - к четному
+    explicit bfloat16(float value) {
+        uint32_t u;
+        std::memcpy(&u, &value, sizeof(u));
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) {
+            bits = 0x7FC0;      // NaN
+            return;
+        }
+        u += 0x7FFFu + ((u >> 16) & 1u);
+        bits = static_cast<uint16_t>(u >> 16);
+    }
+
+    explicit operator float() const {
+        uint32_t u = static_cast<uint32_t>(bits) << 16;
+        float value;
+        std::memcpy(&value, &u, sizeof(value));
+        return value;
+    }
+
+    bool operator==(const bfloat16& other) const { return bits == other.bits; }
+    bool operator!=(const bfloat16& other) const { return bits != other.bits; }
+};
+
+namespace mixed {
+
+    // Перевод хранимого значения в тип накопления
+    inline double widen(double v) { return v; }
+    inline double widen(float v) { return static_cast<double>(v); }
+    inline double widen(bfloat16 v) { return static_cast<double>(static_cast<float>(v)); }
+
+    template <typename Storage>
+    Storage narrow(double v) {
+        if constexpr (std::is_same_v<Storage, bfloat16>) {
+            return bfloat16(static_cast<float>(v));
+        }
+        else {
+            return static_cast<Storage>(v);
+        }
+    }
+
+}
+
+// CSR с выбираемыми типами значений и индексов; умножение на double-векторы
+template <typename Storage, typename Index = uint32_t>
+class CompactCsrMatrix {
+public:
+    CompactCsrMatrix() = default;
+
+    template <typename T>
+    explicit CompactCsrMatrix(const SparseMatrix<T>& mat)
+        : rows_(mat.rows()), cols_(mat.cols()) {
+        if (mat.size() > std::numeric_limits<Index>::max() || cols_ > std::numeric_limits<Index>::max()) {
+            throw std::invalid_argument("Matrix too large for index type.");
+        }
+        rowPtr_.assign(rows_ + 1, 0);
+        colIdx_.reserve(mat.size());
+        values_.reserve(mat.size());
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            ++rowPtr_[it->first.first + 1];
+            colIdx_.push_back(static_cast<Index>(it->first.second));
+            values_.push_back(mixed::narrow<Storage>(static_cast<double>(it->second)));
+        }
+        for (size_t i = 0; i < rows_; ++i) {
+            rowPtr_[i + 1] += rowPtr_[i];
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+
+    // Объем хранимых массивов в байтах
+    size_t bytes() const {
+        return rowPtr_.size() * sizeof(Index) + colIdx_.size() * sizeof(Index) + values_.size() * sizeof(Storage);
+    }
+
+    double operator()(size_t row, size_t col) const {
+        for (Index k = rowPtr_[row]; k < rowPtr_[row + 1]; ++k) {
+            if (colIdx_[k] == col) return mixed::widen(values_[k]);
+        }
+        return 0.0;
+    }
+
+    // y = A x с накоплением в double
+    void spmv(const std::vector<double>& x, std::vector<double>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        spmvRows(x.data(), y.data(), 0, rows_);
+    }
+
+    // y = A x в threads потоках; строки делятся поровну по числу ненулевых
+    void spmv(const std::vector<double>& x, std::vector<double>& y, unsigned threads) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.resize(rows_);
+        parallel::forEachPart(parallel::balancedPartition(rowPtr_, threads),
+            [&](size_t, size_t first, size_t last) { spmvRows(x.data(), y.data(), first, last); });
+    }
+
+    // Строки [first, last) произведения
+    void spmvRows(const double* x, double* y, size_t first, size_t last) const {
+        const Index* col = colIdx_.data();
+        const Storage* val = values_.data();
+        for (size_t i = first; i < last; ++i) {
+            double sum = 0.0;
+            size_t begin = rowPtr_[i];
+            size_t end = rowPtr_[i + 1];
+#pragma omp simd reduction(+:sum)
+            for (size_t k = begin; k < end; ++k) {
+                sum += mixed::widen(val[k]) * x[col[k]];
+            }
+            y[i] = sum;
+        }
+    }
+
+    std::vector<double> operator*(const std::vector<double>& x) const {
+        std::vector<double> y;
+        spmv(x, y);
+        return y;
+    }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<Index> rowPtr_;
+    std::vector<Index> colIdx_;
+    std::vector<Storage> values_;
+};
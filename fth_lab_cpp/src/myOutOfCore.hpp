@@ -0,0 +1,389 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "myMatrix.hpp"
+#include "myFormats.hpp"
+
+// Матрицы во внешней памяти: файл на локальном диске хранит матрицу
+// полосами строк (panel) в CSR. SpMV и SpGEMM читают полосы по очереди,
+// пока одна считается, фоновый поток читает следующую через pread
+// (двойная буферизация). Бюджет памяти делится так:
+//  - create пишет полосы не больше четверти бюджета, SpMV держит две;
+//  - SpGEMM держит две полосы A и копит полосу результата (тоже до
+//    четверти бюджета), итого не больше 3/4 бюджета. Сама B и плотный
+//    аккумулятор строки (other.cols() значений и маркеров) - вне бюджета.
+//
+// Файл: [заголовок][полоса 0]...[полоса P-1][оглавление]
+//  заголовок - FileHeader, оглавление - PanelInfo на каждую полосу;
+//  полоса - rowPtr (uint64, строк + 1, отсчет от начала полосы),
+//  colIdx (uint64, nnz), values (T, nnz).
+namespace outofcore {
+
+    static_assert(sizeof(size_t) == sizeof(uint64_t), "Panel indices are stored as 64-bit integers.");
+
+    constexpr char magic[8] = { 'S', 'P', 'O', 'O', 'C', '0', '1', '\0' };
+
+    struct FileHeader {
+        char magic[8];
+        uint64_t valueSize;
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t nnz;
+        uint64_t panels;
+        uint64_t indexOffset;
+    };
+
+    struct PanelInfo {
+        uint64_t rowBegin;
+        uint64_t rowEnd;
+        uint64_t offset;
+        uint64_t nnz;
+    };
+
+    template <typename T>
+    constexpr size_t panelBytes(size_t rows, size_t nnz) {
+        return (rows + 1) * sizeof(uint64_t) + nnz * (sizeof(uint64_t) + sizeof(T));
+    }
+
+    // Дескриптор файла, закрывается в деструкторе
+    class FileHandle {
+    public:
+        FileHandle() = default;
+        FileHandle(const std::string& path, int flags) : path_(path) {
+            fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+            if (fd_ < 0) {
+                throw std::runtime_error("Cannot open file: " + path);
+            }
+        }
+        FileHandle(FileHandle&& other) noexcept
+            : fd_(std::exchange(other.fd_, -1)), path_(std::move(other.path_)) {}
+        FileHandle& operator=(FileHandle&& other) noexcept {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                path_ = std::move(other.path_);
+            }
+            return *this;
+        }
+        FileHandle(const FileHandle&) = delete;
+        FileHandle& operator=(const FileHandle&) = delete;
+        ~FileHandle() { close(); }
+
+        const std::string& path() const { return path_; }
+
+        // pread/pwrite безопасны при одновременных вызовах из разных потоков
+        void readAt(void* data, size_t bytes, uint64_t offset) const {
+            char* p = static_cast<char*>(data);
+            while (bytes > 0) {
+                ssize_t n = ::pread(fd_, p, bytes, static_cast<off_t>(offset));
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                    throw std::runtime_error("Cannot read file: " + path_);
+                }
+                p += n;
+                bytes -= static_cast<size_t>(n);
+                offset += static_cast<uint64_t>(n);
+            }
+        }
+
+        void writeAt(const void* data, size_t bytes, uint64_t offset) const {
+            const char* p = static_cast<const char*>(data);
+            while (bytes > 0) {
+                ssize_t n = ::pwrite(fd_, p, bytes, static_cast<off_t>(offset));
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                    throw std::runtime_error("Cannot write file: " + path_);
+                }
+                p += n;
+                bytes -= static_cast<size_t>(n);
+                offset += static_cast<uint64_t>(n);
+            }
+        }
+
+    private:
+        int fd_ = -1;
+        std::string path_;
+
+        void close() {
+            if (fd_ >= 0) ::close(fd_);
+            fd_ = -1;
+        }
+    };
+
+}
+
+// Последовательная запись полос; полосы больше panelLimit делятся по строкам
+template <typename T>
+class PanelWriter {
+    static_assert(std::is_trivially_copyable_v<T>, "Out-of-core values must be trivially copyable.");
+
+public:
+    PanelWriter(const std::string& path, size_t rows, size_t cols, size_t panelLimit)
+        : file_(path, O_WRONLY | O_CREAT | O_TRUNC), rows_(rows), cols_(cols), panelLimit_(panelLimit),
+        offset_(sizeof(outofcore::FileHeader)) {}
+
+    // Следующие panel.rows() строк матрицы
+    void append(const CsrMatrix<T>& panel) {
+        flushRows();
+        if (panel.cols() != cols_ || nextRow_ + panel.rows() > rows_) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        const std::vector<size_t>& rowPtr = panel.rowPtr();
+        size_t first = 0;
+        while (first < panel.rows()) {
+            size_t last = first + 1;
+            if (outofcore::panelBytes<T>(1, rowPtr[last] - rowPtr[first]) > panelLimit_) {
+                throw std::runtime_error("Panel exceeds memory budget.");
+            }
+            while (last < panel.rows()
+                && outofcore::panelBytes<T>(last + 1 - first, rowPtr[last + 1] - rowPtr[first]) <= panelLimit_) {
+                ++last;
+            }
+            writePanel(rowPtr.data(), panel.colIdx().data(), panel.values().data(), first, last);
+            first = last;
+        }
+    }
+
+    // Следующая строка матрицы (столбцы по возрастанию). Строки копятся в
+    // полосу; полоса пишется до добавления строки, которая в нее не влезет,
+    // так что буфер никогда не превышает panelLimit
+    void appendRow(const size_t* cols, const T* vals, size_t count) {
+        if (nextRow_ + bufferedRows() + 1 > rows_) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        if (outofcore::panelBytes<T>(1, count) > panelLimit_) {
+            throw std::runtime_error("Panel exceeds memory budget.");
+        }
+        if (outofcore::panelBytes<T>(bufferedRows() + 1, colIdx_.size() + count) > panelLimit_) {
+            flushRows();
+        }
+        colIdx_.insert(colIdx_.end(), cols, cols + count);
+        values_.insert(values_.end(), vals, vals + count);
+        rowPtr_.push_back(colIdx_.size());
+    }
+
+    // Оглавление и заголовок; после finish файл можно открывать
+    void finish() {
+        flushRows();
+        if (nextRow_ != rows_) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        file_.writeAt(index_.data(), index_.size() * sizeof(outofcore::PanelInfo), offset_);
+        outofcore::FileHeader header{};
+        std::memcpy(header.magic, outofcore::magic, sizeof(header.magic));
+        header.valueSize = sizeof(T);
+        header.rows = rows_;
+        header.cols = cols_;
+        header.nnz = nnz_;
+        header.panels = index_.size();
+        header.indexOffset = offset_;
+        file_.writeAt(&header, sizeof(header), 0);
+    }
+
+private:
+    outofcore::FileHandle file_;
+    size_t rows_;
+    size_t cols_;
+    size_t panelLimit_;
+    uint64_t offset_;
+    size_t nextRow_ = 0;
+    size_t nnz_ = 0;
+    std::vector<outofcore::PanelInfo> index_;
+    // Строки appendRow, еще не записанные в файл
+    std::vector<size_t> rowPtr_{ 0 };
+    std::vector<size_t> colIdx_;
+    std::vector<T> values_;
+
+    size_t bufferedRows() const { return rowPtr_.size() - 1; }
+
+    void flushRows() {
+        if (bufferedRows() == 0) return;
+        writePanel(rowPtr_.data(), colIdx_.data(), values_.data(), 0, bufferedRows());
+        rowPtr_.assign(1, 0);
+        colIdx_.clear();
+        values_.clear();
+    }
+
+    void writePanel(const size_t* rowPtr, const size_t* colIdx, const T* values, size_t first, size_t last) {
+        size_t begin = rowPtr[first];
+        size_t nnz = rowPtr[last] - begin;
+        std::vector<uint64_t> localPtr(last - first + 1);
+        for (size_t i = first; i <= last; ++i) {
+            localPtr[i - first] = rowPtr[i] - begin;
+        }
+        outofcore::PanelInfo info{ nextRow_, nextRow_ + (last - first), offset_, nnz };
+        file_.writeAt(localPtr.data(), localPtr.size() * sizeof(uint64_t), offset_);
+        offset_ += localPtr.size() * sizeof(uint64_t);
+        file_.writeAt(colIdx + begin, nnz * sizeof(uint64_t), offset_);
+        offset_ += nnz * sizeof(uint64_t);
+        file_.writeAt(values + begin, nnz * sizeof(T), offset_);
+        offset_ += nnz * sizeof(T);
+        index_.push_back(info);
+        nextRow_ += last - first;
+        nnz_ += nnz;
+    }
+};
+
+template <typename T>
+class OutOfCoreMatrix {
+    static_assert(std::is_trivially_copyable_v<T>, "Out-of-core values must be trivially copyable.");
+
+public:
+    // Запись матрицы в path полосами не больше memoryBudget / 4 байт
+    static OutOfCoreMatrix create(const SparseMatrix<T>& mat, const std::string& path, size_t memoryBudget) {
+        PanelWriter<T> writer(path, mat.rows(), mat.cols(), memoryBudget / 4);
+        std::vector<size_t> rowCols;
+        std::vector<T> rowValues;
+        auto it = mat.cbegin();
+        for (size_t i = 0; i < mat.rows(); ++i) {
+            rowCols.clear();
+            rowValues.clear();
+            for (; it != mat.cend() && it->first.first == i; ++it) {
+                rowCols.push_back(it->first.second);
+                rowValues.push_back(it->second);
+            }
+            writer.appendRow(rowCols.data(), rowValues.data(), rowCols.size());
+        }
+        writer.finish();
+        return OutOfCoreMatrix(path, memoryBudget);
+    }
+
+    // Открытие существующего файла; две самые большие полосы должны
+    // помещаться в memoryBudget
+    OutOfCoreMatrix(const std::string& path, size_t memoryBudget)
+        : file_(path, O_RDONLY), memoryBudget_(memoryBudget) {
+        outofcore::FileHeader header{};
+        file_.readAt(&header, sizeof(header), 0);
+        if (std::memcmp(header.magic, outofcore::magic, sizeof(header.magic)) != 0 || header.valueSize != sizeof(T)) {
+            throw std::runtime_error("Not an out-of-core matrix file: " + path);
+        }
+        rows_ = header.rows;
+        cols_ = header.cols;
+        nnz_ = header.nnz;
+        index_.resize(header.panels);
+        file_.readAt(index_.data(), index_.size() * sizeof(outofcore::PanelInfo), header.indexOffset);
+        for (const auto& info : index_) {
+            maxPanelBytes_ = std::max(maxPanelBytes_, outofcore::panelBytes<T>(info.rowEnd - info.rowBegin, info.nnz));
+        }
+        if (2 * maxPanelBytes_ > memoryBudget_) {
+            throw std::runtime_error("Panel exceeds memory budget.");
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return nnz_; }
+    size_t panelCount() const { return index_.size(); }
+    size_t maxPanelBytes() const { return maxPanelBytes_; }
+    size_t memoryBudget() const { return memoryBudget_; }
+    const std::string& path() const { return file_.path(); }
+
+    // f(rowBegin, panel) для полос по порядку; следующая полоса читается
+    // в фоновом потоке, пока f обрабатывает текущую
+    template <typename F>
+    void forEachPanel(F f) const {
+        if (index_.empty()) return;
+        CsrMatrix<T> current = readPanel(0);
+        for (size_t p = 0; p < index_.size(); ++p) {
+            std::future<CsrMatrix<T>> next;
+            if (p + 1 < index_.size()) {
+                next = std::async(std::launch::async, [this, p] { return readPanel(p + 1); });
+            }
+            f(static_cast<size_t>(index_[p].rowBegin), static_cast<const CsrMatrix<T>&>(current));
+            if (next.valid()) current = next.get();
+        }
+    }
+
+    // y = A x, x и y в памяти
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.assign(rows_, T{});
+        forEachPanel([&](size_t rowBegin, const CsrMatrix<T>& panel) {
+            panel.spmvRows(x.data(), y.data() + rowBegin, 0, panel.rows());
+            });
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+    // SpGEMM A * B с B в памяти; результат считается по строкам, пишется
+    // полосами до memoryBudget / 4 в path и открывается с тем же бюджетом.
+    // Две полосы A и полоса результата должны помещаться в бюджет
+    OutOfCoreMatrix multiply(const CsrMatrix<T>& other, const std::string& path) const {
+        if (cols_ != other.rows()) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        size_t limit = memoryBudget_ / 4;
+        if (2 * maxPanelBytes_ + limit > memoryBudget_) {
+            throw std::runtime_error("Panel exceeds memory budget.");
+        }
+        PanelWriter<T> writer(path, rows_, other.cols(), limit);
+        std::vector<T> acc(other.cols(), T{});
+        std::vector<size_t> marker(other.cols(), SIZE_MAX);
+        std::vector<size_t> rowCols;
+        std::vector<T> rowValues;
+        forEachPanel([&](size_t rowBegin, const CsrMatrix<T>& panel) {
+            for (size_t i = 0; i < panel.rows(); ++i) {
+                panel.multiplyRow(other, i, rowBegin + i, acc, marker, rowCols);
+                rowValues.resize(rowCols.size());
+                for (size_t k = 0; k < rowCols.size(); ++k) rowValues[k] = acc[rowCols[k]];
+                writer.appendRow(rowCols.data(), rowValues.data(), rowCols.size());
+            }
+            });
+        writer.finish();
+        return OutOfCoreMatrix(path, memoryBudget_);
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(rows_, cols_);
+        result.reserve(nnz_);
+        forEachPanel([&](size_t rowBegin, const CsrMatrix<T>& panel) {
+            for (size_t i = 0; i < panel.rows(); ++i) {
+                for (size_t k = panel.rowPtr()[i]; k < panel.rowPtr()[i + 1]; ++k) {
+                    result.appendElement(rowBegin + i, panel.colIdx()[k], panel.values()[k]);
+                }
+            }
+            });
+        return result;
+    }
+
+private:
+    outofcore::FileHandle file_;
+    size_t memoryBudget_;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t nnz_ = 0;
+    size_t maxPanelBytes_ = 0;
+    std::vector<outofcore::PanelInfo> index_;
+
+    CsrMatrix<T> readPanel(size_t p) const {
+        const outofcore::PanelInfo& info = index_[p];
+        size_t count = info.rowEnd - info.rowBegin;
+        std::vector<size_t> rowPtr(count + 1);
+        std::vector<size_t> colIdx(info.nnz);
+        std::vector<T> values(info.nnz);
+        uint64_t offset = info.offset;
+        file_.readAt(rowPtr.data(), rowPtr.size() * sizeof(uint64_t), offset);
+        offset += rowPtr.size() * sizeof(uint64_t);
+        file_.readAt(colIdx.data(), colIdx.size() * sizeof(uint64_t), offset);
+        offset += colIdx.size() * sizeof(uint64_t);
+        file_.readAt(values.data(), values.size() * sizeof(T), offset);
+        return CsrMatrix<T>(count, cols_, std::move(rowPtr), std::move(colIdx), std::move(values));
+    }
+};
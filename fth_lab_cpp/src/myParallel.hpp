@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Простейший параллелизм на std::thread: разбиение диапазона на части
+// и запуск функции для каждой части. Часть 0 выполняется в вызывающем
+// потоке, исключение из любой части пробрасывается наружу.
+namespace parallel {
+
+    inline unsigned hardwareThreads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // Границы parts равных частей [0, n): bounds[p]..bounds[p + 1]
+    inline std::vector<size_t> uniformPartition(size_t n, size_t parts) {
+        parts = std::max<size_t>(1, std::min(parts, std::max<size_t>(n, 1)));
+        std::vector<size_t> bounds(parts + 1);
+        for (size_t p = 0; p <= parts; ++p) {
+            bounds[p] = n * p / parts;
+        }
+        return bounds;
+    }
+
+    // Части с примерно равным весом по префиксным суммам весов
+    // (prefix.size() == n + 1, например rowPtr для CSR)
+    template <typename Index>
+    std::vector<size_t> balancedPartition(const std::vector<Index>& prefix, size_t parts) {
+        size_t n = prefix.empty() ? 0 : prefix.size() - 1;
+        parts = std::max<size_t>(1, std::min(parts, std::max<size_t>(n, 1)));
+        std::vector<size_t> bounds(parts + 1, n);
+        bounds[0] = 0;
+        size_t total = n ? static_cast<size_t>(prefix[n] - prefix[0]) : 0;
+        for (size_t p = 1; p < parts; ++p) {
+            Index target = static_cast<Index>(prefix[0] + total * p / parts);
+            size_t pos = static_cast<size_t>(std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin());
+            bounds[p] = std::max(bounds[p - 1], std::min(pos, n));
+        }
+        return bounds;
+    }
+
+    // f(part, begin, end) для каждой части разбиения
+    template <typename F>
+    void forEachPart(const std::vector<size_t>& bounds, F f) {
+        size_t parts = bounds.size() - 1;
+        if (parts == 1) {
+            f(size_t{ 0 }, bounds[0], bounds[1]);
+            return;
+        }
+        std::vector<std::exception_ptr> errors(parts);
+        std::vector<std::thread> workers;
+        workers.reserve(parts - 1);
+        for (size_t p = 1; p < parts; ++p) {
+            workers.emplace_back([&, p] {
+                try {
+                    f(p, bounds[p], bounds[p + 1]);
+                }
+                catch (...) {
+                    errors[p] = std::current_exception();
+                }
+                });
+        }
+        try {
+            f(size_t{ 0 }, bounds[0], bounds[1]);
+        }
+        catch (...) {
+            errors[0] = std::current_exception();
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        for (auto& e : errors) {
+            if (e) std::rethrow_exception(e);
+        }
+    }
+
+}
@@ -0,0 +1,386 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#ifdef SPARSE_PROFILING
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#endif
+
+// Инструментирование операций SparseMatrix/SparseVector.
+//
+// Включается только при сборке с -DSPARSE_PROFILING (make PROFILE=1).
+// Без этого флага все макросы SPARSE_PROFILE_* раскрываются в пустые
+// инструкции, а API ниже возвращает пустые снимки - в коде библиотеки не
+// остается ни одной лишней инструкции.
+//
+// Для каждой операции копятся: число вызовов, полное и собственное время
+// (без вложенных операций), flops, перемещенные байты (оценка по числу
+// прочитанных и записанных элементов), число выделений узлов контейнеров,
+// nnz на входе и выходе. Flops, байты и выделения вложенных операций
+// прибавляются и к объемлющей (exp видит все свои setElement).
+//
+// Счетчики потоко-локальные: пишет только владелец потока (relaxed-атомики
+// без read-modify-write, то есть обычные mov), снимок суммирует все потоки.
+// Трасса в формате Chrome trace event (chrome://tracing, Perfetto) пишется
+// только после setTracing(true).
+namespace profiler {
+
+    struct OpStats {
+        std::string name;
+        uint64_t calls = 0;
+        uint64_t totalNs = 0;
+        uint64_t selfNs = 0;
+        uint64_t flops = 0;
+        uint64_t bytes = 0;
+        uint64_t allocations = 0;
+        uint64_t nnzIn = 0;
+        uint64_t nnzOut = 0;
+    };
+
+    struct Snapshot {
+        std::vector<OpStats> ops;
+
+        const OpStats* find(const std::string& name) const {
+            for (const auto& op : ops) {
+                if (op.name == name) return &op;
+            }
+            return nullptr;
+        }
+    };
+
+    // Таблица по снимку, отсортированная по полному времени
+    inline void printSnapshot(const Snapshot& snap, std::ostream& os) {
+        std::vector<const OpStats*> rows;
+        for (const auto& op : snap.ops) rows.push_back(&op);
+        std::sort(rows.begin(), rows.end(), [](const OpStats* a, const OpStats* b) {
+            return a->totalNs > b->totalNs;
+            });
+        os << std::left << std::setw(34) << "operation" << std::right
+            << std::setw(12) << "calls" << std::setw(12) << "total ms" << std::setw(12) << "self ms"
+            << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+            << std::setw(12) << "allocs" << std::setw(12) << "nnz in" << std::setw(12) << "nnz out" << '\n';
+        os << std::fixed << std::setprecision(3);
+        for (const OpStats* op : rows) {
+            double ns = static_cast<double>(op->totalNs);
+            os << std::left << std::setw(34) << op->name << std::right
+                << std::setw(12) << op->calls
+                << std::setw(12) << ns / 1e6
+                << std::setw(12) << static_cast<double>(op->selfNs) / 1e6
+                << std::setw(10) << (ns > 0 ? static_cast<double>(op->flops) / ns : 0.0)
+                << std::setw(10) << (ns > 0 ? static_cast<double>(op->bytes) / ns : 0.0)
+                << std::setw(12) << op->allocations
+                << std::setw(12) << op->nnzIn
+                << std::setw(12) << op->nnzOut << '\n';
+        }
+        os << std::defaultfloat;
+    }
+
+#ifdef SPARSE_PROFILING
+
+    constexpr bool enabled = true;
+
+    namespace detail {
+
+        constexpr size_t kMaxOps = 128;
+
+        struct Counters {
+            std::atomic<uint64_t> calls{ 0 };
+            std::atomic<uint64_t> totalNs{ 0 };
+            std::atomic<uint64_t> selfNs{ 0 };
+            std::atomic<uint64_t> flops{ 0 };
+            std::atomic<uint64_t> bytes{ 0 };
+            std::atomic<uint64_t> allocations{ 0 };
+            std::atomic<uint64_t> nnzIn{ 0 };
+            std::atomic<uint64_t> nnzOut{ 0 };
+        };
+
+        struct TraceEvent {
+            uint32_t op;
+            uint64_t startNs;
+            uint64_t durationNs;
+            uint64_t flops;
+            uint64_t bytes;
+            uint64_t nnzIn;
+            uint64_t nnzOut;
+        };
+
+        struct Frame;
+
+        struct ThreadState {
+            uint64_t tid = 0;
+            Counters ops[kMaxOps];
+            Frame* top = nullptr;
+            std::mutex traceMutex;
+            std::vector<TraceEvent> events;
+            uint64_t dropped = 0;
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::string> names;
+            // Состояния потоков живут до конца программы: снимок видит и
+            // завершившиеся потоки
+            std::vector<std::unique_ptr<ThreadState>> threads;
+            std::atomic<bool> tracing{ false };
+            size_t traceLimit = size_t{ 1 } << 20;
+            std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        inline Registry& registry() {
+            static Registry r;
+            return r;
+        }
+
+        // Идентификатор операции по имени; одно имя - один счетчик для всех
+        // инстанцирований шаблона
+        inline uint32_t opId(const char* name) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (size_t i = 0; i < r.names.size(); ++i) {
+                if (r.names[i] == name) return static_cast<uint32_t>(i);
+            }
+            if (r.names.size() + 1 >= kMaxOps) {
+                // Переполнение таблицы - общий счетчик "(other)"
+                if (r.names.size() + 1 == kMaxOps) r.names.push_back("(other)");
+                return static_cast<uint32_t>(kMaxOps - 1);
+            }
+            r.names.push_back(name);
+            return static_cast<uint32_t>(r.names.size() - 1);
+        }
+
+        inline ThreadState* addThread() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.threads.push_back(std::make_unique<ThreadState>());
+            r.threads.back()->tid = std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000000;
+            return r.threads.back().get();
+        }
+
+        inline ThreadState& threadState() {
+            thread_local ThreadState* state = addThread();
+            return *state;
+        }
+
+        inline uint64_t nowNs() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - registry().epoch).count());
+        }
+
+        // Единственный писатель - поток-владелец, поэтому без fetch_add
+        inline void bump(std::atomic<uint64_t>& c, uint64_t v) {
+            c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+        }
+
+        // Кадр операции на стеке вызовов. Точечные операции (setElement)
+        // не замеряют время и не пишут трассу - только счетчики
+        struct Frame {
+            uint32_t id;
+            bool timed;
+            ThreadState& state;
+            Frame* parent;
+            uint64_t start = 0;
+            uint64_t childNs = 0;
+            uint64_t flops = 0;
+            uint64_t bytes = 0;
+            uint64_t allocations = 0;
+            uint64_t nnzIn = 0;
+            uint64_t nnzOut = 0;
+
+            Frame(uint32_t opId, bool isTimed)
+                : id(opId), timed(isTimed), state(threadState()), parent(state.top) {
+                state.top = this;
+                if (timed) start = nowNs();
+            }
+
+            Frame(const Frame&) = delete;
+            Frame& operator=(const Frame&) = delete;
+
+            void io(uint64_t in, uint64_t out, uint64_t entryBytes) {
+                nnzIn += in;
+                nnzOut += out;
+                bytes += (in + out) * entryBytes;
+            }
+
+            ~Frame() {
+                Counters& c = state.ops[id];
+                bump(c.calls, 1);
+                bump(c.flops, flops);
+                bump(c.bytes, bytes);
+                bump(c.allocations, allocations);
+                bump(c.nnzIn, nnzIn);
+                bump(c.nnzOut, nnzOut);
+                uint64_t elapsed = 0;
+                if (timed) {
+                    elapsed = nowNs() - start;
+                    bump(c.totalNs, elapsed);
+                    bump(c.selfNs, elapsed > childNs ? elapsed - childNs : 0);
+                    if (registry().tracing.load(std::memory_order_relaxed)) {
+                        std::lock_guard<std::mutex> lock(state.traceMutex);
+                        if (state.events.size() < registry().traceLimit) {
+                            state.events.push_back({ id, start, elapsed, flops, bytes, nnzIn, nnzOut });
+                        }
+                        else {
+                            ++state.dropped;
+                        }
+                    }
+                }
+                state.top = parent;
+                if (parent) {
+                    parent->childNs += elapsed;
+                    parent->flops += flops;
+                    parent->bytes += bytes;
+                    parent->allocations += allocations;
+                }
+            }
+        };
+
+        inline std::string escape(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+    }
+
+    inline Snapshot snapshot() {
+        detail::Registry& r = detail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        Snapshot snap;
+        for (size_t id = 0; id < r.names.size(); ++id) {
+            OpStats s;
+            s.name = r.names[id];
+            for (const auto& t : r.threads) {
+                const detail::Counters& c = t->ops[id];
+                s.calls += c.calls.load(std::memory_order_relaxed);
+                s.totalNs += c.totalNs.load(std::memory_order_relaxed);
+                s.selfNs += c.selfNs.load(std::memory_order_relaxed);
+                s.flops += c.flops.load(std::memory_order_relaxed);
+                s.bytes += c.bytes.load(std::memory_order_relaxed);
+                s.allocations += c.allocations.load(std::memory_order_relaxed);
+                s.nnzIn += c.nnzIn.load(std::memory_order_relaxed);
+                s.nnzOut += c.nnzOut.load(std::memory_order_relaxed);
+            }
+            if (s.calls > 0) snap.ops.push_back(s);
+        }
+        return snap;
+    }
+
+    // Обнуление счетчиков и трассы. Вызывать, когда инструментированные
+    // операции в других потоках не выполняются
+    inline void reset() {
+        detail::Registry& r = detail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& t : r.threads) {
+            for (auto& c : t->ops) {
+                c.calls = 0;
+                c.totalNs = 0;
+                c.selfNs = 0;
+                c.flops = 0;
+                c.bytes = 0;
+                c.allocations = 0;
+                c.nnzIn = 0;
+                c.nnzOut = 0;
+            }
+            std::lock_guard<std::mutex> traceLock(t->traceMutex);
+            t->events.clear();
+            t->dropped = 0;
+        }
+    }
+
+    // Запись событий трассы (по умолчанию выключена); limit - максимум
+    // событий на поток, лишние отбрасываются и считаются
+    inline void setTracing(bool on, size_t limit = size_t{ 1 } << 20) {
+        detail::Registry& r = detail::registry();
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.traceLimit = limit;
+        }
+        r.tracing.store(on, std::memory_order_relaxed);
+    }
+
+    inline void report(std::ostream& os) {
+        printSnapshot(snapshot(), os);
+    }
+
+    // Трасса в формате Chrome trace event: события "X" с длительностью,
+    // счетчики операции в args
+    inline void writeChromeTrace(std::ostream& os) {
+        detail::Registry& r = detail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        bool first = true;
+        uint64_t dropped = 0;
+        os << std::fixed << std::setprecision(3);
+        for (const auto& t : r.threads) {
+            std::lock_guard<std::mutex> traceLock(t->traceMutex);
+            dropped += t->dropped;
+            for (const auto& e : t->events) {
+                os << (first ? "\n" : ",\n") << "{\"name\": \"" << detail::escape(r.names[e.op])
+                    << "\", \"cat\": \"sparse\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << t->tid
+                    << ", \"ts\": " << static_cast<double>(e.startNs) / 1e3
+                    << ", \"dur\": " << static_cast<double>(e.durationNs) / 1e3
+                    << ", \"args\": {\"flops\": " << e.flops << ", \"bytes\": " << e.bytes
+                    << ", \"nnz_in\": " << e.nnzIn << ", \"nnz_out\": " << e.nnzOut << "}}";
+                first = false;
+            }
+        }
+        os << std::defaultfloat;
+        os << "\n], \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+    }
+
+#define SPARSE_PROFILE_CAT_(a, b) a##b
+#define SPARSE_PROFILE_CAT(a, b) SPARSE_PROFILE_CAT_(a, b)
+
+    // Операция с замером времени (до конца текущего блока)
+#define SPARSE_PROFILE_SCOPE(name) \
+    static const uint32_t SPARSE_PROFILE_CAT(spProfId_, __LINE__) = ::profiler::detail::opId(name); \
+    ::profiler::detail::Frame spProfFrame_(SPARSE_PROFILE_CAT(spProfId_, __LINE__), true)
+
+    // Точечная операция: только счетчики, без времени
+#define SPARSE_PROFILE_POINT(name) \
+    static const uint32_t SPARSE_PROFILE_CAT(spProfId_, __LINE__) = ::profiler::detail::opId(name); \
+    ::profiler::detail::Frame spProfFrame_(SPARSE_PROFILE_CAT(spProfId_, __LINE__), false)
+
+    // Счетчики текущей операции (в той же функции, что SCOPE/POINT)
+#define SPARSE_PROFILE_FLOPS(n) (spProfFrame_.flops += static_cast<uint64_t>(n))
+#define SPARSE_PROFILE_ALLOC(n) (spProfFrame_.allocations += static_cast<uint64_t>(n))
+#define SPARSE_PROFILE_IO(nnzIn, nnzOut, entryBytes) \
+    spProfFrame_.io(static_cast<uint64_t>(nnzIn), static_cast<uint64_t>(nnzOut), static_cast<uint64_t>(entryBytes))
+
+#else
+
+    constexpr bool enabled = false;
+
+    inline Snapshot snapshot() { return {}; }
+    inline void reset() {}
+    inline void setTracing(bool, size_t = 0) {}
+
+    inline void report(std::ostream& os) {
+        os << "Profiling disabled (build with -DSPARSE_PROFILING).\n";
+    }
+
+    inline void writeChromeTrace(std::ostream& os) {
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": []}\n";
+    }
+
+#define SPARSE_PROFILE_SCOPE(name) ((void)0)
+#define SPARSE_PROFILE_POINT(name) ((void)0)
+#define SPARSE_PROFILE_FLOPS(n) ((void)0)
+#define SPARSE_PROFILE_ALLOC(n) ((void)0)
+#define SPARSE_PROFILE_IO(nnzIn, nnzOut, entryBytes) ((void)0)
+
+#endif
+
+}
@@ -0,0 +1,546 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <set>
+#include <ostream>
+#include "myMatrix.hpp"
+#include "myVector.hpp"
+
+// Переупорядочивание строк и столбцов для локальности данных.
+// Перестановка задается как perm[новый индекс] = старый индекс.
+
+// Граф смежности симметризованного шаблона A + A^T без петель (CSR)
+struct AdjacencyGraph {
+    size_t n = 0;
+    std::vector<size_t> xadj{ 0 };
+    std::vector<size_t> adjncy;
+
+    size_t degree(size_t v) const { return xadj[v + 1] - xadj[v]; }
+};
+
+template <typename T>
+AdjacencyGraph buildAdjacencyGraph(const SparseMatrix<T>& mat) {
+    if (!mat.isSquare()) {
+        throw std::invalid_argument("Matrix must be square to build its graph.");
+    }
+    AdjacencyGraph g;
+    g.n = mat.rows();
+    std::vector<std::vector<size_t>> adj(g.n);
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        size_t i = it->first.first;
+        size_t j = it->first.second;
+        if (i != j) {
+            adj[i].push_back(j);
+            adj[j].push_back(i);
+        }
+    }
+    g.xadj.assign(g.n + 1, 0);
+    for (size_t v = 0; v < g.n; ++v) {
+        std::sort(adj[v].begin(), adj[v].end());
+        adj[v].erase(std::unique(adj[v].begin(), adj[v].end()), adj[v].end());
+        g.xadj[v + 1] = g.xadj[v] + adj[v].size();
+    }
+    g.adjncy.reserve(g.xadj[g.n]);
+    for (size_t v = 0; v < g.n; ++v) {
+        g.adjncy.insert(g.adjncy.end(), adj[v].begin(), adj[v].end());
+    }
+    return g;
+}
+
+// Обратная перестановка: inv[старый индекс] = новый индекс
+inline std::vector<size_t> invertPermutation(const std::vector<size_t>& perm) {
+    std::vector<size_t> inv(perm.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+        inv[perm[i]] = i;
+    }
+    return inv;
+}
+
+namespace reorder_detail {
+
+    // Поиск в ширину внутри компоненты; возвращает уровни (SIZE_MAX - не достигнут)
+    inline size_t bfsLevels(const AdjacencyGraph& g, size_t root, const std::vector<char>& allowed,
+        std::vector<size_t>& level, std::vector<size_t>& order) {
+        order.clear();
+        order.push_back(root);
+        level[root] = 0;
+        size_t depth = 0;
+        for (size_t head = 0; head < order.size(); ++head) {
+            size_t v = order[head];
+            for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                size_t u = g.adjncy[k];
+                if (allowed[u] && level[u] == SIZE_MAX) {
+                    level[u] = level[v] + 1;
+                    depth = std::max(depth, level[u]);
+                    order.push_back(u);
+                }
+            }
+        }
+        return depth;
+    }
+
+    // Псевдопериферийная вершина (алгоритм Джорджа-Лю): повторяем BFS
+    // из вершины последнего уровня с минимальной степенью, пока растет глубина.
+    // level (размера g.n, все SIZE_MAX) и order - буферы вызывающего, общие
+    // для всех компонент; на выходе level снова весь SIZE_MAX
+    inline size_t pseudoPeripheral(const AdjacencyGraph& g, size_t start, const std::vector<char>& allowed,
+        std::vector<size_t>& level, std::vector<size_t>& order) {
+        size_t root = start;
+        size_t depth = bfsLevels(g, root, allowed, level, order);
+        for (;;) {
+            size_t best = root;
+            size_t bestDeg = SIZE_MAX;
+            for (size_t v : order) {
+                if (level[v] == depth && g.degree(v) < bestDeg) {
+                    best = v;
+                    bestDeg = g.degree(v);
+                }
+            }
+            for (size_t v : order) level[v] = SIZE_MAX;
+            size_t newDepth = bfsLevels(g, best, allowed, level, order);
+            if (newDepth <= depth) {
+                for (size_t v : order) level[v] = SIZE_MAX;
+                return root;
+            }
+            root = best;
+            depth = newDepth;
+        }
+    }
+
+}
+
+// Обратный алгоритм Катхилла-Макки: уменьшает ширину ленты
+template <typename T>
+std::vector<size_t> reverseCuthillMcKee(const SparseMatrix<T>& mat) {
+    AdjacencyGraph g = buildAdjacencyGraph(mat);
+    std::vector<size_t> perm;
+    perm.reserve(g.n);
+    std::vector<char> visited(g.n, 0);
+    std::vector<char> allowed(g.n, 1);
+    std::vector<size_t> neighbors;
+    std::vector<size_t> level(g.n, SIZE_MAX);
+    std::vector<size_t> order;
+
+    for (size_t s = 0; s < g.n; ++s) {
+        if (visited[s]) continue;
+        // Каждая компонента связности начинается с псевдопериферийной вершины
+        size_t root = reorder_detail::pseudoPeripheral(g, s, allowed, level, order);
+        size_t head = perm.size();
+        perm.push_back(root);
+        visited[root] = 1;
+        for (; head < perm.size(); ++head) {
+            size_t v = perm[head];
+            neighbors.clear();
+            for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                size_t u = g.adjncy[k];
+                if (!visited[u]) {
+                    visited[u] = 1;
+                    neighbors.push_back(u);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), [&](size_t a, size_t b) {
+                return g.degree(a) < g.degree(b);
+                });
+            perm.insert(perm.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(perm.begin(), perm.end());
+    return perm;
+}
+
+// Приближенный минимальный порядок степеней (AMD) на фактор-графе:
+// исключенные вершины становятся элементами, степени оцениваются сверху
+// по формуле Аместо-Дэвиса-Даффа без явного построения графа исключения
+template <typename T>
+std::vector<size_t> approximateMinimumDegree(const SparseMatrix<T>& mat) {
+    AdjacencyGraph g = buildAdjacencyGraph(mat);
+    const size_t n = g.n;
+    std::vector<std::vector<size_t>> adj(n), elems(n), Le(n);
+    std::vector<size_t> degree(n);
+    std::vector<char> eliminated(n, 0), absorbed(n, 0);
+    std::set<std::pair<size_t, size_t>> queue;
+    for (size_t v = 0; v < n; ++v) {
+        adj[v].assign(g.adjncy.begin() + g.xadj[v], g.adjncy.begin() + g.xadj[v + 1]);
+        degree[v] = adj[v].size();
+        queue.insert({ degree[v], v });
+    }
+
+    std::vector<size_t> perm;
+    perm.reserve(n);
+    std::vector<size_t> inLp(n, SIZE_MAX);
+    std::vector<long long> w(n, -1);
+    std::vector<size_t> touched;
+
+    for (size_t k = 0; k < n; ++k) {
+        size_t p = queue.begin()->second;
+        queue.erase(queue.begin());
+        perm.push_back(p);
+        eliminated[p] = 1;
+
+        // Новый элемент Lp = (A_p U объединение L_e по e из E_p) \ {p}
+        std::vector<size_t> Lp;
+        inLp[p] = p;
+        for (size_t u : adj[p]) {
+            if (!eliminated[u] && inLp[u] != p) {
+                inLp[u] = p;
+                Lp.push_back(u);
+            }
+        }
+        for (size_t e : elems[p]) {
+            if (absorbed[e]) continue;
+            for (size_t u : Le[e]) {
+                if (!eliminated[u] && inLp[u] != p) {
+                    inLp[u] = p;
+                    Lp.push_back(u);
+                }
+            }
+            absorbed[e] = 1;
+            Le[e].clear();
+            Le[e].shrink_to_fit();
+        }
+        adj[p].clear();
+        elems[p].clear();
+
+        // w(e) = |L_e \ Lp| для элементов, смежных с Lp
+        touched.clear();
+        for (size_t i : Lp) {
+            for (size_t e : elems[i]) {
+                if (absorbed[e]) continue;
+                if (w[e] < 0) {
+                    w[e] = static_cast<long long>(Le[e].size());
+                    touched.push_back(e);
+                }
+                --w[e];
+            }
+        }
+
+        size_t remaining = n - k - 1;
+        for (size_t i : Lp) {
+            // Переменные из Lp теперь достижимы через элемент p
+            adj[i].erase(std::remove_if(adj[i].begin(), adj[i].end(), [&](size_t u) {
+                return eliminated[u] || inLp[u] == p;
+                }), adj[i].end());
+            elems[i].erase(std::remove_if(elems[i].begin(), elems[i].end(), [&](size_t e) {
+                return absorbed[e];
+                }), elems[i].end());
+
+            size_t bound = adj[i].size() + (Lp.size() - 1);
+            for (size_t e : elems[i]) {
+                bound += static_cast<size_t>(std::max<long long>(0, w[e]));
+            }
+            elems[i].push_back(p);
+
+            size_t d = std::min({ remaining, degree[i] + Lp.size() - 1, bound });
+            queue.erase({ degree[i], i });
+            degree[i] = d;
+            queue.insert({ degree[i], i });
+        }
+        for (size_t e : touched) w[e] = -1;
+        Le[p] = std::move(Lp);
+    }
+    return perm;
+}
+
+namespace reorder_detail {
+
+    // Взвешенный граф для многоуровневого разбиения
+    struct WeightedGraph {
+        std::vector<size_t> xadj{ 0 };
+        std::vector<size_t> adjncy;
+        std::vector<size_t> ewgt;
+        std::vector<size_t> vwgt;
+
+        size_t size() const { return vwgt.size(); }
+    };
+
+    // Огрубление сопоставлением по самым тяжелым ребрам
+    inline WeightedGraph coarsen(const WeightedGraph& g, std::vector<size_t>& cmap) {
+        size_t n = g.size();
+        std::vector<size_t> match(n, SIZE_MAX);
+        cmap.assign(n, SIZE_MAX);
+        size_t nc = 0;
+        for (size_t v = 0; v < n; ++v) {
+            if (match[v] != SIZE_MAX) continue;
+            size_t best = v;
+            size_t bestW = 0;
+            for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                size_t u = g.adjncy[k];
+                if (match[u] == SIZE_MAX && u != v && g.ewgt[k] > bestW) {
+                    best = u;
+                    bestW = g.ewgt[k];
+                }
+            }
+            match[v] = best;
+            match[best] = v;
+            cmap[v] = nc;
+            cmap[best] = nc;
+            ++nc;
+        }
+
+        WeightedGraph c;
+        c.vwgt.assign(nc, 0);
+        std::vector<size_t> slot(nc, SIZE_MAX);
+        std::vector<size_t> rowAdj;
+        std::vector<size_t> rowW;
+        std::vector<char> done(n, 0);
+        c.xadj.assign(1, 0);
+        for (size_t cv = 0, v = 0; v < n; ++v) {
+            if (done[v]) continue;
+            size_t pair[2] = { v, match[v] };
+            rowAdj.clear();
+            rowW.clear();
+            for (size_t t = 0; t < (pair[0] == pair[1] ? 1u : 2u); ++t) {
+                size_t x = pair[t];
+                done[x] = 1;
+                c.vwgt[cv] += g.vwgt[x];
+                for (size_t k = g.xadj[x]; k < g.xadj[x + 1]; ++k) {
+                    size_t cu = cmap[g.adjncy[k]];
+                    if (cu == cv) continue;
+                    if (slot[cu] == SIZE_MAX) {
+                        slot[cu] = rowAdj.size();
+                        rowAdj.push_back(cu);
+                        rowW.push_back(0);
+                    }
+                    rowW[slot[cu]] += g.ewgt[k];
+                }
+            }
+            for (size_t t = 0; t < rowAdj.size(); ++t) {
+                slot[rowAdj[t]] = SIZE_MAX;
+                c.adjncy.push_back(rowAdj[t]);
+                c.ewgt.push_back(rowW[t]);
+            }
+            c.xadj.push_back(c.adjncy.size());
+            ++cv;
+        }
+        return c;
+    }
+
+    // Начальное разбиение выращиванием области BFS до половины веса
+    inline std::vector<char> growBisection(const WeightedGraph& g) {
+        size_t n = g.size();
+        size_t total = std::accumulate(g.vwgt.begin(), g.vwgt.end(), size_t{ 0 });
+        std::vector<char> part(n, 1);
+        std::vector<char> seen(n, 0);
+        std::vector<size_t> queue;
+        size_t weight = 0;
+        for (size_t s = 0; s < n && 2 * weight < total; ++s) {
+            if (seen[s]) continue;
+            queue.assign(1, s);
+            seen[s] = 1;
+            for (size_t head = 0; head < queue.size() && 2 * weight < total; ++head) {
+                size_t v = queue[head];
+                part[v] = 0;
+                weight += g.vwgt[v];
+                for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                    size_t u = g.adjncy[k];
+                    if (!seen[u]) {
+                        seen[u] = 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }
+        return part;
+    }
+
+    // Жадное улучшение границы: переносим вершины с положительным выигрышем,
+    // пока дисбаланс не превышает 5%
+    inline void refine(const WeightedGraph& g, std::vector<char>& part, int passes = 4) {
+        size_t n = g.size();
+        size_t total = std::accumulate(g.vwgt.begin(), g.vwgt.end(), size_t{ 0 });
+        size_t w[2] = { 0, 0 };
+        for (size_t v = 0; v < n; ++v) w[static_cast<size_t>(part[v])] += g.vwgt[v];
+        size_t limit = total / 2 + total / 20 + 1;
+        for (int pass = 0; pass < passes; ++pass) {
+            bool moved = false;
+            for (size_t v = 0; v < n; ++v) {
+                long long internal = 0, external = 0;
+                for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                    if (part[g.adjncy[k]] == part[v]) internal += static_cast<long long>(g.ewgt[k]);
+                    else external += static_cast<long long>(g.ewgt[k]);
+                }
+                size_t to = 1 - static_cast<size_t>(part[v]);
+                if (external > internal && w[to] + g.vwgt[v] <= limit) {
+                    w[1 - to] -= g.vwgt[v];
+                    w[to] += g.vwgt[v];
+                    part[v] = static_cast<char>(to);
+                    moved = true;
+                }
+            }
+            if (!moved) break;
+        }
+    }
+
+    // Многоуровневое разбиение: огрубление, разбиение, проекция с улучшением
+    inline std::vector<char> multilevelBisect(const WeightedGraph& g) {
+        const size_t coarsestSize = 64;
+        if (g.size() <= coarsestSize) {
+            std::vector<char> part = growBisection(g);
+            refine(g, part);
+            return part;
+        }
+        std::vector<size_t> cmap;
+        WeightedGraph c = coarsen(g, cmap);
+        std::vector<char> part(g.size());
+        if (c.size() * 10 > g.size() * 9) {
+            // Огрубление почти не сокращает граф - разбиваем на этом уровне
+            part = growBisection(g);
+        }
+        else {
+            std::vector<char> cpart = multilevelBisect(c);
+            for (size_t v = 0; v < g.size(); ++v) part[v] = cpart[cmap[v]];
+        }
+        refine(g, part);
+        return part;
+    }
+
+    // Подграф на заданных вершинах
+    inline WeightedGraph subgraph(const AdjacencyGraph& g, const std::vector<size_t>& verts,
+        std::vector<size_t>& local) {
+        WeightedGraph s;
+        for (size_t i = 0; i < verts.size(); ++i) local[verts[i]] = i;
+        for (size_t v : verts) {
+            for (size_t k = g.xadj[v]; k < g.xadj[v + 1]; ++k) {
+                size_t u = g.adjncy[k];
+                if (local[u] != SIZE_MAX) {
+                    s.adjncy.push_back(local[u]);
+                    s.ewgt.push_back(1);
+                }
+            }
+            s.xadj.push_back(s.adjncy.size());
+            s.vwgt.push_back(1);
+        }
+        for (size_t v : verts) local[v] = SIZE_MAX;
+        return s;
+    }
+
+    inline void bisectRecursive(const AdjacencyGraph& g, std::vector<size_t>& verts,
+        size_t leafSize, std::vector<size_t>& local, std::vector<size_t>& perm) {
+        if (verts.size() <= leafSize) {
+            perm.insert(perm.end(), verts.begin(), verts.end());
+            return;
+        }
+        WeightedGraph s = subgraph(g, verts, local);
+        std::vector<char> part = multilevelBisect(s);
+        std::vector<size_t> left, right;
+        for (size_t i = 0; i < verts.size(); ++i) {
+            (part[i] == 0 ? left : right).push_back(verts[i]);
+        }
+        if (left.empty() || right.empty()) {
+            perm.insert(perm.end(), verts.begin(), verts.end());
+            return;
+        }
+        verts.clear();
+        verts.shrink_to_fit();
+        bisectRecursive(g, left, leafSize, local, perm);
+        bisectRecursive(g, right, leafSize, local, perm);
+    }
+
+}
+
+// Многоуровневая рекурсивная бисекция: сильно связанные вершины
+// оказываются в одном блоке и получают соседние номера
+template <typename T>
+std::vector<size_t> multilevelBisectionOrdering(const SparseMatrix<T>& mat, size_t leafSize = 64) {
+    AdjacencyGraph g = buildAdjacencyGraph(mat);
+    std::vector<size_t> verts(g.n);
+    std::iota(verts.begin(), verts.end(), size_t{ 0 });
+    std::vector<size_t> local(g.n, SIZE_MAX);
+    std::vector<size_t> perm;
+    perm.reserve(g.n);
+    reorder_detail::bisectRecursive(g, verts, std::max<size_t>(leafSize, 2), local, perm);
+    return perm;
+}
+
+// P * A * Q^T за один проход разброса: каждый элемент сразу попадает в
+// корзину своей новой строки, затем строки сортируются по столбцам
+template <typename T>
+SparseMatrix<T> permute(const SparseMatrix<T>& mat, const std::vector<size_t>& rowPerm,
+    const std::vector<size_t>& colPerm) {
+    if (rowPerm.size() != mat.rows() || colPerm.size() != mat.cols()) {
+        throw std::invalid_argument("Permutation size does not match matrix dimensions.");
+    }
+    std::vector<size_t> rowInv = invertPermutation(rowPerm);
+    std::vector<size_t> colInv = invertPermutation(colPerm);
+
+    std::vector<size_t> rowPtr(mat.rows() + 1, 0);
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        ++rowPtr[rowInv[it->first.first] + 1];
+    }
+    for (size_t i = 0; i < mat.rows(); ++i) {
+        rowPtr[i + 1] += rowPtr[i];
+    }
+    std::vector<std::pair<size_t, T>> entries(mat.size());
+    std::vector<size_t> next(rowPtr.begin(), rowPtr.end() - 1);
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        entries[next[rowInv[it->first.first]]++] = { colInv[it->first.second], it->second };
+    }
+
+    SparseMatrix<T> result(mat.rows(), mat.cols());
+    result.reserve(mat.size());
+    for (size_t i = 0; i < mat.rows(); ++i) {
+        auto first = entries.begin() + rowPtr[i];
+        auto last = entries.begin() + rowPtr[i + 1];
+        std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = first; it != last; ++it) {
+            result.appendElement(i, it->first, it->second);
+        }
+    }
+    return result;
+}
+
+// Симметричная перестановка P * A * P^T
+template <typename T>
+SparseMatrix<T> permute(const SparseMatrix<T>& mat, const std::vector<size_t>& perm) {
+    return permute(mat, perm, perm);
+}
+
+template <typename T>
+SparseVector<T> permute(const SparseVector<T>& vec, const std::vector<size_t>& perm) {
+    if (perm.size() != vec.dimension()) {
+        throw std::invalid_argument("Permutation size does not match vector dimension.");
+    }
+    std::vector<size_t> inv = invertPermutation(perm);
+    SparseVector<T> result(perm.size());
+    for (auto it = vec.cbegin(); it != vec.cend(); ++it) {
+        result.setElement(inv[it->first], it->second);
+    }
+    return result;
+}
+
+// Метрики локальности: ширина ленты, профиль (оболочка) и средняя
+// удаленность элемента от диагонали
+struct BandwidthMetrics {
+    size_t bandwidth = 0;
+    size_t profile = 0;
+    double averageDistance = 0.0;
+};
+
+template <typename T>
+BandwidthMetrics bandwidthMetrics(const SparseMatrix<T>& mat) {
+    BandwidthMetrics m;
+    std::vector<size_t> firstCol(mat.rows(), SIZE_MAX);
+    double total = 0.0;
+    for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+        size_t i = it->first.first;
+        size_t j = it->first.second;
+        size_t dist = i > j ? i - j : j - i;
+        m.bandwidth = std::max(m.bandwidth, dist);
+        total += static_cast<double>(dist);
+        firstCol[i] = std::min(firstCol[i], j);
+    }
+    for (size_t i = 0; i < mat.rows(); ++i) {
+        if (firstCol[i] < i) m.profile += i - firstCol[i];
+    }
+    m.averageDistance = mat.size() ? total / static_cast<double>(mat.size()) : 0.0;
+    return m;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const BandwidthMetrics& m) {
+    return os << "bandwidth = " << m.bandwidth << ", profile = " << m.profile
+        << ", average distance = " << m.averageDistance;
+}
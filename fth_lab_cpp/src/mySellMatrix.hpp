@@ -0,0 +1,221 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <type_traits>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "myMatrix.hpp"
+
+// SELL-C-sigma (sliced ELLPACK): строки группируются в чанки по C штук,
+// внутри окна из sigma строк сортируются по убыванию длины, чтобы строки
+// одного чанка были близки по длине. Чанк хранится по столбцам: j-е элементы
+// всех C строк лежат подряд, поэтому одна SIMD-инструкция обрабатывает
+// сразу несколько строк. Короткие строки дополняются нулями.
+//
+// Векторное ядро для double включается при сборке с -mavx2 или -mavx512f
+// (например, -march=native) и C, кратном ширине регистра.
+template <typename T>
+class SellMatrix {
+public:
+    SellMatrix(const SparseMatrix<T>& mat, size_t chunkHeight = 8, size_t sigma = 256)
+        : rows_(mat.rows()), cols_(mat.cols()), C_(chunkHeight), sigma_(sigma), nnz_(mat.size()) {
+        if (C_ == 0 || sigma_ == 0) {
+            throw std::invalid_argument("Chunk height and sigma must be positive.");
+        }
+
+        // Длины строк и начало каждой строки в упорядоченных данных
+        std::vector<size_t> rowLen(rows_, 0);
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            ++rowLen[it->first.first];
+        }
+        std::vector<size_t> rowStart(rows_ + 1, 0);
+        for (size_t i = 0; i < rows_; ++i) {
+            rowStart[i + 1] = rowStart[i] + rowLen[i];
+        }
+        std::vector<size_t> cols;
+        std::vector<T> vals;
+        cols.reserve(nnz_);
+        vals.reserve(nnz_);
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            cols.push_back(it->first.second);
+            vals.push_back(it->second);
+        }
+
+        // Сортировка по длине внутри окон sigma
+        size_t numChunks = (rows_ + C_ - 1) / C_;
+        perm_.assign(numChunks * C_, SIZE_MAX);
+        std::iota(perm_.begin(), perm_.begin() + rows_, size_t{ 0 });
+        for (size_t w = 0; w < rows_; w += sigma_) {
+            auto first = perm_.begin() + w;
+            auto last = perm_.begin() + std::min(rows_, w + sigma_);
+            std::stable_sort(first, last, [&](size_t a, size_t b) {
+                return rowLen[a] > rowLen[b];
+                });
+        }
+
+        // Ширина чанка - длина его самой длинной строки
+        chunkPtr_.assign(numChunks + 1, 0);
+        chunkWidth_.assign(numChunks, 0);
+        for (size_t c = 0; c < numChunks; ++c) {
+            size_t width = 0;
+            for (size_t r = 0; r < C_; ++r) {
+                size_t row = perm_[c * C_ + r];
+                if (row != SIZE_MAX) width = std::max(width, rowLen[row]);
+            }
+            chunkWidth_[c] = width;
+            chunkPtr_[c + 1] = chunkPtr_[c] + width * C_;
+        }
+
+        colIdx_.assign(chunkPtr_[numChunks], 0);
+        values_.assign(chunkPtr_[numChunks], T{});
+        for (size_t c = 0; c < numChunks; ++c) {
+            for (size_t r = 0; r < C_; ++r) {
+                size_t row = perm_[c * C_ + r];
+                if (row == SIZE_MAX) continue;
+                for (size_t j = 0; j < rowLen[row]; ++j) {
+                    size_t pos = chunkPtr_[c] + j * C_ + r;
+                    colIdx_[pos] = cols[rowStart[row] + j];
+                    values_[pos] = vals[rowStart[row] + j];
+                }
+            }
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return nnz_; }
+    size_t chunkHeight() const { return C_; }
+    size_t sigma() const { return sigma_; }
+
+    // Доля полезных элементов среди хранимых (1.0 - без дополнения)
+    double fillEfficiency() const {
+        return values_.empty() ? 1.0 : static_cast<double>(nnz_) / static_cast<double>(values_.size());
+    }
+
+    void spmv(const std::vector<T>& x, std::vector<T>& y) const {
+        if (x.size() != cols_) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        y.assign(rows_, T{});
+        if (values_.empty()) return;
+        spmvKernel(x.data(), y.data());
+    }
+
+    std::vector<T> operator*(const std::vector<T>& x) const {
+        std::vector<T> y;
+        spmv(x, y);
+        return y;
+    }
+
+private:
+    size_t rows_;
+    size_t cols_;
+    size_t C_;
+    size_t sigma_;
+    size_t nnz_;
+    std::vector<size_t> perm_;        // позиция в SELL -> исходная строка
+    std::vector<size_t> chunkPtr_;
+    std::vector<size_t> chunkWidth_;
+    std::vector<size_t> colIdx_;
+    std::vector<T> values_;
+
+    void spmvKernel(const T* x, T* y) const {
+#if defined(__AVX512F__)
+        if constexpr (std::is_same_v<T, double> && sizeof(size_t) == 8) {
+            if (C_ % 8 == 0) {
+                spmvAvx512(x, y);
+                return;
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (std::is_same_v<T, double> && sizeof(size_t) == 8) {
+            if (C_ % 4 == 0) {
+                spmvAvx2(x, y);
+                return;
+            }
+        }
+#endif
+        spmvScalar(x, y);
+    }
+
+    // Переносимая версия: внутренний цикл по C строкам чанка
+    void spmvScalar(const T* x, T* y) const {
+        std::vector<T> acc(C_);
+        for (size_t c = 0; c + 1 < chunkPtr_.size(); ++c) {
+            std::fill(acc.begin(), acc.end(), T{});
+            const size_t* col = colIdx_.data() + chunkPtr_[c];
+            const T* val = values_.data() + chunkPtr_[c];
+            for (size_t j = 0; j < chunkWidth_[c]; ++j) {
+                for (size_t r = 0; r < C_; ++r) {
+                    acc[r] += val[j * C_ + r] * x[col[j * C_ + r]];
+                }
+            }
+            storeChunk(c, acc.data(), y);
+        }
+    }
+
+    void storeChunk(size_t c, const T* acc, T* y) const {
+        for (size_t r = 0; r < C_; ++r) {
+            size_t row = perm_[c * C_ + r];
+            if (row != SIZE_MAX) y[row] = acc[r];
+        }
+    }
+
+#if defined(__AVX2__)
+    void spmvAvx2(const double* x, double* y) const {
+        alignas(32) double acc[4];
+        std::vector<double> chunkAcc(C_);
+        for (size_t c = 0; c + 1 < chunkPtr_.size(); ++c) {
+            const size_t* col = colIdx_.data() + chunkPtr_[c];
+            const double* val = values_.data() + chunkPtr_[c];
+            for (size_t g = 0; g < C_; g += 4) {
+                __m256d sum = _mm256_setzero_pd();
+                for (size_t j = 0; j < chunkWidth_[c]; ++j) {
+                    size_t off = j * C_ + g;
+                    __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + off));
+                    __m256d v = _mm256_loadu_pd(val + off);
+                    __m256d xv = _mm256_i64gather_pd(x, idx, 8);
+#if defined(__FMA__)
+                    sum = _mm256_fmadd_pd(v, xv, sum);
+#else
+                    sum = _mm256_add_pd(sum, _mm256_mul_pd(v, xv));
+#endif
+                }
+                _mm256_store_pd(acc, sum);
+                std::copy(acc, acc + 4, chunkAcc.begin() + g);
+            }
+            storeChunk(c, chunkAcc.data(), y);
+        }
+    }
+#endif
+
+#if defined(__AVX512F__)
+    void spmvAvx512(const double* x, double* y) const {
+        alignas(64) double acc[8];
+        std::vector<double> chunkAcc(C_);
+        for (size_t c = 0; c + 1 < chunkPtr_.size(); ++c) {
+            const size_t* col = colIdx_.data() + chunkPtr_[c];
+            const double* val = values_.data() + chunkPtr_[c];
+            for (size_t g = 0; g < C_; g += 8) {
+                __m512d sum = _mm512_setzero_pd();
+                for (size_t j = 0; j < chunkWidth_[c]; ++j) {
+                    size_t off = j * C_ + g;
+                    __m512i idx = _mm512_loadu_si512(col + off);
+                    __m512d v = _mm512_loadu_pd(val + off);
+                    __m512d xv = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, idx, x, 8);
+                    sum = _mm512_fmadd_pd(v, xv, sum);
+                }
+                _mm512_store_pd(acc, sum);
+                std::copy(acc, acc + 8, chunkAcc.begin() + g);
+            }
+            storeChunk(c, chunkAcc.data(), y);
+        }
+    }
+#endif
+};
@@ -0,0 +1,353 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include "myVector.hpp"
+#include "myMatrix.hpp"
+
+// Ленивое представление "разреженный вектор + константа": x = v + c * 1.
+// Хранит только ненулевые элементы v и сдвиг c, память O(nnz).
+template <typename T>
+class ShiftedSparseVector {
+public:
+    ShiftedSparseVector() = default;
+
+    ShiftedSparseVector(const SparseVector<T>& base, const T& shift)
+        : base_(base), shift_(shift), dim_(base.dimension()) {}
+
+    ShiftedSparseVector(const SparseVector<T>& base, const T& shift, size_t dim)
+        : base_(base), shift_(shift), dim_(std::max(dim, base.dimension())) {}
+
+    // Доступ по индексу
+    T operator[](size_t idx) const {
+        return base_[idx] + shift_;
+    }
+
+    const SparseVector<T>& base() const { return base_; }
+    T shift() const { return shift_; }
+    size_t dimension() const { return dim_; }
+
+    // Сумма всех элементов: sum(v) + c * n
+    T sum() const {
+        return base_.sum() + shift_ * static_cast<T>(dim_);
+    }
+
+    ShiftedSparseVector operator-() const {
+        return ShiftedSparseVector(-base_, -shift_, dim_);
+    }
+
+    // Операции со скаляром меняют только сдвиг (или масштабируют обе части)
+    ShiftedSparseVector operator+(const T& scalar) const {
+        return ShiftedSparseVector(base_, shift_ + scalar, dim_);
+    }
+
+    ShiftedSparseVector operator-(const T& scalar) const {
+        return ShiftedSparseVector(base_, shift_ - scalar, dim_);
+    }
+
+    ShiftedSparseVector operator*(const T& scalar) const {
+        return ShiftedSparseVector(base_ * scalar, shift_ * scalar, dim_);
+    }
+
+    ShiftedSparseVector operator/(const T& scalar) const {
+        if (scalar == T{}) {
+            throw std::invalid_argument("Division by zero");
+        }
+        return ShiftedSparseVector(base_ / scalar, shift_ / scalar, dim_);
+    }
+
+    ShiftedSparseVector operator+(const ShiftedSparseVector& other) const {
+        checkDimensions(other);
+        return ShiftedSparseVector(base_ + other.base_, shift_ + other.shift_, dim_);
+    }
+
+    ShiftedSparseVector operator-(const ShiftedSparseVector& other) const {
+        checkDimensions(other);
+        return ShiftedSparseVector(base_ - other.base_, shift_ - other.shift_, dim_);
+    }
+
+    // Скалярное произведение:
+    // (u + a*1) . (v + b*1) = u.v + b*sum(u) + a*sum(v) + a*b*n
+    T dot(const ShiftedSparseVector& other) const {
+        checkDimensions(other);
+        return base_.dot(other.base_) + other.shift_ * base_.sum()
+            + shift_ * other.base_.sum() + shift_ * other.shift_ * static_cast<T>(dim_);
+    }
+
+    // (u + a*1) . v = u.v + a*sum(v)
+    T dot(const SparseVector<T>& other) const {
+        return base_.dot(other) + shift_ * other.sum();
+    }
+
+    // Поэлементное произведение:
+    // (u + a) * (v + b) = (u*v + b*u + a*v) + a*b
+    ShiftedSparseVector cwiseProduct(const ShiftedSparseVector& other) const {
+        checkDimensions(other);
+        SparseVector<T> result(dim_);
+        auto it = base_.cbegin();
+        auto jt = other.base_.cbegin();
+        while (it != base_.cend() || jt != other.base_.cend()) {
+            size_t idx;
+            T u = T{};
+            T v = T{};
+            if (jt == other.base_.cend() || (it != base_.cend() && it->first < jt->first)) {
+                idx = it->first;
+                u = it->second;
+                ++it;
+            }
+            else if (it == base_.cend() || jt->first < it->first) {
+                idx = jt->first;
+                v = jt->second;
+                ++jt;
+            }
+            else {
+                idx = it->first;
+                u = it->second;
+                v = jt->second;
+                ++it;
+                ++jt;
+            }
+            result.setElement(idx, u * v + other.shift_ * u + shift_ * v);
+        }
+        return ShiftedSparseVector(result, shift_ * other.shift_, dim_);
+    }
+
+    // Нормы считаются по хранимым элементам плюс (n - nnz) копий сдвига
+    T norm1() const {
+        T result = std::abs(shift_) * static_cast<T>(dim_ - base_.size());
+        for (auto it = base_.cbegin(); it != base_.cend(); ++it) {
+            result += std::abs(it->second + shift_);
+        }
+        return result;
+    }
+
+    double norm2() const {
+        double c = static_cast<double>(shift_);
+        double result = c * c * static_cast<double>(dim_ - base_.size());
+        for (auto it = base_.cbegin(); it != base_.cend(); ++it) {
+            double val = static_cast<double>(it->second + shift_);
+            result += val * val;
+        }
+        return std::sqrt(result);
+    }
+
+    T normInf() const {
+        T result = (base_.size() < dim_) ? std::abs(shift_) : T{};
+        for (auto it = base_.cbegin(); it != base_.cend(); ++it) {
+            result = std::max(result, static_cast<T>(std::abs(it->second + shift_)));
+        }
+        return result;
+    }
+
+    // Явное уплотнение (O(n) элементов) - только для отладки и малых размеров
+    SparseVector<T> materialize() const {
+        SparseVector<T> result(dim_);
+        for (size_t i = 0; i < dim_; ++i) {
+            result.setElement(i, (*this)[i]);
+        }
+        return result;
+    }
+
+    bool operator==(const ShiftedSparseVector& other) const {
+        if (dim_ != other.dim_) return false;
+        // Разность должна быть нулевой на объединении шаблонов и вне его
+        ShiftedSparseVector diff = *this - other;
+        if (diff.base_.size() < dim_ && diff.shift_ != T{}) return false;
+        for (auto it = diff.base_.cbegin(); it != diff.base_.cend(); ++it) {
+            if (it->second + diff.shift_ != T{}) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const ShiftedSparseVector& other) const {
+        return !(*this == other);
+    }
+
+private:
+    SparseVector<T> base_;
+    T shift_ = T{};
+    size_t dim_ = 0;
+
+    void checkDimensions(const ShiftedSparseVector& other) const {
+        if (dim_ != other.dim_) {
+            throw std::invalid_argument("Vectors must have the same dimensions.");
+        }
+    }
+};
+
+// Ленивое представление "разреженная матрица + константа": A + c * 1 * 1^T.
+// Сдвиг применяется алгебраически, матрица никогда не уплотняется.
+template <typename T>
+class ShiftedSparseMatrix {
+public:
+    using Position = typename SparseMatrix<T>::Position;
+
+    ShiftedSparseMatrix() = default;
+
+    ShiftedSparseMatrix(const SparseMatrix<T>& base, const T& shift)
+        : base_(base), shift_(shift) {}
+
+    // Доступ к элементам
+    T operator()(size_t row, size_t col) const {
+        return base_(row, col) + shift_;
+    }
+
+    const SparseMatrix<T>& base() const { return base_; }
+    T shift() const { return shift_; }
+    size_t rows() const { return base_.rows(); }
+    size_t cols() const { return base_.cols(); }
+
+    // Сумма всех элементов: sum(A) + c * rows * cols
+    T sum() const {
+        return base_.sum() + shift_ * static_cast<T>(rows() * cols());
+    }
+
+    ShiftedSparseMatrix operator+(const T& scalar) const {
+        return ShiftedSparseMatrix(base_, shift_ + scalar);
+    }
+
+    ShiftedSparseMatrix operator-(const T& scalar) const {
+        return ShiftedSparseMatrix(base_, shift_ - scalar);
+    }
+
+    ShiftedSparseMatrix operator*(const T& scalar) const {
+        return ShiftedSparseMatrix(base_ * scalar, shift_ * scalar);
+    }
+
+    ShiftedSparseMatrix operator/(const T& scalar) const {
+        if (scalar == T{}) {
+            throw std::invalid_argument("Division by zero");
+        }
+        return ShiftedSparseMatrix(base_ / scalar, shift_ / scalar);
+    }
+
+    ShiftedSparseMatrix operator+(const ShiftedSparseMatrix& other) const {
+        return ShiftedSparseMatrix(base_ + other.base_, shift_ + other.shift_);
+    }
+
+    ShiftedSparseMatrix operator-(const ShiftedSparseMatrix& other) const {
+        return ShiftedSparseMatrix(base_ - other.base_, shift_ - other.shift_);
+    }
+
+    ShiftedSparseMatrix operator+(const SparseMatrix<T>& other) const {
+        return ShiftedSparseMatrix(base_ + other, shift_);
+    }
+
+    ShiftedSparseMatrix operator-(const SparseMatrix<T>& other) const {
+        return ShiftedSparseMatrix(base_ - other, shift_);
+    }
+
+    ShiftedSparseMatrix transpose() const {
+        return ShiftedSparseMatrix(base_.transpose(), shift_);
+    }
+
+    // Матрично-векторное умножение:
+    // (A + c*1*1^T) x = A x + c * sum(x) * 1
+    ShiftedSparseVector<T> operator*(const SparseVector<T>& vec) const {
+        return ShiftedSparseVector<T>(base_ * vec, shift_ * vec.sum(), rows());
+    }
+
+    // (A + c*1*1^T)(v + b*1) = A v + b * (A 1) + c * sum(x) * 1
+    ShiftedSparseVector<T> operator*(const ShiftedSparseVector<T>& vec) const {
+        if (vec.dimension() != cols()) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        SparseVector<T> y = base_ * vec.base();
+        if (vec.shift() != T{}) {
+            y = y + base_.rowSums() * vec.shift();
+        }
+        return ShiftedSparseVector<T>(y, shift_ * vec.sum(), rows());
+    }
+
+    // Поэлементное произведение:
+    // (A + c) * (B + d) = (A*B + d*A + c*B) + c*d
+    ShiftedSparseMatrix cwiseProduct(const ShiftedSparseMatrix& other) const {
+        if (rows() != other.rows() || cols() != other.cols()) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        SparseMatrix<T> result(rows(), cols());
+        auto it = base_.cbegin();
+        auto jt = other.base_.cbegin();
+        while (it != base_.cend() || jt != other.base_.cend()) {
+            Position pos;
+            T a = T{};
+            T b = T{};
+            if (jt == other.base_.cend() || (it != base_.cend() && it->first < jt->first)) {
+                pos = it->first;
+                a = it->second;
+                ++it;
+            }
+            else if (it == base_.cend() || jt->first < it->first) {
+                pos = jt->first;
+                b = jt->second;
+                ++jt;
+            }
+            else {
+                pos = it->first;
+                a = it->second;
+                b = jt->second;
+                ++it;
+                ++jt;
+            }
+            result.setElement(pos.first, pos.second, a * b + other.shift_ * a + shift_ * b);
+        }
+        return ShiftedSparseMatrix(result, shift_ * other.shift_);
+    }
+
+    // (A + c) * B = A*B + c*B - результат снова разреженный
+    SparseMatrix<T> cwiseProduct(const SparseMatrix<T>& other) const {
+        return base_.cwiseProduct(other) + other * shift_;
+    }
+
+    // Норма Фробениуса: хранимые элементы плюс (rows*cols - nnz) копий сдвига
+    double frobeniusNorm() const {
+        double c = static_cast<double>(shift_);
+        double norm = c * c * static_cast<double>(rows() * cols() - base_.size());
+        for (auto it = base_.cbegin(); it != base_.cend(); ++it) {
+            double val = static_cast<double>(it->second + shift_);
+            norm += val * val;
+        }
+        return std::sqrt(norm);
+    }
+
+    // Явное уплотнение (O(rows*cols) элементов) - только для малых матриц
+    SparseMatrix<T> materialize() const {
+        SparseMatrix<T> result(rows(), cols());
+        for (size_t i = 0; i < rows(); ++i) {
+            for (size_t j = 0; j < cols(); ++j) {
+                result.setElement(i, j, (*this)(i, j));
+            }
+        }
+        return result;
+    }
+
+    bool operator==(const ShiftedSparseMatrix& other) const {
+        if (rows() != other.rows() || cols() != other.cols()) return false;
+        ShiftedSparseMatrix diff = *this - other;
+        if (diff.base_.size() < rows() * cols() && diff.shift_ != T{}) return false;
+        for (auto it = diff.base_.cbegin(); it != diff.base_.cend(); ++it) {
+            if (it->second + diff.shift_ != T{}) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const ShiftedSparseMatrix& other) const {
+        return !(*this == other);
+    }
+
+private:
+    SparseMatrix<T> base_;
+    T shift_ = T{};
+};
+
+// Сдвиг всех элементов на константу без уплотнения
+template <typename T>
+ShiftedSparseMatrix<T> shifted(const SparseMatrix<T>& mat, const T& shift) {
+    return ShiftedSparseMatrix<T>(mat, shift);
+}
+
+template <typename T>
+ShiftedSparseVector<T> shifted(const SparseVector<T>& vec, const T& shift, size_t dim) {
+    return ShiftedSparseVector<T>(vec, shift, dim);
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <utility>
+#include <stdexcept>
+
+template <typename T>
+class SparseMatrix;
+
+// Матрица фиксированного размера R x C: размеры известны при компиляции,
+// элементы лежат на стеке (std::array), циклы по константным границам
+// разворачиваются компилятором, внутренние суммы - свертками по
+// index_sequence. Для малых систем (якобианы 3x3, 4x4, 6x6) это заменяет
+// хеш-таблицы SparseMatrix и общий метод Гаусса-Жордана.
+//
+// SparseMatrix::inverse() и произведение квадратных матриц до
+// SmallMatrixMaxSize сами переходят на этот тип, так что обобщенный код
+// получает быстрый путь без изменений.
+constexpr size_t SmallMatrixMaxSize = 6;
+
+template <typename T, size_t R, size_t C>
+class SmallMatrix {
+    static_assert(R > 0 && C > 0, "SmallMatrix dimensions must be positive.");
+
+public:
+    constexpr SmallMatrix() : data_{} {}
+
+    // Из разреженной матрицы того же размера
+    explicit SmallMatrix(const SparseMatrix<T>& mat) : data_{} {
+        if (mat.rows() != R || mat.cols() != C) {
+            throw std::invalid_argument("Matrices must have the same dimensions.");
+        }
+        for (auto it = mat.cbegin(); it != mat.cend(); ++it) {
+            data_[it->first.first * C + it->first.second] = it->second;
+        }
+    }
+
+    static constexpr size_t rows() { return R; }
+    static constexpr size_t cols() { return C; }
+
+    constexpr T operator()(size_t row, size_t col) const { return data_[row * C + col]; }
+    constexpr T& operator()(size_t row, size_t col) { return data_[row * C + col]; }
+
+    // Аналог setElement для общего кода
+    constexpr void setElement(size_t row, size_t col, const T& value) { data_[row * C + col] = value; }
+
+    static constexpr SmallMatrix identity() {
+        static_assert(R == C, "Identity matrix must be square.");
+        SmallMatrix result;
+        for (size_t i = 0; i < R; ++i) {
+            result.data_[i * C + i] = T{ 1 };
+        }
+        return result;
+    }
+
+    SparseMatrix<T> toSparse() const {
+        SparseMatrix<T> result(R, C);
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                result.appendElement(i, j, data_[i * C + j]);
+            }
+        }
+        return result;
+    }
+
+    constexpr SmallMatrix operator+(const SmallMatrix& other) const {
+        SmallMatrix result;
+        for (size_t k = 0; k < R * C; ++k) result.data_[k] = data_[k] + other.data_[k];
+        return result;
+    }
+
+    constexpr SmallMatrix operator-(const SmallMatrix& other) const {
+        SmallMatrix result;
+        for (size_t k = 0; k < R * C; ++k) result.data_[k] = data_[k] - other.data_[k];
+        return result;
+    }
+
+    constexpr SmallMatrix operator*(const T& scalar) const {
+        SmallMatrix result;
+        for (size_t k = 0; k < R * C; ++k) result.data_[k] = data_[k] * scalar;
+        return result;
+    }
+
+    SmallMatrix operator/(const T& scalar) const {
+        if (scalar == T{}) {
+            throw std::invalid_argument("Division by zero");
+        }
+        SmallMatrix result;
+        for (size_t k = 0; k < R * C; ++k) result.data_[k] = data_[k] / scalar;
+        return result;
+    }
+
+    // Произведение: (A * B)[i][j] = sum_k A[i][k] * B[k][j], сумма по k развернута
+    template <size_t K>
+    constexpr SmallMatrix<T, R, K> operator*(const SmallMatrix<T, C, K>& other) const {
+        SmallMatrix<T, R, K> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < K; ++j) {
+                result(i, j) = rowTimesColumn(i, j, other, std::make_index_sequence<C>{});
+            }
+        }
+        return result;
+    }
+
+    constexpr std::array<T, R> operator*(const std::array<T, C>& x) const {
+        std::array<T, R> y{};
+        for (size_t i = 0; i < R; ++i) {
+            y[i] = rowTimesVector(i, x, std::make_index_sequence<C>{});
+        }
+        return y;
+    }
+
+    constexpr SmallMatrix<T, C, R> transpose() const {
+        SmallMatrix<T, C, R> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                result(j, i) = data_[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    constexpr bool operator==(const SmallMatrix& other) const {
+        for (size_t k = 0; k < R * C; ++k) {
+            if (data_[k] != other.data_[k]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const SmallMatrix& other) const {
+        return !(*this == other);
+    }
+
+    T determinant() const {
+        static_assert(R == C, "Matrix must be square.");
+        if constexpr (R == 1) {
+            return data_[0];
+        }
+        else if constexpr (R == 2) {
+            return data_[0] * data_[3] - data_[1] * data_[2];
+        }
+        else if constexpr (R == 3) {
+            return data_[0] * (data_[4] * data_[8] - data_[5] * data_[7])
+                - data_[1] * (data_[3] * data_[8] - data_[5] * data_[6])
+                + data_[2] * (data_[3] * data_[7] - data_[4] * data_[6]);
+        }
+        else {
+            SmallMatrix lu = *this;
+            std::array<size_t, R> perm{};
+            int sign = 1;
+            if (!lu.decompose(perm, sign)) return T{};
+            T det = static_cast<T>(sign);
+            for (size_t i = 0; i < R; ++i) det *= lu.data_[i * C + i];
+            return det;
+        }
+    }
+
+    // Обращение: явные формулы через алгебраические дополнения для n <= 3,
+    // иначе LU с выбором ведущего элемента по столбцу
+    SmallMatrix inverse() const {
+        static_assert(R == C, "Matrix must be square to invert.");
+        SmallMatrix result;
+        if constexpr (R <= 3) {
+            T det = determinant();
+            if (det == T{}) {
+                throw std::runtime_error("Matrix is singular and cannot be inverted.");
+            }
+            const T* a = data_.data();
+            if constexpr (R == 1) {
+                result.data_[0] = T{ 1 } / det;
+            }
+            else if constexpr (R == 2) {
+                result.data_ = { a[3] / det, -a[1] / det, -a[2] / det, a[0] / det };
+            }
+            else {
+                result.data_ = {
+                    (a[4] * a[8] - a[5] * a[7]) / det, (a[2] * a[7] - a[1] * a[8]) / det, (a[1] * a[5] - a[2] * a[4]) / det,
+                    (a[5] * a[6] - a[3] * a[8]) / det, (a[0] * a[8] - a[2] * a[6]) / det, (a[2] * a[3] - a[0] * a[5]) / det,
+                    (a[3] * a[7] - a[4] * a[6]) / det, (a[1] * a[6] - a[0] * a[7]) / det, (a[0] * a[4] - a[1] * a[3]) / det };
+            }
+        }
+        else {
+            SmallMatrix lu = *this;
+            std::array<size_t, R> perm{};
+            int sign = 1;
+            if (!lu.decompose(perm, sign)) {
+                throw std::runtime_error("Matrix is singular and cannot be inverted.");
+            }
+            // Столбец j обратной: L U x = P e_j
+            for (size_t j = 0; j < R; ++j) {
+                std::array<T, R> x{};
+                for (size_t i = 0; i < R; ++i) {
+                    T sum = perm[i] == j ? T{ 1 } : T{};
+                    for (size_t k = 0; k < i; ++k) sum -= lu.data_[i * C + k] * x[k];
+                    x[i] = sum;
+                }
+                for (size_t i = R; i-- > 0;) {
+                    T sum = x[i];
+                    for (size_t k = i + 1; k < R; ++k) sum -= lu.data_[i * C + k] * x[k];
+                    x[i] = sum / lu.data_[i * C + i];
+                }
+                for (size_t i = 0; i < R; ++i) result.data_[i * C + j] = x[i];
+            }
+        }
+        return result;
+    }
+
+private:
+    std::array<T, R * C> data_;
+
+    template <size_t K, size_t... I>
+    constexpr T rowTimesColumn(size_t i, size_t j, const SmallMatrix<T, C, K>& other, std::index_sequence<I...>) const {
+        return ((data_[i * C + I] * other(I, j)) + ...);
+    }
+
+    template <size_t... I>
+    constexpr T rowTimesVector(size_t i, const std::array<T, C>& x, std::index_sequence<I...>) const {
+        return ((data_[i * C + I] * x[I]) + ...);
+    }
+
+    // LU на месте (L с единичной диагональю под U), perm[i] - исходная строка
+    bool decompose(std::array<size_t, R>& perm, int& sign) {
+        for (size_t i = 0; i < R; ++i) perm[i] = i;
+        for (size_t k = 0; k < R; ++k) {
+            size_t pivot = k;
+            T maxVal = std::abs(data_[k * C + k]);
+            for (size_t r = k + 1; r < R; ++r) {
+                T val = std::abs(data_[r * C + k]);
+                if (val > maxVal) {
+                    maxVal = val;
+                    pivot = r;
+                }
+            }
+            if (maxVal == T{}) return false;
+            if (pivot != k) {
+                for (size_t c = 0; c < C; ++c) std::swap(data_[k * C + c], data_[pivot * C + c]);
+                std::swap(perm[k], perm[pivot]);
+                sign = -sign;
+            }
+            for (size_t r = k + 1; r < R; ++r) {
+                T factor = data_[r * C + k] / data_[k * C + k];
+                data_[r * C + k] = factor;
+                for (size_t c = k + 1; c < C; ++c) data_[r * C + c] -= factor * data_[k * C + c];
+            }
+        }
+        return true;
+    }
+};
+
+template <typename T, size_t R, size_t C>
+constexpr SmallMatrix<T, R, C> operator*(const T& scalar, const SmallMatrix<T, R, C>& mat) {
+    return mat * scalar;
+}
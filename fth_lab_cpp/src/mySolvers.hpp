@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Итерационные решатели для A x = b. Оператор A - любой тип с методом
+// spmv(const std::vector<double>&, std::vector<double>&): CsrMatrix<double>,
+// CompactCsrMatrix<float> / <bfloat16>, TunedMatrix<double> и т.п.
+namespace solvers {
+
+    struct SolveResult {
+        bool converged = false;
+        size_t iterations = 0;          // внешние итерации (для BiCGSTAB - все)
+        size_t innerIterations = 0;     // суммарно во внутренних решениях
+        double residualNorm = 0.0;      // ||b - A x|| / ||b|| в double
+    };
+
+    namespace detail {
+
+        inline double dot(const std::vector<double>& a, const std::vector<double>& b) {
+            double sum = 0.0;
+#pragma omp simd reduction(+:sum)
+            for (size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+            return sum;
+        }
+
+        inline double norm(const std::vector<double>& a) {
+            return std::sqrt(dot(a, a));
+        }
+
+        // r = b - A x, возвращает ||r||
+        template <typename Op>
+        double residual(const Op& A, const std::vector<double>& b, const std::vector<double>& x,
+            std::vector<double>& r) {
+            A.spmv(x, r);
+            for (size_t i = 0; i < b.size(); ++i) r[i] = b[i] - r[i];
+            return norm(r);
+        }
+
+    }
+
+    // BiCGSTAB (ван дер Ворст) для несимметричных систем; x - начальное
+    // приближение и результат. Останов по ||r|| <= tol * ||b||.
+    template <typename Op>
+    SolveResult bicgstab(const Op& A, const std::vector<double>& b, std::vector<double>& x,
+        double tol = 1e-10, size_t maxIter = 1000) {
+        size_t n = b.size();
+        if (A.rows() != n || A.cols() != n) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        x.resize(n, 0.0);
+        SolveResult result;
+        double bNorm = detail::norm(b);
+        if (bNorm == 0.0) {
+            x.assign(n, 0.0);
+            result.converged = true;
+            return result;
+        }
+
+        std::vector<double> r(n), rHat, p(n, 0.0), v(n, 0.0), s(n), t(n);
+        double rNorm = detail::residual(A, b, x, r);
+        rHat = r;
+        double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+        while (rNorm > tol * bNorm && result.iterations < maxIter) {
+            ++result.iterations;
+            double rhoNext = detail::dot(rHat, r);
+            if (rhoNext == 0.0) break;      // пробой метода
+            double beta = (rhoNext / rho) * (alpha / omega);
+            rho = rhoNext;
+            for (size_t i = 0; i < n; ++i) p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+            A.spmv(p, v);
+            double rHatV = detail::dot(rHat, v);
+            if (rHatV == 0.0) break;
+            alpha = rho / rHatV;
+            for (size_t i = 0; i < n; ++i) s[i] = r[i] - alpha * v[i];
+            if (detail::norm(s) <= tol * bNorm) {
+                for (size_t i = 0; i < n; ++i) x[i] += alpha * p[i];
+                break;
+            }
+
+            A.spmv(s, t);
+            double tt = detail::dot(t, t);
+            if (tt == 0.0) break;
+            omega = detail::dot(t, s) / tt;
+            for (size_t i = 0; i < n; ++i) {
+                x[i] += alpha * p[i] + omega * s[i];
+                r[i] = s[i] - omega * t[i];
+            }
+            rNorm = detail::norm(r);
+            if (omega == 0.0) break;
+        }
+
+        result.residualNorm = detail::residual(A, b, x, r) / bNorm;
+        result.converged = result.residualNorm <= tol;
+        result.innerIterations = result.iterations;
+        return result;
+    }
+
+    // Итерационное уточнение со смешанной точностью: невязка r = b - A x
+    // считается по точной матрице в double, поправка A d = r решается грубо
+    // (innerTol) по компактной копии low (float / bfloat16). Основной объем
+    // трафика приходится на внутренние итерации, поэтому он почти вдвое
+    // меньше, а ответ сходится к точности double.
+    template <typename Op, typename LowOp>
+    SolveResult refine(const Op& A, const LowOp& low, const std::vector<double>& b, std::vector<double>& x,
+        double tol = 1e-12, size_t maxOuter = 50, double innerTol = 1e-4, size_t maxInner = 1000) {
+        size_t n = b.size();
+        if (A.rows() != n || A.cols() != n || low.rows() != n || low.cols() != n) {
+            throw std::runtime_error("Matrix dimensions do not match for multiplication.");
+        }
+        x.resize(n, 0.0);
+        SolveResult result;
+        double bNorm = detail::norm(b);
+        if (bNorm == 0.0) {
+            x.assign(n, 0.0);
+            result.converged = true;
+            return result;
+        }
+
+        std::vector<double> r(n), d;
+        double rNorm = detail::residual(A, b, x, r);
+        while (rNorm > tol * bNorm && result.iterations < maxOuter) {
+            ++result.iterations;
+            d.assign(n, 0.0);
+            SolveResult inner = bicgstab(low, r, d, innerTol, maxInner);
+            result.innerIterations += inner.iterations;
+            for (size_t i = 0; i < n; ++i) x[i] += d[i];
+            double next = detail::residual(A, b, x, r);
+            if (!(next < rNorm)) {      // уточнение перестало помогать
+                rNorm = next;
+                break;
+            }
+            rNorm = next;
+        }
+
+        result.residualNorm = rNorm / bNorm;
+        result.converged = result.residualNorm <= tol;
+        return result;
+    }
+
+}
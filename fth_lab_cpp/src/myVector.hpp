@@ -4,6 +4,9 @@
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
+#include "myKernels.hpp"
+#include "myProfiler.hpp"
 
 template <typename T>
 class SparseVector {
@@ -25,6 +28,7 @@ public:
 
     // Установка значения по индексу
     void setElement(size_t idx, const T& value) {
+        SPARSE_PROFILE_POINT("SparseVector::setElement");
         auto it = mainData_.find(idx);
         if (it != mainData_.end()) {
             // Элемент уже существует
@@ -44,12 +48,14 @@ public:
                 mainData_[idx] = value;
                 orderedData_[idx] = value;
                 maxIndex_ = std::max(maxIndex_, idx);
+                SPARSE_PROFILE_ALLOC(2);
             }
         }
     }
 
     // Удаление элемента
     void removeElement(size_t idx) {
+        SPARSE_PROFILE_POINT("SparseVector::removeElement");
         mainData_.erase(idx);
         orderedData_.erase(idx);
         if (!orderedData_.empty()) {
@@ -60,6 +66,28 @@ public:
         }
     }
 
+    // Резервирование места под nnz элементов
+    void reserve(size_t nnz) {
+        mainData_.reserve(nnz);
+    }
+
+    // Добавление элемента с индексом больше всех имеющихся за O(1),
+    // иначе выполняется обычный setElement
+    void appendElement(size_t idx, const T& value) {
+        SPARSE_PROFILE_POINT("SparseVector::appendElement");
+        if (!orderedData_.empty() && orderedData_.rbegin()->first >= idx) {
+            setElement(idx, value);
+            return;
+        }
+        if (value == T{}) {
+            return;
+        }
+        orderedData_.emplace_hint(orderedData_.end(), idx, value);
+        mainData_.emplace(idx, value);
+        SPARSE_PROFILE_ALLOC(2);
+        maxIndex_ = std::max(maxIndex_, idx);
+    }
+
     Iterator begin() {
         return orderedData_.begin();
     }
@@ -78,6 +106,26 @@ public:
 
     size_t size() const { return mainData_.size(); }
 
+    // Размерность вектора (с учетом нулевых элементов)
+    size_t dimension() const {
+        if (orderedData_.empty()) {
+            return size_;
+        }
+        return std::max(size_, orderedData_.rbegin()->first + 1);
+    }
+
+    // Сумма всех элементов
+    T sum() const {
+        SPARSE_PROFILE_SCOPE("SparseVector::sum");
+        T result = T{};
+        for (auto& [idx, val] : orderedData_) {
+            result += val;
+        }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), 0, entryBytes_);
+        return result;
+    }
+
     void clearAll() {
         mainData_.clear();
         orderedData_.clear();
@@ -86,15 +134,19 @@ public:
 
     // Унарный минус 
     SparseVector operator-() const {
+        SPARSE_PROFILE_SCOPE("SparseVector::negate");
         SparseVector result(size_);
         for (auto& [idx, val] : mainData_) {
             result.setElement(idx, -val);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     // Операция сложения двух векторов
     SparseVector operator+(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::add");
         SparseVector result(std::max(size_, other.size_));
         for (auto& [idx, val] : mainData_) {
             result.setElement(idx, val);
@@ -103,11 +155,14 @@ public:
             T newVal = result[idx] + val;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(other.size());
+        SPARSE_PROFILE_IO(size() + other.size(), result.size(), entryBytes_);
         return result;
     }
 
     // Операция вычитания двух векторов
     SparseVector operator-(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::sub");
         SparseVector result(std::max(size_, other.size_));
         for (auto& [idx, val] : mainData_) {
             result.setElement(idx, val);
@@ -116,21 +171,27 @@ public:
             T newVal = result[idx] - val;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(other.size());
+        SPARSE_PROFILE_IO(size() + other.size(), result.size(), entryBytes_);
         return result;
     }
 
     // Умножение на скаляр
     SparseVector operator*(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::mulScalar");
         SparseVector result(size_);
         for (auto& [idx, val] : mainData_) {
             T newVal = val * scalar;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     // Деление на скаляр
     SparseVector operator/(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::divScalar");
         if (scalar == T{}) {
             throw std::invalid_argument("Division by zero");
         }
@@ -139,50 +200,199 @@ public:
             T newVal = val / scalar;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
-    // Сложение с числом (скаляр)
+    // Сложение с числом (скаляр) - только хранимые ненулевые элементы,
+    // сдвиг всего вектора - ShiftedSparseVector
     SparseVector operator+(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::addScalar");
         SparseVector result(size_);
         for (auto& [idx, val] : mainData_) {
             T newVal = val + scalar;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
     // Вычитание скаляра
     SparseVector operator-(const T& scalar) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::subScalar");
         SparseVector result(size_);
         for (auto& [idx, val] : mainData_) {
             T newVal = val - scalar;
             result.setElement(idx, newVal);
         }
+        SPARSE_PROFILE_FLOPS(size());
+        SPARSE_PROFILE_IO(size(), result.size(), entryBytes_);
         return result;
     }
 
-    // Возведение в степень всех ненулевых элементов
+    // Возведение в степень всех ненулевых элементов.
+    // Для целых неотрицательных показателей - повторное умножение вместо pow
     SparseVector powerAll(const T& exponent) const {
-        SparseVector result(size_);
-        for (auto& [idx, val] : mainData_) {
-            T newVal = static_cast<T>(std::pow(static_cast<double>(val), static_cast<double>(exponent)));
-            result.setElement(idx, newVal);
+        SPARSE_PROFILE_SCOPE("SparseVector::powerAll");
+        std::vector<size_t> idx;
+        std::vector<T> vals;
+        gatherValues(idx, vals);
+        std::vector<T> out(vals.size());
+        unsigned long long intExp = 0;
+        if (kernels::isNonNegativeInteger(exponent, intExp)) {
+            kernels::integerPow(vals.data(), out.data(), vals.size(), intExp);
         }
-        return result;
+        else {
+            kernels::map(vals.data(), out.data(), vals.size(), [&](const T& v) {
+                return static_cast<T>(std::pow(static_cast<double>(v), static_cast<double>(exponent)));
+                });
+        }
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(size_, idx, out);
+    }
+
+    // Поэлементное (адамарово) произведение
+    SparseVector cwiseProduct(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::cwiseProduct");
+        std::vector<size_t> idx;
+        std::vector<T> a, b;
+        auto it = orderedData_.begin();
+        auto jt = other.orderedData_.begin();
+        while (it != orderedData_.end() && jt != other.orderedData_.end()) {
+            if (it->first < jt->first) {
+                ++it;
+            }
+            else if (jt->first < it->first) {
+                ++jt;
+            }
+            else {
+                idx.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(jt->second);
+                ++it;
+                ++jt;
+            }
+        }
+        std::vector<T> out(a.size());
+        kernels::product(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(std::max(size_, other.size_), idx, out);
+    }
+
+    // Поэлементное деление, деление ненулевого элемента на неявный ноль - ошибка
+    SparseVector cwiseQuotient(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::cwiseQuotient");
+        std::vector<size_t> idx;
+        std::vector<T> a, b;
+        idx.reserve(orderedData_.size());
+        a.reserve(orderedData_.size());
+        b.reserve(orderedData_.size());
+        auto jt = other.orderedData_.begin();
+        for (auto& [i, val] : orderedData_) {
+            while (jt != other.orderedData_.end() && jt->first < i) {
+                ++jt;
+            }
+            if (jt == other.orderedData_.end() || i < jt->first) {
+                throw std::invalid_argument("Division by zero");
+            }
+            idx.push_back(i);
+            a.push_back(val);
+            b.push_back(jt->second);
+        }
+        std::vector<T> out(a.size());
+        kernels::quotient(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(std::max(size_, other.size_), idx, out);
+    }
+
+    // Поэлементный максимум/минимум (неявные нули участвуют в сравнении)
+    SparseVector cwiseMax(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::cwiseMax");
+        std::vector<size_t> idx;
+        std::vector<T> a, b;
+        gatherUnion(other, idx, a, b);
+        std::vector<T> out(a.size());
+        kernels::maximum(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(std::max(size_, other.size_), idx, out);
+    }
+
+    SparseVector cwiseMin(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::cwiseMin");
+        std::vector<size_t> idx;
+        std::vector<T> a, b;
+        gatherUnion(other, idx, a, b);
+        std::vector<T> out(a.size());
+        kernels::minimum(a.data(), b.data(), out.data(), out.size());
+        SPARSE_PROFILE_FLOPS(out.size());
+        SPARSE_PROFILE_IO(size() + other.size(), out.size(), entryBytes_);
+        return fromSorted(std::max(size_, other.size_), idx, out);
+    }
+
+    // Поэлементный корень
+    SparseVector cwiseSqrt() const {
+        SPARSE_PROFILE_SCOPE("SparseVector::cwiseSqrt");
+        std::vector<size_t> idx;
+        std::vector<T> vals;
+        gatherValues(idx, vals);
+        std::vector<T> out(vals.size());
+        kernels::sqrt(vals.data(), out.data(), vals.size());
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(size_, idx, out);
+    }
+
+    // Применение функции к каждому хранимому элементу по порядку индексов
+    template <typename F>
+    SparseVector map(F f) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::map");
+        std::vector<size_t> idx;
+        std::vector<T> vals;
+        gatherValues(idx, vals);
+        std::vector<T> out(vals.size());
+        kernels::mapInOrder(vals.data(), out.data(), vals.size(), f);
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), out.size(), entryBytes_);
+        return fromSorted(size_, idx, out);
+    }
+
+    // Свертка хранимых элементов по порядку; для std::plus - векторизованная
+    // сумма (порядок сложения другой, для float возможна иная погрешность)
+    template <typename Op>
+    T reduce(Op op, T init = T{}) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::reduce");
+        std::vector<T> vals;
+        vals.reserve(orderedData_.size());
+        for (auto& kv : orderedData_) {
+            vals.push_back(kv.second);
+        }
+        SPARSE_PROFILE_FLOPS(vals.size());
+        SPARSE_PROFILE_IO(vals.size(), 0, entryBytes_);
+        return kernels::fold(vals.data(), vals.size(), init, op);
     }
 
     // Скалярное произведение 
     T dot(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::dot");
         T result = T{};
         for (auto& [idx, val] : mainData_) {
             result += val * other[idx];
         }
+        SPARSE_PROFILE_FLOPS(2 * size());
+        SPARSE_PROFILE_IO(size() + other.size(), 0, entryBytes_);
         return result;
     }
 
     // Операторы сравнения 
     bool operator==(const SparseVector& other) const {
+        SPARSE_PROFILE_SCOPE("SparseVector::equals");
+        SPARSE_PROFILE_IO(size() + other.size(), 0, entryBytes_);
         if (this->size() != other.size()) return false;
         // Проверяем все элементы
         for (auto& [idx, val] : mainData_) {
@@ -212,4 +422,55 @@ private:
     std::map<size_t, T> orderedData_;
     size_t maxIndex_ = 0;
     size_t size_ = 0; 
+
+    // Оценка байт на элемент для счетчиков профилировщика
+    static constexpr size_t entryBytes_ = sizeof(size_t) + sizeof(T);
+
+    // Выгрузка индексов и значений в непрерывные массивы
+    void gatherValues(std::vector<size_t>& idx, std::vector<T>& vals) const {
+        idx.reserve(orderedData_.size());
+        vals.reserve(orderedData_.size());
+        for (auto& [i, val] : orderedData_) {
+            idx.push_back(i);
+            vals.push_back(val);
+        }
+    }
+
+    // Объединение шаблонов двух векторов с неявными нулями
+    void gatherUnion(const SparseVector& other, std::vector<size_t>& idx,
+        std::vector<T>& a, std::vector<T>& b) const {
+        auto it = orderedData_.begin();
+        auto jt = other.orderedData_.begin();
+        while (it != orderedData_.end() || jt != other.orderedData_.end()) {
+            if (jt == other.orderedData_.end() || (it != orderedData_.end() && it->first < jt->first)) {
+                idx.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(T{});
+                ++it;
+            }
+            else if (it == orderedData_.end() || jt->first < it->first) {
+                idx.push_back(jt->first);
+                a.push_back(T{});
+                b.push_back(jt->second);
+                ++jt;
+            }
+            else {
+                idx.push_back(it->first);
+                a.push_back(it->second);
+                b.push_back(jt->second);
+                ++it;
+                ++jt;
+            }
+        }
+    }
+
+    // Сборка результата из упорядоченных индексов
+    static SparseVector fromSorted(size_t size, const std::vector<size_t>& idx, const std::vector<T>& vals) {
+        SparseVector result(size);
+        result.reserve(idx.size());
+        for (size_t i = 0; i < idx.size(); ++i) {
+            result.appendElement(idx[i], vals[i]);
+        }
+        return result;
+    }
 };
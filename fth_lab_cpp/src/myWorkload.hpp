@@ -0,0 +1,241 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "myFormats.hpp"
+#include "myParallel.hpp"
+
+// Быстрые воспроизводимые генераторы входных данных (бенчмарки, тесты).
+//  - CounterRng: число с номером i - хеш SplitMix64 от (ключ, i), без
+//    состояния: блоки генерируются в любом порядке на любом числе потоков
+//    с тем же результатом, fill векторизуется;
+//  - Xoshiro256: последовательный xoshiro256** для одного потока, потоки
+//    из одного сида - разные stream (или jump, 2^128 шагов).
+// Генераторы матриц берут поток stream = номер строки, поэтому результат
+// не зависит от числа потоков.
+//
+// finalize, mix, toUnit, CounterRng и Xoshiro256 - копия того же ядра из
+// thd_lab_cpp/src/myWorkload.hpp (лабораторные собираются независимо);
+// меняются в обеих копиях вместе.
+namespace workload {
+
+    constexpr uint64_t golden = 0x9E3779B97F4A7C15ull;
+
+    // Финализатор SplitMix64
+    inline uint64_t finalize(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    inline uint64_t mix(uint64_t z) { return finalize(z + golden); }
+
+    // Равномерное из [0, range): старшие 64 бита r * range (смещение < range / 2^64)
+    inline uint64_t below(uint64_t r, uint64_t range) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(r) * range) >> 64);
+    }
+
+    // [0, 1) с 53 значащими битами
+    inline double toUnit(uint64_t r) { return static_cast<double>(r >> 11) * 0x1.0p-53; }
+
+    class CounterRng {
+    public:
+        explicit CounterRng(uint64_t seed, uint64_t stream = 0) : key_(mix(seed ^ mix(stream))) {}
+
+        uint64_t operator()(uint64_t counter) const { return finalize(key_ + counter * golden); }
+        double uniform(uint64_t counter) const { return toUnit((*this)(counter)); }
+
+        // out[k] = (*this)(first + k * step)
+        void fill(uint64_t first, uint64_t* out, size_t n, uint64_t step = 1) const {
+            const uint64_t key = key_;
+#pragma omp simd
+            for (size_t k = 0; k < n; ++k) {
+                out[k] = finalize(key + (first + k * step) * golden);
+            }
+        }
+
+    private:
+        uint64_t key_;
+    };
+
+    class Xoshiro256 {
+    public:
+        explicit Xoshiro256(uint64_t seed, uint64_t stream = 0) {
+            uint64_t z = seed ^ mix(stream);
+            for (auto& s : s_) s = mix(z += golden);
+        }
+
+        uint64_t operator()() {
+            uint64_t result = rotl(s_[1] * 5, 7) * 9;
+            uint64_t t = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+            return result;
+        }
+
+        double uniform() { return toUnit((*this)()); }
+
+        // Эквивалент 2^128 вызовов: неперекрывающиеся подпоследовательности
+        void jump() {
+            static const uint64_t jumpPoly[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+            uint64_t t[4] = { 0, 0, 0, 0 };
+            for (uint64_t word : jumpPoly) {
+                for (unsigned b = 0; b < 64; ++b) {
+                    if (word & (uint64_t{ 1 } << b)) {
+                        for (int k = 0; k < 4; ++k) t[k] ^= s_[k];
+                    }
+                    (*this)();
+                }
+            }
+            for (int k = 0; k < 4; ++k) s_[k] = t[k];
+        }
+
+        // Для std::uniform_int_distribution и std::shuffle
+        using result_type = uint64_t;
+        static constexpr uint64_t min() { return 0; }
+        static constexpr uint64_t max() { return ~uint64_t{ 0 }; }
+
+    private:
+        uint64_t s_[4];
+
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    };
+
+    // Ранги 0..n-1 с вероятностью ~ 1 / (r + 1)^exponent. Таблица псевдонимов
+    // (Walker/Vose): выборка за O(1) по одному 64-битному числу - старшие
+    // 32 бита выбирают ячейку, младшие - ее ранг или псевдоним.
+    class ZipfTable {
+    public:
+        ZipfTable(size_t n, double exponent) : threshold_(n), alias_(n) {
+            std::vector<double> scaled(n);
+            double sum = 0.0;
+            for (size_t r = 0; r < n; ++r) {
+                scaled[r] = 1.0 / std::pow(static_cast<double>(r + 1), exponent);
+                sum += scaled[r];
+            }
+            std::vector<size_t> small, large;
+            for (size_t r = 0; r < n; ++r) {
+                scaled[r] *= static_cast<double>(n) / sum;
+                (scaled[r] < 1.0 ? small : large).push_back(r);
+                alias_[r] = r;
+            }
+            while (!small.empty() && !large.empty()) {
+                size_t s = small.back();
+                size_t l = large.back();
+                small.pop_back();
+                alias_[s] = l;
+                threshold_[s] = toThreshold(scaled[s]);
+                scaled[l] -= 1.0 - scaled[s];
+                if (scaled[l] < 1.0) {
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // Остатки - погрешность округления, вероятность 1
+            for (size_t r : small) threshold_[r] = UINT32_MAX;
+            for (size_t r : large) threshold_[r] = UINT32_MAX;
+        }
+
+        size_t size() const { return alias_.size(); }
+
+        size_t sample(uint64_t r) const {
+            size_t cell = static_cast<size_t>(((r >> 32) * alias_.size()) >> 32);
+            return static_cast<uint32_t>(r) < threshold_[cell] ? cell : alias_[cell];
+        }
+
+    private:
+        std::vector<uint32_t> threshold_;   // доля ячейки, доставшаяся ее рангу, * 2^32
+        std::vector<size_t> alias_;
+
+        static uint32_t toThreshold(double p) {
+            return p >= 1.0 ? UINT32_MAX : static_cast<uint32_t>(p * 4294967296.0);
+        }
+    };
+
+    // Распределение столбцов ненулевых элементов в строке
+    enum class Pattern { Uniform, Zipf };
+
+    // В среднем density * cols ненулевых в строке (повторы столбцов
+    // схлопываются), значения из [0.5, 1.5). Zipf: столбец с номером r
+    // встречается с вероятностью ~ 1 / (r + 1)^exponent.
+    template <typename T>
+    CsrMatrix<T> sparseMatrix(size_t rows, size_t cols, double density, uint64_t seed,
+        Pattern pattern = Pattern::Uniform, unsigned threads = parallel::hardwareThreads(), double exponent = 1.0) {
+        double avgLen = std::max(0.0, density * static_cast<double>(cols));
+        size_t baseLen = static_cast<size_t>(avgLen);
+        double fraction = avgLen - static_cast<double>(baseLen);
+        ZipfTable zipf(pattern == Pattern::Zipf ? cols : 0, exponent);
+
+        auto bounds = parallel::uniformPartition(rows, threads);
+        size_t parts = bounds.size() - 1;
+        std::vector<std::vector<size_t>> partCols(parts);
+        std::vector<std::vector<T>> partValues(parts);
+        std::vector<size_t> rowPtr(rows + 1, 0);
+        parallel::forEachPart(bounds, [&](size_t part, size_t first, size_t last) {
+            auto& outCols = partCols[part];
+            auto& outValues = partValues[part];
+            outCols.reserve(static_cast<size_t>(avgLen * static_cast<double>(last - first)) + 1);
+            outValues.reserve(outCols.capacity());
+            std::vector<uint64_t> draws;
+            std::vector<size_t> rowCols;
+            for (size_t i = first; i < last; ++i) {
+                // Счетчики строки: 0 - длина, 1..len - столбцы, len + 1.. - значения
+                CounterRng rng(seed, i);
+                size_t len = baseLen + (rng.uniform(0) < fraction ? 1 : 0);
+                if (cols == 0) len = 0;
+                draws.resize(2 * len);
+                rng.fill(1, draws.data(), draws.size());
+                rowCols.resize(len);
+                for (size_t k = 0; k < len; ++k) {
+                    rowCols[k] = pattern == Pattern::Zipf ? zipf.sample(draws[k]) : below(draws[k], cols);
+                }
+                std::sort(rowCols.begin(), rowCols.end());
+                size_t unique = static_cast<size_t>(std::unique(rowCols.begin(), rowCols.end()) - rowCols.begin());
+                for (size_t k = 0; k < unique; ++k) {
+                    outCols.push_back(rowCols[k]);
+                    outValues.push_back(static_cast<T>(0.5 + toUnit(draws[len + k])));
+                }
+                rowPtr[i + 1] = unique;
+            }
+            });
+
+        std::vector<size_t> partOffset(parts + 1, 0);
+        for (size_t p = 0; p < parts; ++p) partOffset[p + 1] = partOffset[p] + partCols[p].size();
+        for (size_t i = 0; i < rows; ++i) rowPtr[i + 1] += rowPtr[i];
+        std::vector<size_t> colIdx(partOffset[parts]);
+        std::vector<T> values(partOffset[parts]);
+        parallel::forEachPart(bounds, [&](size_t part, size_t, size_t) {
+            std::copy(partCols[part].begin(), partCols[part].end(), colIdx.begin() + partOffset[part]);
+            std::copy(partValues[part].begin(), partValues[part].end(), values.begin() + partOffset[part]);
+            });
+        return CsrMatrix<T>(rows, cols, std::move(rowPtr), std::move(colIdx), std::move(values));
+    }
+
+    // Плотный вектор из [lo, hi): элемент i - счетчик i потока stream
+    template <typename T>
+    std::vector<T> denseVector(size_t n, uint64_t seed, double lo = 0.5, double hi = 1.5,
+        unsigned threads = parallel::hardwareThreads(), uint64_t stream = 0) {
+        std::vector<T> x(n);
+        CounterRng rng(seed, stream);
+        parallel::forEachPart(parallel::uniformPartition(n, threads), [&](size_t, size_t first, size_t last) {
+            // Пачками по 1024, чтобы fill векторизовался
+            uint64_t draws[1024];
+            for (size_t begin = first; begin < last; begin += 1024) {
+                size_t count = std::min<size_t>(1024, last - begin);
+                rng.fill(begin, draws, count);
+                for (size_t k = 0; k < count; ++k) {
+                    x[begin + k] = static_cast<T>(lo + (hi - lo) * toUnit(draws[k]));
+                }
+            }
+            });
+        return x;
+    }
+
+}
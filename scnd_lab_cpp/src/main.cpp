@@ -1,4 +1,6 @@
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <list>
 #include "myClass.hpp"
@@ -23,7 +25,24 @@ void processVector(std::vector<myClass>& vec) {
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+#ifdef MYCLASS_TRACE_RING
+    // Счетчики событий и дамп (./ScndLabCpp trace.bin) - после разрушения
+    // локальных объектов main, вне трассируемого кода
+    static std::string dumpPath = argc > 1 ? argv[1] : "";
+    std::atexit([] {
+        trace::summary(std::cout);
+        try {
+            if (!dumpPath.empty()) trace::dump(dumpPath);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+        });
+#else
+    (void)argc;
+    (void)argv;
+#endif
     std::cout << "Creating static and dynamic instances of myClass:\n";
 
     myClass A(2, 3);
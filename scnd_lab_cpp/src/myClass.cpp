@@ -1,21 +1,19 @@
 #include "myClass.hpp"
 
 myClass::myClass(int data, int priority) :root(new Node(data, priority)) {
-	std::cout << "Constructor was called with param: " << data << " " 
-		<< priority << std::endl;
+	traceEvent(trace::Event::Construct, nullptr);
 }
 
 myClass::myClass(const myClass& other) {
-	root = new Node(other.root->value, other.root->priority);
-	std::cout << "Copy constructor was called with param: " << root->value << " "
-		<< root->priority<< std::endl;
+	root = (other.root != nullptr) ? new Node(other.root->value, other.root->priority)
+		: nullptr;
+	traceEvent(trace::Event::Copy, &other);
 }
 
 myClass::myClass(myClass&& other) noexcept {
 	root = other.root;
 	other.root = nullptr;
-	std::cout << "Move constructor was called with param: " << root->value << " "
-		<< root->priority << std::endl;
+	traceEvent(trace::Event::Move, &other);
 }
 
 myClass& myClass::operator=(const myClass& other) {
@@ -24,8 +22,7 @@ myClass& myClass::operator=(const myClass& other) {
 		root = (other.root != nullptr) ? new Node(other.root->value, other.root->priority)
 			: nullptr;
 	}
-	std::cout << "Assignment operator was called with param : " << root->value << " "
-		<< root->priority << std::endl;
+	traceEvent(trace::Event::CopyAssign, &other);
 	return *this;
 }
 
@@ -35,16 +32,22 @@ myClass& myClass::operator=(myClass&& other) noexcept {
 		root = other.root;
 		other.root = nullptr;
 	}
-	std::cout << "Copy assignment operator was called with param : " << root->value << " "
-		<< root->priority << std::endl;
+	traceEvent(trace::Event::MoveAssign, &other);
 	return *this;
 }
 
 myClass::~myClass() { 
-	std::cout << "Destructor was called" << std::endl;
+	traceEvent(trace::Event::Destroy, nullptr);
 	delete root;
 }
 
+// С NoTrace тело пустое и вызов исчезает
+void myClass::traceEvent(trace::Event event, const void* source) const {
+	if constexpr (TracePolicy::enabled) {
+		TracePolicy::record(event, this, source, root ? root->value : 0, root ? root->priority : 0);
+	}
+}
+
 int myClass::getValue() const {
 	return root->value;
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream>
+#include "myTrace.hpp"
 
 class myClass {
 private:
@@ -12,6 +13,8 @@ private:
 
 	Node* root= nullptr;
 
+	void traceEvent(trace::Event event, const void* source) const;
+
 public:
 	myClass(int data = 0, int priority = 0);
 	myClass(const myClass& other);
@@ -0,0 +1,118 @@
+#include "myTrace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace trace {
+
+	namespace {
+
+		struct Registry {
+			std::mutex mutex;
+			std::vector<std::unique_ptr<Ring>> rings;
+		};
+
+		// Не разрушается: буферы нужны и деструкторам статических объектов
+		Registry& registry() {
+			static Registry* instance = new Registry();
+			return *instance;
+		}
+
+	}
+
+	const char* eventName(Event e) {
+		switch (e) {
+		case Event::Construct: return "ctor";
+		case Event::Copy: return "copy";
+		case Event::Move: return "move";
+		case Event::CopyAssign: return "copy-assign";
+		case Event::MoveAssign: return "move-assign";
+		case Event::Destroy: return "dtor";
+		}
+		return "unknown";
+	}
+
+	Ring& localRing() {
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		r.rings.push_back(std::make_unique<Ring>(r.rings.size()));
+		return *r.rings.back();
+	}
+
+	void ConsoleTrace::record(Event e, const void*, const void*, int value, int priority) {
+		switch (e) {
+		case Event::Construct:
+			std::cout << "Constructor was called with param: " << value << " " << priority << '\n';
+			break;
+		case Event::Copy:
+			std::cout << "Copy constructor was called with param: " << value << " " << priority << '\n';
+			break;
+		case Event::Move:
+			std::cout << "Move constructor was called with param: " << value << " " << priority << '\n';
+			break;
+		case Event::CopyAssign:
+			std::cout << "Assignment operator was called with param : " << value << " " << priority << '\n';
+			break;
+		case Event::MoveAssign:
+			std::cout << "Move assignment operator was called with param : " << value << " " << priority << '\n';
+			break;
+		case Event::Destroy:
+			std::cout << "Destructor was called" << '\n';
+			break;
+		}
+	}
+
+	Counters counters() {
+		Counters result;
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		for (const auto& ring : r.rings) {
+			for (size_t e = 0; e < eventCount; ++e) result.counts[e] += ring->count(static_cast<Event>(e));
+			uint64_t written = ring->written();
+			result.recorded += written;
+			if (written > Ring::capacity) result.overwritten += written - Ring::capacity;
+		}
+		return result;
+	}
+
+	void summary(std::ostream& out) {
+		Counters c = counters();
+		out << "Lifecycle events:";
+		for (size_t e = 0; e < eventCount; ++e) {
+			out << " " << eventName(static_cast<Event>(e)) << "=" << c.counts[e];
+		}
+		out << " (recorded " << c.recorded << ", overwritten " << c.overwritten << ")" << std::endl;
+	}
+
+	void dump(const std::string& path) {
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("Cannot open file: " + path);
+		}
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		// Снимок числа записей, чтобы заголовок совпал с содержимым
+		std::vector<uint64_t> written(r.rings.size());
+		uint64_t total = 0;
+		for (size_t i = 0; i < r.rings.size(); ++i) {
+			written[i] = r.rings[i]->written();
+			total += std::min<uint64_t>(written[i], Ring::capacity);
+		}
+		file.write("MYTRACE1", 8);
+		file.write(reinterpret_cast<const char*>(&total), sizeof(total));
+		for (size_t i = 0; i < r.rings.size(); ++i) {
+			uint64_t first = written[i] > Ring::capacity ? written[i] - Ring::capacity : 0;
+			uint64_t thread = r.rings[i]->thread();
+			for (uint64_t k = first; k < written[i]; ++k) {
+				file.write(reinterpret_cast<const char*>(&thread), sizeof(thread));
+				file.write(reinterpret_cast<const char*>(&r.rings[i]->at(k)), sizeof(Record));
+			}
+		}
+		if (!file) {
+			throw std::runtime_error("Cannot write file: " + path);
+		}
+	}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Трассировка жизненного цикла объектов (конструктор, копирование,
+// перемещение, присваивания, деструктор). Политика выбирается при сборке:
+//  - NoTrace: record пустая и не вызывается (if constexpr) - кода нет;
+//  - RingTrace: запись (время, адрес, источник, событие) в кольцевой буфер
+//    своего потока без блокировок и счетчики событий; вывод счетчиков и
+//    двоичный дамп делаются потом, вне горячего пути (summary, dump);
+//  - ConsoleTrace: сообщения в std::cout, как раньше, но без сброса буфера.
+
+namespace trace {
+
+	enum class Event : uint8_t { Construct, Copy, Move, CopyAssign, MoveAssign, Destroy };
+
+	constexpr size_t eventCount = 6;
+
+	const char* eventName(Event e);
+
+	struct Record {
+		uint64_t nanos;             // steady_clock с начала эпохи часов
+		const void* object;
+		const void* source;         // объект-источник копирования / перемещения
+		int value;
+		int priority;
+		Event event;
+	};
+
+	// Буфер одного потока: пишет только владелец, читают summary / dump.
+	// При переполнении старые записи перезаписываются, счетчики - точные.
+	class Ring {
+	public:
+		static constexpr size_t capacity = size_t{ 1 } << 16;
+
+		explicit Ring(size_t thread) :thread_(thread), records_(new Record[capacity]) {
+			for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+		}
+
+		void push(const Record& r) {
+			uint64_t head = head_.load(std::memory_order_relaxed);
+			records_[head & (capacity - 1)] = r;
+			head_.store(head + 1, std::memory_order_release);
+			// Один писатель: без атомарного RMW
+			auto& count = counts_[static_cast<size_t>(r.event)];
+			count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		size_t thread() const { return thread_; }
+		uint64_t written() const { return head_.load(std::memory_order_acquire); }
+		uint64_t count(Event e) const { return counts_[static_cast<size_t>(e)].load(std::memory_order_relaxed); }
+		const Record& at(uint64_t index) const { return records_[index & (capacity - 1)]; }
+
+	private:
+		size_t thread_;
+		std::unique_ptr<Record[]> records_;
+		std::atomic<uint64_t> head_{ 0 };
+		std::array<std::atomic<uint64_t>, eventCount> counts_;
+	};
+
+	// Буфер потока создается при первой записи и живет до конца программы
+	Ring& localRing();
+
+	struct NoTrace {
+		static constexpr bool enabled = false;
+		static void record(Event, const void*, const void*, int, int) {}
+	};
+
+	struct RingTrace {
+		static constexpr bool enabled = true;
+		static void record(Event e, const void* object, const void* source, int value, int priority) {
+			thread_local Ring& ring = localRing();
+			uint64_t nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+			ring.push({ nanos, object, source, value, priority, e });
+		}
+	};
+
+	struct ConsoleTrace {
+		static constexpr bool enabled = true;
+		static void record(Event e, const void* object, const void* source, int value, int priority);
+	};
+
+	// Сумма по всем потокам
+	struct Counters {
+		std::array<uint64_t, eventCount> counts{};
+		uint64_t recorded = 0;      // записано в буферы
+		uint64_t overwritten = 0;   // потеряно при переполнении
+
+		uint64_t operator[](Event e) const { return counts[static_cast<size_t>(e)]; }
+	};
+
+	Counters counters();
+	void summary(std::ostream& out);
+
+	// Двоичный дамп: "MYTRACE1", число записей (uint64), затем записи
+	// потоков как (номер потока uint64, Record). Точен, если пишущие потоки
+	// остановлены; иначе последние записи могут быть неполными.
+	void dump(const std::string& path);
+
+}
+
+// MYCLASS_TRACE_NONE / MYCLASS_TRACE_RING (make TRACE=none|ring), иначе консоль
+#if defined(MYCLASS_TRACE_NONE)
+using TracePolicy = trace::NoTrace;
+#elif defined(MYCLASS_TRACE_RING)
+using TracePolicy = trace::RingTrace;
+#else
+using TracePolicy = trace::ConsoleTrace;
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "myWorkload.hpp"
+
+// Общие части бенчмарков thd_lab_cpp: параметры запуска, замер медианы,
+// генерация элементов, проверки для режима --check
+namespace bench {
+
+    struct Options {
+        int reps = 5;
+        unsigned seed = 20241019;
+        bool quick = false;
+        std::string filter;     // подстрока имени раздела
+        bool check = false;     // сверка результатов с std:: вместо замеров
+    };
+
+    // Условие проверки --check; при нарушении - исключение с описанием
+    inline void expect(bool ok, const std::string& what) {
+        if (!ok) {
+            throw std::runtime_error("Check failed: " + what);
+        }
+    }
+
+    // Медиана времени reps запусков f, мс
+    template <typename F>
+    double medianMs(int reps, F f) {
+        std::vector<double> times;
+        for (int r = 0; r < reps; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto stop = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    // value из 1..100, priority из 1..1000, как в main.cpp (myWorkload.hpp)
+    template <typename Item>
+    std::vector<Item> makeItems(size_t n, unsigned seed) {
+        return workload::makeItems<Item>(n, seed);
+    }
+
+    // Разделы (по одному файлу в bench/): замеры и проверки
+    void runPipelineBench(const Options& options);
+    void checkPipeline(const Options& options);
+    void runQueueBench(const Options& options);
+    void checkQueue(const Options& options);
+    void runTopKBench(const Options& options);
+    void checkTopK(const Options& options);
+    void runEraseBench(const Options& options);
+    void checkErase(const Options& options);
+    void runSetOpsBench(const Options& options);
+    void checkSetOps(const Options& options);
+    void runListBench(const Options& options);
+    void checkList(const Options& options);
+    void runWorkloadBench(const Options& options);
+
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "benchCommon.hpp"
+
+// Запуск: ./ThdLabBench [--quick] [--check] [--reps N] [--seed S] [--filter pipeline|queue|topk|erase|setops|list|workload]
+// --check вместо замеров сверяет результаты разделов с эталонами из std::
+// (std::priority_queue, std::list, std::stable_sort, std::set_*) и
+// завершается с кодом 1 при первом расхождении.
+
+namespace {
+
+    struct Section {
+        const char* name;
+        void (*run)(const bench::Options&);
+        void (*check)(const bench::Options&);     // nullptr - проверок нет
+    };
+
+    const Section sections[] = {
+        { "pipeline", bench::runPipelineBench, bench::checkPipeline },
+        { "queue", bench::runQueueBench, bench::checkQueue },
+        { "topk", bench::runTopKBench, bench::checkTopK },
+        { "erase", bench::runEraseBench, bench::checkErase },
+        { "setops", bench::runSetOpsBench, bench::checkSetOps },
+        { "list", bench::runListBench, bench::checkList },
+        { "workload", bench::runWorkloadBench, nullptr },
+    };
+
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            options.quick = true;
+        }
+        else if (std::strcmp(argv[i], "--check") == 0) {
+            options.check = true;
+        }
+        else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            options.reps = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--check] [--reps N] [--seed S] [--filter pipeline|queue|topk|erase|setops|list|workload]"
+                << std::endl;
+            return 1;
+        }
+    }
+
+    for (const Section& section : sections) {
+        if (!options.filter.empty() && std::string(section.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (!options.check) {
+            std::cout << "== " << section.name << " ==" << std::endl;
+            section.run(options);
+            continue;
+        }
+        if (!section.check) continue;
+        try {
+            section.check(options);
+        }
+        catch (const std::exception& e) {
+            std::cerr << section.name << ": " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << section.name << ": ok" << std::endl;
+    }
+    return 0;
+}
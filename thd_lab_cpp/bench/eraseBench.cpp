@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myBulkErase.hpp"
+#include "myWorkload.hpp"
+#include "benchCommon.hpp"
+
+// Удаление элементов с ключами из S (задание 5 на больших размерах):
+// std::set + remove_if против KeySet с каждой стратегией и на 1..4 потоках.
+// Ключи - приоритеты 1..1000 ("dense") либо приоритет * 1000003 ("spread"),
+// где битовая карта не подходит. Время включает копирование вектора
+// (строка "copy").
+// Проверка (--check): каждая стратегия на 1..4 потоках против std::set +
+// remove_if - те же элементы в том же порядке; KeySet::contains против
+// std::set::count на ключах внутри и вне множества.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+
+    template <typename Item>
+    void runItem(const std::string& itemName, size_t n, size_t k, bool spread, const Options& options) {
+        std::vector<Item> items = bench::makeItems<Item>(n, options.seed);
+        workload::Xoshiro256 gen(options.seed + 1);
+        std::vector<long long> keys;
+        for (size_t i = 0; i < k; ++i) {
+            long long key = items[gen() % n].getPriority();
+            keys.push_back(spread ? key * 1000003 : key);
+        }
+        auto keyOf = [spread](const Item& x) {
+            return spread ? static_cast<long long>(x.getPriority()) * 1000003 : x.getPriority();
+        };
+        volatile size_t sink = 0;
+        std::string suffix = std::string(spread ? " spread" : " dense") + "<" + itemName + ">";
+        auto report = [&](const std::string& name, double ms) {
+            std::cout << std::left << std::setw(36) << name + suffix << std::setw(10) << n
+                << std::setw(8) << k << std::fixed << std::setprecision(3) << ms << std::endl;
+        };
+
+        report("copy", medianMs(options.reps, [&] {
+            std::vector<Item> v = items;
+            sink = sink + v.size();
+            }));
+        report("set+remove_if", medianMs(options.reps, [&] {
+            std::vector<Item> v = items;
+            std::set<long long> s(keys.begin(), keys.end());
+            v.erase(std::remove_if(v.begin(), v.end(), [&](const Item& x) {
+                return s.find(keyOf(x)) != s.end();
+                }), v.end());
+            sink = sink + v.size();
+            }));
+        struct Case {
+            const char* name;
+            EraseStrategy strategy;
+        };
+        for (Case c : { Case{ "sorted", EraseStrategy::Sorted }, Case{ "hash", EraseStrategy::Hash },
+            Case{ "bitmap", EraseStrategy::Bitmap }, Case{ "auto", EraseStrategy::Auto } }) {
+            if (spread && c.strategy == EraseStrategy::Bitmap) continue;
+            for (unsigned threads : { 1u, 4u }) {
+                if (threads > 1 && c.strategy != EraseStrategy::Auto) continue;
+                report(std::string(c.name) + " x" + std::to_string(threads), medianMs(options.reps, [&] {
+                    std::vector<Item> v = items;
+                    sink = sink + eraseIfKeyIn(v, keys, keyOf, c.strategy, threads);
+                    }));
+            }
+        }
+    }
+
+
+    // Отображения приоритета в ключ: узкий диапазон, отрицательные ключи
+    // (смещение от минимума у знаковых), широкий - только Sorted и Hash
+    struct KeyMap {
+        const char* name;
+        long long scale;
+        long long shift;
+        bool bitmap;
+    };
+
+    template <typename Item>
+    void checkItem(const std::string& itemName, size_t n, size_t k, const KeyMap& map, const Options& options) {
+        std::vector<Item> items = bench::makeItems<Item>(n, options.seed + static_cast<unsigned>(n + k));
+        auto keyOf = [map](const Item& x) { return (x.getPriority() - map.shift) * map.scale; };
+        // Половина ключей - из элементов, половина - случайные (в том числе вне приоритетов)
+        workload::Xoshiro256 rng(options.seed + k);
+        std::vector<long long> keys;
+        for (size_t i = 0; i < k; ++i) {
+            long long priority = n && i % 2 == 0 ? items[rng() % n].getPriority() : workload::uniformInt(rng(), -100, 1100);
+            keys.push_back((priority - map.shift) * map.scale);
+        }
+        std::set<long long> reference(keys.begin(), keys.end());
+        std::vector<Item> expected = items;
+        expected.erase(std::remove_if(expected.begin(), expected.end(), [&](const Item& x) {
+            return reference.count(keyOf(x)) != 0; }), expected.end());
+
+        std::string where = " " + std::string(map.name) + "<" + itemName + "> (n " + std::to_string(n)
+            + ", k " + std::to_string(k) + ")";
+        struct Case {
+            const char* name;
+            EraseStrategy strategy;
+        };
+        for (Case c : { Case{ "sorted", EraseStrategy::Sorted }, Case{ "hash", EraseStrategy::Hash },
+            Case{ "bitmap", EraseStrategy::Bitmap }, Case{ "auto", EraseStrategy::Auto } }) {
+            if (!map.bitmap && c.strategy == EraseStrategy::Bitmap) continue;
+            KeySet<long long> set(keys.begin(), keys.end(), c.strategy);
+            bench::expect(set.size() == reference.size() && set.strategy() != EraseStrategy::Auto,
+                std::string("KeySet size ") + c.name + where);
+            bool sameContains = true;
+            for (long long priority = -200; priority <= 1200; ++priority) {
+                long long key = (priority - map.shift) * map.scale;
+                sameContains = sameContains && set.contains(key) == (reference.count(key) != 0);
+            }
+            bench::expect(sameContains, std::string("KeySet::contains ") + c.name + where);
+
+            for (unsigned threads : { 1u, 2u, 3u, 4u }) {
+                std::vector<Item> v = items;
+                size_t removed = eraseIfKeyIn(v, keys, keyOf, c.strategy, threads);
+                bool same = removed == n - expected.size() && v.size() == expected.size();
+                for (size_t i = 0; same && i < v.size(); ++i) {
+                    same = v[i].getValue() == expected[i].getValue() && v[i].getPriority() == expected[i].getPriority();
+                }
+                bench::expect(same, std::string("eraseIfKeyIn ") + c.name + " x" + std::to_string(threads) + where);
+            }
+        }
+    }
+
+}
+
+void bench::checkErase(const Options& options) {
+    std::vector<size_t> sizes = { 0, 1, 5000, 100000 };
+    if (!options.quick) sizes.push_back(1000000);
+    for (size_t n : sizes) {
+        std::vector<size_t> ks = { 0, 1, 16, 17, 50, 500, 5000 };
+        if (n > 100000) ks = { 17, 5000 };
+        for (size_t k : ks) {
+            for (const KeyMap& map : { KeyMap{ "dense", 1, 0, true }, KeyMap{ "negative", 1, 500, true },
+                KeyMap{ "spread", 1000003, 500, false } }) {
+                checkItem<myClass>("myClass", n, k, map, options);
+                checkItem<myClassInline>("myClassInline", n, k, map, options);
+            }
+        }
+    }
+}
+
+void bench::runEraseBench(const Options& options) {
+    std::vector<size_t> sizes = { 100000, 1000000, 10000000 };
+    if (options.quick) sizes = { 100000 };
+
+    std::cout << std::left << std::setw(36) << "removal" << std::setw(10) << "n" << std::setw(8) << "k"
+        << "ms" << std::endl;
+    for (size_t n : sizes) {
+        for (size_t k : { 50, 500 }) {
+            for (bool spread : { false, true }) {
+                runItem<myClass>("myClass", n, k, spread, options);
+                runItem<myClassInline>("myClassInline", n, k, spread, options);
+            }
+        }
+    }
+}
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myPooledList.hpp"
+#include "myWorkload.hpp"
+#include "myZip.hpp"
+#include "benchCommon.hpp"
+
+// Задания 6, 7 и 9 на больших списках: std::list против myPooledList.
+//  - task6: среднее приоритетов и сортировка по убыванию;
+//  - task7: удаление элементов с нечетным приоритетом;
+//  - task9: удаление первой половины и список пар с другим списком;
+//  - task9z: то же через zip-представление (myZip.hpp) без копий.
+// Построение списка в замер не входит (строка "build" - отдельно).
+// Проверка (--check): случайные вставки, удаления, splice (с общим и с
+// разными пулами), remove_if и sort повторяются на std::list, содержимое
+// сверяется в обе стороны после каждой операции; zip-представления разной
+// длины и выравнивания сверяются с парами, выписанными по индексам.
+
+namespace {
+
+    using bench::Options;
+
+    // Медиана reps запусков f(list) на свежем списке из items, мс
+    template <typename List, typename Item, typename F>
+    double measureList(const std::vector<Item>& items, int reps, F f) {
+        std::vector<double> times;
+        for (int r = 0; r < reps; ++r) {
+            List list(items.begin(), items.end());
+            auto start = std::chrono::steady_clock::now();
+            f(list);
+            auto stop = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    template <template <typename> class List, typename Item>
+    void runTasks(const std::string& name, const std::vector<Item>& items, const Options& options) {
+        volatile double sink = 0;
+        auto report = [&](const std::string& task, double ms) {
+            std::cout << std::left << std::setw(34) << name << std::setw(8) << task << std::setw(10) << items.size()
+                << std::fixed << std::setprecision(3) << ms << std::endl;
+        };
+
+        report("build", bench::medianMs(options.reps, [&] {
+            List<Item> list(items.begin(), items.end());
+            sink = sink + list.size();
+            }));
+        report("task6", measureList<List<Item>>(items, options.reps, [&](List<Item>& list) {
+            double avg = std::accumulate(list.begin(), list.end(), 0.0, [](double sum, const Item& x) {
+                return sum + x.getPriority();
+                }) / list.size();
+            list.sort([](const Item& a, const Item& b) { return a.getPriority() > b.getPriority(); });
+            sink = sink + avg;
+            }));
+        report("task7", measureList<List<Item>>(items, options.reps, [&](List<Item>& list) {
+            list.remove_if([](const Item& x) { return x.getPriority() % 2 != 0; });
+            sink = sink + list.size();
+            }));
+        List<Item> other(items.rbegin(), items.rbegin() + items.size() / 2);
+        report("task9", measureList<List<Item>>(items, options.reps, [&](List<Item>& list) {
+            auto it = list.begin();
+            std::advance(it, list.size() - other.size());
+            list.erase(list.begin(), it);
+            List<std::pair<Item, Item>> pairs;
+            std::transform(list.begin(), list.end(), other.begin(), std::back_inserter(pairs),
+                [](const Item& a, const Item& b) { return std::make_pair(a, b); });
+            sink = sink + pairs.size();
+            }));
+        report("task9z", measureList<List<Item>>(items, options.reps, [&](List<Item>& list) {
+            auto pairs = zip(list, other, ZipAlign::Back);
+            long long sum = 0;
+            for (auto p : pairs) sum += p.first.getPriority() + p.second.getPriority();
+            sink = sink + sum;
+            }));
+    }
+
+    template <typename T>
+    using StdList = std::list<T>;
+
+    // Те же элементы в том же порядке, в том числе при обходе с конца
+    template <typename Item>
+    bool sameList(const myPooledList<Item>& list, const std::list<Item>& expected) {
+        auto same = [](const Item& a, const Item& b) {
+            return a.getValue() == b.getValue() && a.getPriority() == b.getPriority();
+        };
+        return list.size() == expected.size()
+            && std::equal(list.begin(), list.end(), expected.begin(), expected.end(), same)
+            && std::equal(std::make_reverse_iterator(list.end()), std::make_reverse_iterator(list.begin()),
+                expected.rbegin(), expected.rend(), same);
+    }
+
+    // Итератор на позицию i (i <= size)
+    template <typename List>
+    typename List::iterator at(List& list, size_t i) {
+        return std::next(list.begin(), static_cast<std::ptrdiff_t>(i));
+    }
+
+    // Списки a и b на общем пуле, c - на своем; у std:: - те же операции.
+    // value элемента - его номер, приоритеты из 1..20: sort проверяется на
+    // устойчивость при многих равных
+    template <typename Item>
+    void checkList(const std::string& itemName, size_t ops, uint64_t seed) {
+        myPooledList<Item> a;
+        myPooledList<Item> b(a.pool());
+        myPooledList<Item> c;
+        myPooledList<Item>* lists[] = { &a, &b, &c };
+        std::list<Item> ea, eb, ec;
+        std::list<Item>* expected[] = { &ea, &eb, &ec };
+        workload::Xoshiro256 rng(seed);
+        int next = 0;
+        auto random = [&](size_t bound) { return static_cast<size_t>(rng() % bound); };
+        auto byPriority = [](const Item& x, const Item& y) { return x.getPriority() < y.getPriority(); };
+
+        for (size_t i = 0; i < ops; ++i) {
+            size_t l = random(3);
+            myPooledList<Item>& list = *lists[l];
+            std::list<Item>& ref = *expected[l];
+            uint64_t op = rng() % 16;
+            std::string what;
+            if (op < 8 || ref.empty()) {
+                what = "insert";
+                Item item(next++, workload::uniformInt(rng(), 1, 20));
+                size_t pos = random(ref.size() + 1);
+                list.insert(at(list, pos), item);
+                ref.insert(at(ref, pos), item);
+            }
+            else if (op < 9) {
+                what = "erase";
+                size_t first = random(ref.size());
+                size_t last = first + random(std::min<size_t>(ref.size() - first, 8) + 1);
+                list.erase(at(list, first), at(list, last));
+                ref.erase(at(ref, first), at(ref, last));
+            }
+            else if (op < 10) {
+                what = "remove_if";
+                int divisor = workload::uniformInt(rng(), 2, 7);
+                auto pred = [divisor](const Item& x) { return x.getPriority() % divisor == 0; };
+                size_t before = ref.size();
+                size_t removed = list.remove_if(pred);
+                ref.remove_if(pred);
+                bench::expect(removed == before - ref.size(), "remove_if count<" + itemName + ">");
+            }
+            else if (op < 12) {
+                what = "sort";
+                // Итератор остается на том же элементе: переставляются узлы
+                size_t pos = random(ref.size());
+                auto held = at(list, pos);
+                int value = held->getValue();
+                list.sort(byPriority);
+                ref.sort(byPriority);
+                bench::expect(held->getValue() == value, "iterator after sort<" + itemName + ">");
+            }
+            else if (op < 14) {
+                what = "splice all";
+                size_t from = random(3);
+                if (from == l) continue;
+                size_t pos = random(ref.size() + 1);
+                list.splice(at(list, pos), *lists[from]);
+                ref.splice(at(ref, pos), *expected[from]);
+            }
+            else {
+                what = "splice one";
+                size_t from = random(3);
+                if (expected[from]->empty()) continue;
+                size_t it = random(expected[from]->size());
+                size_t pos = random(ref.size() + 1);
+                list.splice(at(list, pos), *lists[from], at(*lists[from], it));
+                ref.splice(at(ref, pos), *expected[from], at(*expected[from], it));
+            }
+            for (size_t k = 0; k < 3; ++k) {
+                bench::expect(sameList(*lists[k], *expected[k]),
+                    what + " against std::list<" + itemName + "> at operation " + std::to_string(i));
+            }
+        }
+    }
+
+    // Пары zip(a, b, align) против выписанных по индексам; запись через пару
+    // меняет элементы самих диапазонов
+    template <typename Range1, typename Range2>
+    void checkZip(const std::string& name, size_t n1, size_t n2) {
+        for (ZipAlign align : { ZipAlign::Front, ZipAlign::Back }) {
+            Range1 a;
+            Range2 b;
+            for (size_t i = 0; i < n1; ++i) a.push_back(static_cast<int>(i));
+            for (size_t i = 0; i < n2; ++i) b.push_back(static_cast<int>(1000 + i));
+            size_t n = std::min(n1, n2);
+            size_t skip1 = align == ZipAlign::Back ? n1 - n : 0;
+            size_t skip2 = align == ZipAlign::Back ? n2 - n : 0;
+            std::string where = " " + name + (align == ZipAlign::Back ? " back" : " front") + " ("
+                + std::to_string(n1) + ", " + std::to_string(n2) + ")";
+
+            auto view = zip(a, b, align);
+            bool same = view.size() == n && static_cast<size_t>(std::distance(view.begin(), view.end())) == n;
+            size_t i = 0;
+            for (auto it = view.begin(); it != view.end(); ++it, ++i) {
+                same = same && i < n && it->first == static_cast<int>(skip1 + i) && it->second == static_cast<int>(1000 + skip2 + i);
+                it->first = -1;
+                (*it).second = -1;
+            }
+            bench::expect(same && i == n, "zip pairs" + where);
+            // Конец выровнен в обоих диапазонах
+            bench::expect(std::distance(view.begin().first(), view.end().first()) == static_cast<std::ptrdiff_t>(n)
+                && std::distance(view.begin().second(), view.end().second()) == static_cast<std::ptrdiff_t>(n),
+                "zip end alignment" + where);
+            std::vector<int> written1, written2;
+            for (size_t k = 0; k < n1; ++k) written1.push_back(k >= skip1 && k < skip1 + n ? -1 : static_cast<int>(k));
+            for (size_t k = 0; k < n2; ++k) written2.push_back(k >= skip2 && k < skip2 + n ? -1 : static_cast<int>(1000 + k));
+            bench::expect(std::equal(a.begin(), a.end(), written1.begin(), written1.end())
+                && std::equal(b.begin(), b.end(), written2.begin(), written2.end()), "zip writes through references" + where);
+
+            if constexpr (std::is_same_v<Range1, std::vector<int>> && std::is_same_v<Range2, std::vector<int>>) {
+                bool random = view.end() - view.begin() == static_cast<std::ptrdiff_t>(n);
+                for (size_t k = 0; k < n; ++k) random = random && &view.begin()[k].first == &a[skip1 + k];
+                bench::expect(random, "zip random access" + where);
+            }
+        }
+    }
+
+    void checkZip() {
+        for (auto [n1, n2] : { std::pair<size_t, size_t>{ 0, 0 }, { 0, 5 }, { 5, 0 }, { 1, 1 }, { 7, 7 }, { 10, 3 }, { 3, 10 } }) {
+            checkZip<std::vector<int>, std::vector<int>>("vector/vector", n1, n2);
+            checkZip<std::list<int>, std::vector<int>>("list/vector", n1, n2);
+            checkZip<myPooledList<int>, std::list<int>>("myPooledList/list", n1, n2);
+        }
+    }
+
+}
+
+void bench::checkList(const Options& options) {
+    const size_t ops = options.quick ? 20000 : 100000;
+    ::checkList<myClass>("myClass", ops, options.seed);
+    ::checkList<myClassInline>("myClassInline", ops, options.seed + 1);
+    checkZip();
+}
+
+void bench::runListBench(const Options& options) {
+    std::vector<size_t> sizes = { 100000, 1000000 };
+    if (options.quick) sizes = { 100000 };
+
+    std::cout << std::left << std::setw(34) << "list" << std::setw(8) << "task" << std::setw(10) << "n"
+        << "ms" << std::endl;
+    for (size_t n : sizes) {
+        std::vector<myClass> heapItems = makeItems<myClass>(n, options.seed);
+        std::vector<myClassInline> flatItems = makeItems<myClassInline>(n, options.seed);
+        runTasks<StdList>("std::list<myClass>", heapItems, options);
+        runTasks<myPooledList>("myPooledList<myClass>", heapItems, options);
+        runTasks<StdList>("std::list<myClassInline>", flatItems, options);
+        runTasks<myPooledList>("myPooledList<myClassInline>", flatItems, options);
+    }
+}
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myClassColumns.hpp"
+#include "myPipeline.hpp"
+#include "benchCommon.hpp"
+
+// Сравнение myClass (Node в куче) и myClassInline (поля в объекте):
+// конвейер заданий из main() на больших векторах (pipeline x4 - на 4 потоках),
+// сортировка и копирование.
+// Вторая таблица - операции заданий 6-8 (среднее, удаление нечетных,
+// сортировка) для std::vector обоих классов и myClassColumns.
+// Проверка (--check): конвейер для myClass и myClassInline (в том числе на 4
+// потоках) печатает то же, что myClass на одном потоке,
+// операции myClassColumns совпадают с std:: над std::vector<myClassInline>.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+    using bench::makeItems;
+
+    template <typename Item>
+    double measure(const std::string& name, size_t n, const Options& options) {
+        volatile size_t sink = 0;
+        if (name.compare(0, 8, "pipeline") == 0) {
+            PipelineConfig config;
+            config.minSize = static_cast<int>(n);
+            config.maxSize = static_cast<int>(n);
+            config.threads = name == "pipeline x4" ? 4 : 1;
+            std::ostream silent(nullptr);
+            return medianMs(options.reps, [&] {
+                sink = sink + runPipeline<Item>(options.seed, silent, config).v3;
+                });
+        }
+        std::vector<Item> items = makeItems<Item>(n, options.seed);
+        if (name == "sort") {
+            return medianMs(options.reps, [&] {
+                std::vector<Item> copy = items;
+                std::sort(copy.begin(), copy.end(), [](const Item& a, const Item& b) {
+                    return a.getPriority() < b.getPriority();
+                    });
+                sink = sink + copy.front().getValue();
+                });
+        }
+        return medianMs(options.reps, [&] {
+            std::vector<Item> copy = items;
+            sink = sink + copy.back().getValue();
+            });
+    }
+
+
+    // Операции над контейнером: std::vector<Item> через алгоритмы STL
+    template <typename Container>
+    double measureColumns(const std::string& name, const Container& items, const Options& options) {
+        volatile double sink = 0;
+        using Item = typename Container::value_type;
+        if (name == "average") {
+            return medianMs(options.reps, [&] {
+                sink = sink + std::accumulate(items.begin(), items.end(), 0.0, [](double sum, const Item& x) {
+                    return sum + x.getPriority();
+                    }) / items.size();
+                });
+        }
+        if (name == "filter") {
+            return medianMs(options.reps, [&] {
+                Container copy = items;
+                copy.erase(std::remove_if(copy.begin(), copy.end(), [](const Item& x) {
+                    return x.getPriority() % 2 != 0;
+                    }), copy.end());
+                sink = sink + copy.size();
+                });
+        }
+        return medianMs(options.reps, [&] {
+            Container copy = items;
+            std::sort(copy.begin(), copy.end());
+            sink = sink + copy.size();
+            });
+    }
+
+    // Те же операции встроенными методами myClassColumns
+    double measureColumns(const std::string& name, const myClassColumns& items, const Options& options) {
+        volatile double sink = 0;
+        if (name == "average") {
+            return medianMs(options.reps, [&] { sink = sink + items.averagePriority(); });
+        }
+        if (name == "filter") {
+            return medianMs(options.reps, [&] {
+                myClassColumns copy = items;
+                copy.removeIf([](int priority) { return priority % 2 != 0; });
+                sink = sink + copy.size();
+                });
+        }
+        return medianMs(options.reps, [&] {
+            myClassColumns copy = items;
+            copy.sortByPriority();
+            sink = sink + copy.size();
+            });
+    }
+
+
+    // Поля совпадают поэлементно (operator== у элементов сравнивает только приоритет)
+    template <typename Range>
+    bool sameItems(const myClassColumns& columns, const Range& expected) {
+        if (columns.size() != expected.size()) return false;
+        size_t i = 0;
+        for (const auto& x : expected) {
+            if (columns[i].getValue() != x.getValue() || columns[i].getPriority() != x.getPriority()) return false;
+            ++i;
+        }
+        return true;
+    }
+
+    void checkColumns(const Options& options) {
+        static_assert(std::is_same_v<decltype(*std::declval<const myClassColumns&>().begin()), myClassInline>,
+            "Const iterator must not give mutable access");
+        auto byPriority = [](const myClassInline& a, const myClassInline& b) { return a.getPriority() < b.getPriority(); };
+        auto odd = [](int priority) { return priority % 2 != 0; };
+        for (size_t n : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, size_t{ 200000 } }) {
+            std::vector<myClassInline> narrow = makeItems<myClassInline>(n, options.seed);
+            // Широкий диапазон (сортировка упакованных ключей) с теми же повторами
+            std::vector<myClassInline> wide = narrow;
+            for (auto& x : wide) x.setPriority() = (x.getPriority() - 500) * 2000003;
+            for (const auto* items : { &narrow, &wide }) {
+                std::string where = " (n " + std::to_string(n) + (items == &wide ? ", wide)" : ", narrow)");
+                myClassColumns columns(items->begin(), items->end());
+                bench::expect(sameItems(columns, *items), "myClassColumns construction" + where);
+
+                std::vector<myClassInline> sorted = *items;
+                std::stable_sort(sorted.begin(), sorted.end(), byPriority);
+                myClassColumns sortedColumns = columns;
+                sortedColumns.sortByPriority();
+                bench::expect(sameItems(sortedColumns, sorted), "sortByPriority against std::stable_sort" + where);
+
+                // std::sort через итераторы-ссылки: те же приоритеты по порядку
+                myClassColumns stdSorted = columns;
+                std::sort(stdSorted.begin(), stdSorted.end());
+                bool samePriorities = true;
+                for (size_t i = 0; i < n; ++i) samePriorities = samePriorities && stdSorted[i].getPriority() == sorted[i].getPriority();
+                bench::expect(samePriorities, "std::sort over myClassColumns iterators" + where);
+
+                std::vector<myClassInline> kept = *items;
+                kept.erase(std::remove_if(kept.begin(), kept.end(), [&](const myClassInline& x) {
+                    return odd(x.getPriority()); }), kept.end());
+                myClassColumns removed = columns;
+                bench::expect(removed.removeIf(odd) == n - kept.size() && sameItems(removed, kept),
+                    "removeIf against std::remove_if" + where);
+                myClassColumns erased = columns;
+                erased.erase(std::remove_if(erased.begin(), erased.end(), [&](const myClassInline& x) {
+                    return odd(x.getPriority()); }), erased.cend());
+                bench::expect(sameItems(erased, kept), "erase(remove_if) over myClassColumns" + where);
+
+                std::vector<myClassInline> chosen;
+                std::copy_if(items->begin(), items->end(), std::back_inserter(chosen), [&](const myClassInline& x) {
+                    return !odd(x.getPriority()); });
+                bench::expect(sameItems(columns.select([&](int p) { return !odd(p); }), chosen),
+                    "select against std::copy_if" + where);
+
+                if (n == 0) continue;
+                long long sum = 0;
+                for (const auto& x : *items) sum += x.getPriority();
+                auto [lo, hi] = std::minmax_element(items->begin(), items->end(), byPriority);
+                bench::expect(columns.sumPriorities() == sum && columns.minPriority() == lo->getPriority()
+                    && columns.maxPriority() == hi->getPriority(), "sum / min / max of priorities" + where);
+                double avg = std::accumulate(columns.begin(), columns.end(), 0.0, [](double acc, const myClassInline& x) {
+                    return acc + x.getPriority(); }) / static_cast<double>(n);
+                bench::expect(std::abs(columns.averagePriority() - avg) <= 1e-9 * std::abs(avg) + 1e-9,
+                    "averagePriority against std::accumulate" + where);
+            }
+        }
+    }
+
+}
+
+void bench::runPipelineBench(const Options& options) {
+    std::vector<size_t> sizes = { 100000, 1000000, 10000000 };
+    if (options.quick) sizes = { 10000, 100000 };
+
+    std::cout << std::left << std::setw(12) << "case" << std::setw(12) << "n"
+        << std::setw(14) << "myClass ms" << std::setw(14) << "inline ms" << "speedup" << std::endl;
+    for (const std::string name : { "pipeline", "pipeline x4", "sort", "copy" }) {
+        for (size_t n : sizes) {
+            double heap = measure<myClass>(name, n, options);
+            double flat = measure<myClassInline>(name, n, options);
+            std::cout << std::left << std::setw(12) << name << std::setw(12) << n
+                << std::setw(14) << std::fixed << std::setprecision(3) << heap
+                << std::setw(14) << flat << std::setprecision(2) << heap / flat << "x" << std::endl;
+        }
+    }
+
+    std::cout << std::endl << std::left << std::setw(10) << "case" << std::setw(12) << "n"
+        << std::setw(14) << "myClass ms" << std::setw(14) << "inline ms" << std::setw(14) << "columns ms"
+        << "speedup" << std::endl;
+    for (size_t n : sizes) {
+        std::vector<myClass> heapItems = makeItems<myClass>(n, options.seed);
+        std::vector<myClassInline> flatItems = makeItems<myClassInline>(n, options.seed);
+        myClassColumns columns(flatItems.begin(), flatItems.end());
+        for (const std::string name : { "average", "filter", "sort" }) {
+            double heap = measureColumns(name, heapItems, options);
+            double flat = measureColumns(name, flatItems, options);
+            double soa = measureColumns(name, columns, options);
+            std::cout << std::left << std::setw(10) << name << std::setw(12) << n
+                << std::setw(14) << std::fixed << std::setprecision(3) << heap
+                << std::setw(14) << flat << std::setw(14) << soa
+                << std::setprecision(2) << heap / soa << "x" << std::endl;
+        }
+    }
+}
+
+void bench::checkPipeline(const Options& options) {
+    checkColumns(options);
+
+    // Малые размеры как в main и большие; большие еще и на 4 потоках, где
+    // задания 3-5 и 8 идут по многопоточным веткам topKParallel /
+    // eraseIfKeyIn / radixSortByKey / merge path. Эталон - myClass на одном потоке
+    PipelineConfig small;
+    PipelineConfig large;
+    large.minSize = 50000;
+    large.maxSize = 200000;
+    large.tailSize = 40000;
+    large.minTop = 1000;
+    large.maxTop = 5000;
+    PipelineConfig parallel = large;
+    parallel.threads = 4;
+    const int seeds = options.quick ? 20 : 100;
+    for (const PipelineConfig& config : { small, large, parallel }) {
+        PipelineConfig serial = config;
+        serial.threads = 1;
+        for (int s = 0; s < seeds; ++s) {
+            unsigned seed = options.seed + static_cast<unsigned>(s);
+            std::ostringstream referenceOut, heapOut, flatOut;
+            PipelineResult reference = runPipeline<myClass>(seed, referenceOut, serial);
+            PipelineResult heap = runPipeline<myClass>(seed, heapOut, config);
+            PipelineResult flat = runPipeline<myClassInline>(seed, flatOut, config);
+            std::string where = " (seed " + std::to_string(seed) + ", size " + std::to_string(reference.v1)
+                + ", threads " + std::to_string(config.threads) + ")";
+            bench::expect(heapOut.str() == referenceOut.str() && flatOut.str() == referenceOut.str(),
+                "myClass and myClassInline pipeline output" + where);
+            for (const PipelineResult* r : { &heap, &flat }) {
+                bench::expect(r->v1 == reference.v1 && r->v2 == reference.v2 && r->v3 == reference.v3
+                    && r->list3 == reference.list3 && r->pairs == reference.pairs,
+                    "myClass and myClassInline pipeline sizes" + where);
+            }
+        }
+    }
+}
@@ -0,0 +1,247 @@
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myPriorityQueue.hpp"
+#include "myWorkload.hpp"
+#include "benchCommon.hpp"
+
+// Пропускная способность очередей с приоритетом на смешанной нагрузке:
+// n начальных элементов, затем ops операций - 40% push, 30% pop,
+// 30% смена приоритета случайного живого элемента. Приоритеты 1..1000.
+// Базовый вариант - std::multimap (смена приоритета = erase + insert).
+// Проверка (--check): те же операции плюс erase сверяются с
+// std::priority_queue с ленивым удалением; старые дескрипторы отвергаются.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+
+    const int minPriority = 1;
+    const int maxPriority = 1000;
+
+    // Обертка над multimap с тем же интерфейсом, что у очередей
+    template <typename Item>
+    class MultimapQueue {
+    public:
+        using Handle = typename std::multimap<int, Item>::iterator;
+
+        Handle push(Item item) {
+            int priority = item.getPriority();
+            return data_.emplace(priority, std::move(item));
+        }
+        Handle topHandle() { return std::prev(data_.end()); }
+        Item erase(Handle h) {
+            Item item = std::move(h->second);
+            data_.erase(h);
+            return item;
+        }
+        Item pop() { return erase(topHandle()); }
+        const Item& get(Handle h) const { return h->second; }
+        Handle update(Handle h, int priority) {
+            Item item = erase(h);
+            item.setPriority() = priority;
+            return push(std::move(item));
+        }
+        size_t size() const { return data_.size(); }
+
+    private:
+        std::multimap<int, Item> data_;
+    };
+
+    // update у multimap возвращает новый дескриптор, у очередей - void
+    template <typename Queue, typename Handle>
+    void changePriority(Queue& queue, Handle& h, int priority) {
+        if constexpr (std::is_same_v<decltype(queue.update(h, priority)), void>) {
+            queue.update(h, priority);
+        }
+        else {
+            h = queue.update(h, priority);
+        }
+    }
+
+    template <typename Item, typename Queue>
+    double run(Queue& queue, size_t n, size_t ops, unsigned seed) {
+        using Handle = decltype(queue.push(Item()));
+        workload::Xoshiro256 gen(seed);
+        auto priority = [&] { return workload::uniformInt(gen(), minPriority, maxPriority); };
+        std::vector<Handle> live;
+        std::vector<size_t> slotOf;     // позиция в live по номеру элемента (value)
+        live.reserve(n + ops);
+        slotOf.reserve(n + ops);
+        auto push = [&] {
+            int id = static_cast<int>(slotOf.size());
+            slotOf.push_back(live.size());
+            live.push_back(queue.push(Item(id, priority())));
+        };
+        for (size_t i = 0; i < n; ++i) push();
+
+        long long checksum = 0;
+        for (size_t i = 0; i < ops; ++i) {
+            int op = workload::uniformInt(gen(), 0, 9);
+            if (op < 4 || live.empty()) {
+                push();
+            }
+            else if (op < 7) {
+                Item top = queue.pop();
+                checksum += top.getPriority();
+                // Удаление из live перестановкой с последним
+                size_t slot = slotOf[top.getValue()];
+                if (slot + 1 != live.size()) {
+                    live[slot] = live.back();
+                    slotOf[queue.get(live[slot]).getValue()] = slot;
+                }
+                live.pop_back();
+            }
+            else {
+                size_t slot = gen() % live.size();
+                changePriority(queue, live[slot], priority());
+            }
+        }
+        return static_cast<double>(checksum);
+    }
+
+    template <typename Item, typename MakeQueue>
+    double measureQueue(MakeQueue make, size_t n, size_t ops, const Options& options) {
+        volatile double sink = 0;
+        return medianMs(options.reps, [&] {
+            auto queue = make();
+            sink = sink + run<Item>(queue, n, ops, options.seed);
+            });
+    }
+
+
+    // Случайные push / pop / update / erase; после каждого pop приоритет
+    // сверяется с вершиной эталонной std::priority_queue (пары (приоритет,
+    // номер) с ленивым удалением устаревших), элемент - с его текущим состоянием
+    template <typename Compare, typename Queue>
+    void checkOps(Queue queue, const std::string& name, size_t ops, uint64_t seed) {
+        using Entry = std::pair<int, int>;
+        struct EntryOrder {
+            bool operator()(const Entry& a, const Entry& b) const { return Compare{}(a.first, b.first); }
+        };
+        std::priority_queue<Entry, std::vector<Entry>, EntryOrder> reference;
+        std::vector<QueueHandle> handles;      // по номеру элемента (value)
+        std::vector<int> current;              // текущий приоритет, -1 - удален
+        std::vector<int> live;                 // номера живых элементов
+        std::vector<size_t> slotOf;            // позиция номера в live
+        std::vector<QueueHandle> stale;        // дескрипторы удаленных
+        workload::Xoshiro256 rng(seed);
+        auto priority = [&] { return workload::uniformInt(rng(), minPriority, maxPriority); };
+        auto forget = [&](int id) {
+            current[id] = -1;
+            stale.push_back(handles[id]);
+            size_t slot = slotOf[id];
+            live[slot] = live.back();
+            slotOf[live[slot]] = slot;
+            live.pop_back();
+        };
+        auto where = [&](size_t i) { return name + " at operation " + std::to_string(i); };
+
+        for (size_t i = 0; i < ops; ++i) {
+            uint64_t op = rng() % 20;
+            if (op < 8 || live.empty()) {
+                int id = static_cast<int>(handles.size());
+                int p = priority();
+                handles.push_back(queue.push(myClassInline(id, p)));
+                current.push_back(p);
+                slotOf.push_back(live.size());
+                live.push_back(id);
+                reference.push({ p, id });
+            }
+            else if (op < 13) {
+                while (current[reference.top().second] != reference.top().first) reference.pop();
+                int expected = reference.top().first;
+                myClassInline top = queue.pop();
+                int id = top.getValue();
+                bench::expect(top.getPriority() == expected && current[id] == expected, "pop " + where(i));
+                forget(id);
+            }
+            else if (op < 17) {
+                int id = live[rng() % live.size()];
+                int p = priority();
+                queue.update(handles[id], p);
+                current[id] = p;
+                reference.push({ p, id });
+            }
+            else {
+                int id = live[rng() % live.size()];
+                myClassInline erased = queue.erase(handles[id]);
+                bench::expect(erased.getValue() == id && erased.getPriority() == current[id], "erase " + where(i));
+                forget(id);
+            }
+            bench::expect(queue.size() == live.size(), "size " + where(i));
+            if (!live.empty() && i % 64 == 0) {
+                int id = live[rng() % live.size()];
+                bench::expect(queue.contains(handles[id]) && queue.get(handles[id]).getPriority() == current[id],
+                    "get " + where(i));
+            }
+            // Слот удаленного уже занят новым элементом, дескриптор - нет
+            if (!stale.empty() && i % 16 == 0) {
+                QueueHandle h = stale[rng() % stale.size()];
+                bool rejected = false;
+                try {
+                    queue.update(h, minPriority);
+                }
+                catch (const std::invalid_argument&) {
+                    rejected = true;
+                }
+                bench::expect(!queue.contains(h) && rejected, "stale handle " + where(i));
+            }
+        }
+        while (!live.empty()) {
+            while (current[reference.top().second] != reference.top().first) reference.pop();
+            myClassInline top = queue.pop();
+            bench::expect(top.getPriority() == reference.top().first, "final pop of " + name);
+            forget(top.getValue());
+        }
+        bench::expect(queue.empty(), "empty " + name);
+        QueueHandle h = queue.push(myClassInline(0, minPriority));
+        queue.clear();
+        bench::expect(!queue.contains(h), "handle after clear in " + name);
+    }
+
+}
+
+void bench::checkQueue(const Options& options) {
+    const size_t ops = options.quick ? 100000 : 1000000;
+    checkOps<std::less<int>>(myIndexedHeap<myClassInline, 2>(), "heap2", ops, options.seed);
+    checkOps<std::less<int>>(myIndexedHeap<myClassInline>(), "heap4", ops, options.seed);
+    checkOps<std::less<int>>(myIndexedHeap<myClassInline, 8>(), "heap8", ops, options.seed);
+    checkOps<std::greater<int>>(myIndexedHeap<myClassInline, 4, std::greater<int>>(), "heap4 min", ops, options.seed);
+    checkOps<std::less<int>>(myBucketQueue<myClassInline>(minPriority, maxPriority), "bucket", ops, options.seed);
+    checkOps<std::greater<int>>(myBucketQueue<myClassInline, std::greater<int>>(minPriority, maxPriority),
+        "bucket min", ops, options.seed);
+}
+
+void bench::runQueueBench(const Options& options) {
+    std::vector<size_t> sizes = { 10000, 100000, 1000000 };
+    if (options.quick) sizes = { 1000, 100000 };
+
+    std::cout << std::left << std::setw(26) << "queue" << std::setw(10) << "n" << std::setw(10) << "ops"
+        << std::setw(12) << "ms" << "Mops/s" << std::endl;
+    for (size_t n : sizes) {
+        size_t ops = options.quick ? 200000 : 2000000;
+        auto report = [&](const std::string& name, double ms) {
+            std::cout << std::left << std::setw(26) << name << std::setw(10) << n << std::setw(10) << ops
+                << std::setw(12) << std::fixed << std::setprecision(3) << ms
+                << std::setprecision(2) << static_cast<double>(ops) / ms / 1e3 << std::endl;
+        };
+        report("multimap<myClass>", measureQueue<myClass>([] { return MultimapQueue<myClass>(); }, n, ops, options));
+        report("heap4<myClass>", measureQueue<myClass>([] { return myIndexedHeap<myClass>(); }, n, ops, options));
+        report("heap2<myClassInline>", measureQueue<myClassInline>([] { return myIndexedHeap<myClassInline, 2>(); }, n, ops, options));
+        report("heap4<myClassInline>", measureQueue<myClassInline>([] { return myIndexedHeap<myClassInline>(); }, n, ops, options));
+        report("heap8<myClassInline>", measureQueue<myClassInline>([] { return myIndexedHeap<myClassInline, 8>(); }, n, ops, options));
+        report("bucket<myClassInline>", measureQueue<myClassInline>([] {
+            return myBucketQueue<myClassInline>(minPriority, maxPriority); }, n, ops, options));
+    }
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myRadixSort.hpp"
+#include "mySetOps.hpp"
+#include "benchCommon.hpp"
+
+// Задание 8 на больших размерах: std::sort + std::set_intersection против
+// radixSortByKey + parallelSetIntersection на 1..8 потоках. Сортируются
+// копии v1 и v2 (n и n / 2 элементов), время копирования - строка "copy".
+// Проверка (--check): radixSortByKey против std::stable_sort, параллельные
+// операции против std::set_* - поэлементно и в том же порядке.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+
+    template <typename Item>
+    void runItem(const std::string& itemName, size_t n, const Options& options) {
+        std::vector<Item> v1 = bench::makeItems<Item>(n, options.seed);
+        std::vector<Item> v2 = bench::makeItems<Item>(n / 2, options.seed + 1);
+        auto priorityOf = [](const Item& x) { return x.getPriority(); };
+        auto comp = [](const Item& a, const Item& b) { return a.getPriority() < b.getPriority(); };
+        volatile size_t sink = 0;
+        double baseline = 0;
+        auto report = [&](const std::string& name, double ms) {
+            std::cout << std::left << std::setw(44) << name + "<" + itemName + ">" << std::setw(10) << n
+                << std::setw(12) << std::fixed << std::setprecision(3) << ms
+                << std::setprecision(2);
+            if (baseline > 0) std::cout << baseline / ms << "x";
+            std::cout << std::endl;
+        };
+
+        report("copy", medianMs(options.reps, [&] {
+            std::vector<Item> a = v1, b = v2;
+            sink = sink + a.size() + b.size();
+            }));
+        baseline = medianMs(options.reps, [&] {
+            std::vector<Item> a = v1, b = v2;
+            std::sort(a.begin(), a.end(), comp);
+            std::sort(b.begin(), b.end(), comp);
+            std::vector<Item> c;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c), comp);
+            sink = sink + c.size();
+            });
+        double sorted = baseline;
+        baseline = 0;
+        report("std::sort+set_intersection", sorted);
+        baseline = sorted;
+        for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+            report("radix+merge path x" + std::to_string(threads), medianMs(options.reps, [&] {
+                std::vector<Item> a = v1, b = v2;
+                radixSortByKey(a, priorityOf, threads);
+                radixSortByKey(b, priorityOf, threads);
+                sink = sink + parallelSetIntersection(a, b, priorityOf, threads).size();
+                }));
+        }
+        // Объединение и разность отдельно, на уже отсортированных векторах
+        std::vector<Item> a = v1, b = v2;
+        radixSortByKey(a, priorityOf);
+        radixSortByKey(b, priorityOf);
+        baseline = 0;
+        for (unsigned threads : { 1u, 4u }) {
+            report("union x" + std::to_string(threads), medianMs(options.reps, [&] {
+                sink = sink + parallelSetUnion(a, b, priorityOf, threads).size();
+                }));
+            report("difference x" + std::to_string(threads), medianMs(options.reps, [&] {
+                sink = sink + parallelSetDifference(a, b, priorityOf, threads).size();
+                }));
+        }
+    }
+
+
+    template <typename Item>
+    bool sameItems(const std::vector<Item>& a, const std::vector<Item>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].getValue() != b[i].getValue() || a[i].getPriority() != b[i].getPriority()) return false;
+        }
+        return true;
+    }
+
+    // keyOf: приоритеты 1..1000 (один разряд, длинные серии равных) либо
+    // знаковый 64-битный ключ на несколько разрядов
+    template <typename Item, typename KeyOf>
+    void checkItem(const std::string& itemName, const std::string& keyName, size_t n, size_t m,
+        KeyOf keyOf, const Options& options) {
+        std::vector<Item> v1 = bench::makeItems<Item>(n, options.seed + static_cast<unsigned>(n));
+        std::vector<Item> v2 = bench::makeItems<Item>(m, options.seed + static_cast<unsigned>(n + m) + 1);
+        auto comp = [&](const Item& a, const Item& b) { return keyOf(a) < keyOf(b); };
+        std::string where = " " + keyName + "<" + itemName + "> (n " + std::to_string(n) + ", m " + std::to_string(m) + ")";
+
+        std::vector<Item> a = v1, b = v2;
+        std::stable_sort(a.begin(), a.end(), comp);
+        std::stable_sort(b.begin(), b.end(), comp);
+        for (unsigned threads : { 1u, 2u, 3u, 4u }) {
+            std::vector<Item> sorted = v1;
+            radixSortByKey(sorted, keyOf, threads);
+            bench::expect(sameItems(sorted, a), "radixSortByKey x" + std::to_string(threads) + where);
+        }
+
+        std::vector<Item> intersection, united, difference;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(intersection), comp);
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(united), comp);
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(difference), comp);
+        for (unsigned threads : { 1u, 2u, 3u, 4u, 8u }) {
+            std::string suffix = " x" + std::to_string(threads) + where;
+            bench::expect(sameItems(parallelSetIntersection(a, b, keyOf, threads), intersection),
+                "parallelSetIntersection" + suffix);
+            bench::expect(sameItems(parallelSetUnion(a, b, keyOf, threads), united), "parallelSetUnion" + suffix);
+            bench::expect(sameItems(parallelSetDifference(a, b, keyOf, threads), difference),
+                "parallelSetDifference" + suffix);
+        }
+    }
+
+    template <typename Item>
+    void checkItem(const std::string& itemName, size_t n, size_t m, const Options& options) {
+        checkItem<Item>(itemName, "narrow", n, m, [](const Item& x) { return x.getPriority(); }, options);
+        checkItem<Item>(itemName, "wide", n, m, [](const Item& x) {
+            return (static_cast<long long>(x.getPriority()) - 500) * 1000000007LL + x.getValue(); }, options);
+    }
+
+}
+
+void bench::checkSetOps(const Options& options) {
+    std::vector<std::pair<size_t, size_t>> sizes = { { 0, 0 }, { 0, 1000 }, { 1000, 0 }, { 1, 1 }, { 1000, 1000 },
+        { 100000, 50000 }, { 50000, 100000 }, { 200000, 100 } };
+    if (!options.quick) sizes.push_back({ 1000000, 500000 });
+    for (auto [n, m] : sizes) {
+        checkItem<myClass>("myClass", n, m, options);
+        checkItem<myClassInline>("myClassInline", n, m, options);
+    }
+}
+
+void bench::runSetOpsBench(const Options& options) {
+    std::vector<size_t> sizes = { 1000000, 10000000 };
+    if (options.quick) sizes = { 100000 };
+
+    std::cout << std::left << std::setw(44) << "case" << std::setw(10) << "n" << std::setw(12) << "ms"
+        << "speedup" << std::endl;
+    for (size_t n : sizes) {
+        runItem<myClass>("myClass", n, options);
+        runItem<myClassInline>("myClassInline", n, options);
+    }
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myTopK.hpp"
+#include "benchCommon.hpp"
+
+// Выбор k наибольших из n элементов (задание 3 на больших размерах):
+// partial_sort_copy в вектор из k созданных заранее элементов против
+// кучи итераторов, потокового TopK и topKParallel на 1..8 потоках.
+// Проверка (--check): приоритеты по порядку совпадают с partial_sort_copy,
+// а сами элементы (value, priority) взяты из входа без повторов.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+
+    template <typename Item>
+    void runItem(const std::string& itemName, size_t n, size_t k, const Options& options) {
+        std::vector<Item> items = bench::makeItems<Item>(n, options.seed);
+        using Greater = std::greater<Item>;
+        volatile long long sink = 0;
+        auto report = [&](const std::string& name, double ms) {
+            std::cout << std::left << std::setw(36) << name + "<" + itemName + ">" << std::setw(10) << n
+                << std::setw(8) << k << std::setw(12) << std::fixed << std::setprecision(3) << ms
+                << std::setprecision(2) << static_cast<double>(n) / ms / 1e3 << std::endl;
+        };
+
+        report("partial_sort_copy", medianMs(options.reps, [&] {
+            std::vector<Item> top(k);
+            std::partial_sort_copy(items.begin(), items.end(), top.begin(), top.end(), Greater());
+            sink = sink + top.front().getPriority();
+            }));
+        report("topK", medianMs(options.reps, [&] {
+            std::vector<Item> top = topK(items.begin(), items.end(), k, Greater());
+            sink = sink + top.front().getPriority();
+            }));
+        report("TopK stream", medianMs(options.reps, [&] {
+            TopK<Item, Greater> stream(k);
+            for (const Item& x : items) stream.push(x);
+            sink = sink + stream.take().front().getPriority();
+            }));
+        for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+            report("topKParallel x" + std::to_string(threads), medianMs(options.reps, [&] {
+                std::vector<Item> top = topKParallel(items.begin(), items.end(), k, threads, Greater());
+                sink = sink + top.front().getPriority();
+                }));
+        }
+    }
+
+
+    // Те же приоритеты по порядку, что у reference, и каждый элемент
+    // результата - отдельный элемент входа (при равных приоритетах topK
+    // может выбрать другие элементы, чем partial_sort_copy)
+    template <typename Item>
+    std::vector<std::pair<int, int>> sortedPairs(const std::vector<Item>& items) {
+        std::vector<std::pair<int, int>> pairs;
+        pairs.reserve(items.size());
+        for (const Item& x : items) pairs.emplace_back(x.getValue(), x.getPriority());
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    template <typename Item>
+    bool sameSelection(const std::vector<Item>& top, const std::vector<Item>& reference,
+        const std::vector<std::pair<int, int>>& available) {
+        if (top.size() != reference.size()) return false;
+        for (size_t i = 0; i < top.size(); ++i) {
+            if (top[i].getPriority() != reference[i].getPriority()) return false;
+        }
+        // Вложение мультимножеств: повторы учитываются
+        std::vector<std::pair<int, int>> chosen = sortedPairs(top);
+        return std::includes(available.begin(), available.end(), chosen.begin(), chosen.end());
+    }
+
+    template <typename Item, typename Compare>
+    void checkItem(const std::string& itemName, const std::string& order, size_t n, const Options& options) {
+        std::vector<Item> items = bench::makeItems<Item>(n, options.seed + static_cast<unsigned>(n));
+        std::vector<std::pair<int, int>> available = sortedPairs(items);
+        std::vector<size_t> ks = { 0, 1, 50, 5000 };
+        // k >= n - полная сортировка; на больших n только дорого
+        if (n <= 100000) ks.insert(ks.end(), { n, n + 1 });
+        for (size_t k : ks) {
+            std::string where = " " + order + "<" + itemName + "> (n " + std::to_string(n) + ", k " + std::to_string(k) + ")";
+            std::vector<Item> reference(std::min(k, n));
+            std::partial_sort_copy(items.begin(), items.end(), reference.begin(), reference.end(), Compare());
+
+            bench::expect(sameSelection(topK(items.begin(), items.end(), k, Compare()), reference, available),
+                "topK" + where);
+            for (unsigned threads : { 1u, 2u, 3u, 4u, 8u }) {
+                bench::expect(sameSelection(topKParallel(items.begin(), items.end(), k, threads, Compare()),
+                    reference, available), "topKParallel x" + std::to_string(threads) + where);
+            }
+
+            TopK<Item, Compare> stream(k);
+            stream.push(items.begin(), items.end());
+            bench::expect(sameSelection(stream.result(), reference, available), "TopK result" + where);
+            bench::expect(sameSelection(stream.take(), reference, available) && stream.empty(), "TopK take" + where);
+
+            // Два потока по половинам и merge
+            TopK<Item, Compare> left(k);
+            TopK<Item, Compare> right(k);
+            left.push(items.begin(), items.begin() + n / 2);
+            right.push(items.begin() + n / 2, items.end());
+            left.merge(right);
+            bench::expect(sameSelection(left.take(), reference, available), "TopK merge" + where);
+        }
+    }
+
+}
+
+void bench::checkTopK(const Options& options) {
+    std::vector<size_t> sizes = { 0, 1, 1000, 100000 };
+    if (!options.quick) sizes.push_back(1000000);
+    for (size_t n : sizes) {
+        checkItem<myClass, std::greater<myClass>>("myClass", "greater", n, options);
+        checkItem<myClassInline, std::greater<myClassInline>>("myClassInline", "greater", n, options);
+        checkItem<myClassInline, std::less<myClassInline>>("myClassInline", "less", n, options);
+    }
+}
+
+void bench::runTopKBench(const Options& options) {
+    std::vector<size_t> sizes = { 100000, 10000000 };
+    if (options.quick) sizes = { 100000 };
+
+    std::cout << std::left << std::setw(36) << "selection" << std::setw(10) << "n" << std::setw(8) << "k"
+        << std::setw(12) << "ms" << "Mitems/s" << std::endl;
+    for (size_t n : sizes) {
+        for (size_t k : { 50, 5000 }) {
+            runItem<myClass>("myClass", n, k, options);
+            runItem<myClassInline>("myClassInline", n, k, options);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "myClass.hpp"
+#include "myClassInline.hpp"
+#include "myWorkload.hpp"
+#include "benchCommon.hpp"
+
+// Генерация входных данных: std::mt19937 + uniform_int_distribution по
+// одному числу (как в main.cpp) против workload::makeItems / fillPriorities
+// (счетчиковый генератор пачками) на 1..8 потоках.
+
+namespace {
+
+    using bench::Options;
+    using bench::medianMs;
+
+    template <typename Item>
+    std::vector<Item> makeItemsMt(size_t n, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> data_dist(1, 100);
+        std::uniform_int_distribution<> priority_dist(1, 1000);
+        std::vector<Item> items;
+        items.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            items.emplace_back(data_dist(gen), priority_dist(gen));
+        }
+        return items;
+    }
+
+    void report(const std::string& name, size_t n, double ms) {
+        std::cout << std::left << std::setw(36) << name << std::setw(12) << n
+            << std::setw(12) << std::fixed << std::setprecision(3) << ms
+            << std::setprecision(1) << static_cast<double>(n) / ms / 1e3 << std::endl;
+    }
+
+    template <typename Item>
+    void runItems(const std::string& itemName, size_t n, const Options& options) {
+        volatile size_t sink = 0;
+        report("mt19937<" + itemName + ">", n, medianMs(options.reps, [&] {
+            sink = sink + makeItemsMt<Item>(n, options.seed).size();
+            }));
+        for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+            report("workload x" + std::to_string(threads) + "<" + itemName + ">", n, medianMs(options.reps, [&] {
+                sink = sink + workload::makeItems<Item>(n, options.seed, {}, threads).size();
+                }));
+        }
+    }
+
+}
+
+void bench::runWorkloadBench(const Options& options) {
+    std::vector<size_t> sizes = { 1000000, 10000000 };
+    if (options.quick) sizes = { 1000000 };
+
+    std::cout << std::left << std::setw(36) << "generator" << std::setw(12) << "n" << std::setw(12) << "ms"
+        << "Mitems/s" << std::endl;
+    for (size_t n : sizes) {
+        runItems<myClass>("myClass", n, options);
+        runItems<myClassInline>("myClassInline", n, options);
+
+        // Только приоритеты, без построения элементов
+        std::vector<int> priorities(n);
+        volatile int sink = 0;
+        report("mt19937 priorities", n, medianMs(options.reps, [&] {
+            std::mt19937 gen(options.seed);
+            std::uniform_int_distribution<> priority_dist(1, 1000);
+            for (int& p : priorities) p = priority_dist(gen);
+            sink = sink + priorities[n / 2];
+            }));
+        for (unsigned threads : { 1u, 4u }) {
+            report("uniform priorities x" + std::to_string(threads), n, medianMs(options.reps, [&] {
+                workload::fillPriorities(priorities.data(), n, {}, options.seed, 0, threads);
+                sink = sink + priorities[n / 2];
+                }));
+            report("zipf priorities x" + std::to_string(threads), n, medianMs(options.reps, [&] {
+                workload::fillPriorities(priorities.data(), n, workload::PriorityDistribution::zipf(1, 1000, 1.0),
+                    options.seed, 0, threads);
+                sink = sink + priorities[n / 2];
+                }));
+        }
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myThreads.hpp"
+
+// Удаление из вектора всех элементов, ключ которых входит в множество S
+// (замена std::set + remove_if из задания 5). Порядок оставшихся сохраняется.
+//
+// Множество ключей KeySet выбирает представление по размеру:
+//  - Bitmap: битовая карта диапазона [min, max] для целых ключей с
+//    небольшим диапазоном (приоритеты 1..1000 - 125 байт);
+//  - Hash: открытая адресация с линейным пробированием для целых ключей;
+//  - Sorted: отсортированный массив и двоичный поиск - для малых S и
+//    нецелых ключей (нужен только operator<).
+// Auto: Bitmap, если диапазон не больше max(64 * |S|, 2^16) бит, иначе
+// Sorted для |S| <= 16, иначе Hash.
+
+enum class EraseStrategy { Auto, Sorted, Hash, Bitmap };
+
+template <typename Key>
+class KeySet {
+public:
+	template <typename It>
+	KeySet(It first, It last, EraseStrategy strategy = EraseStrategy::Auto) :keys_(first, last) {
+		std::sort(keys_.begin(), keys_.end());
+		keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+		if constexpr (!std::is_integral<Key>::value) {
+			strategy = EraseStrategy::Sorted;
+		}
+		else if (strategy == EraseStrategy::Auto) {
+			strategy = chooseIntegral();
+		}
+		strategy_ = strategy;
+		if constexpr (std::is_integral<Key>::value) {
+			if (strategy_ == EraseStrategy::Bitmap) buildBitmap();
+			if (strategy_ == EraseStrategy::Hash) buildHash();
+		}
+	}
+
+	EraseStrategy strategy() const { return strategy_; }
+	size_t size() const { return keys_.size(); }
+
+	bool contains(const Key& key) const {
+		if constexpr (std::is_integral<Key>::value) {
+			if (strategy_ == EraseStrategy::Bitmap) {
+				if (keys_.empty() || key < keys_.front() || keys_.back() < key) return false;
+				uint64_t bit = offset(key);
+				return (bits_[bit >> 6] >> (bit & 63)) & 1;
+			}
+			if (strategy_ == EraseStrategy::Hash) {
+				for (size_t slot = hash(key);; slot = (slot + 1) & mask_) {
+					if (!used_[slot]) return false;
+					if (table_[slot] == key) return true;
+				}
+			}
+		}
+		return std::binary_search(keys_.begin(), keys_.end(), key);
+	}
+
+private:
+	std::vector<Key> keys_;     // отсортированные без повторов
+	EraseStrategy strategy_ = EraseStrategy::Sorted;
+	std::vector<uint64_t> bits_;
+	std::vector<Key> table_;
+	std::vector<uint8_t> used_;
+	size_t mask_ = 0;
+	unsigned shift_ = 64;
+
+	// Разность с минимальным ключом без переполнения для знаковых типов
+	uint64_t offset(const Key& key) const {
+		return static_cast<uint64_t>(key) - static_cast<uint64_t>(keys_.front());
+	}
+
+	EraseStrategy chooseIntegral() const {
+		if (keys_.empty()) return EraseStrategy::Sorted;
+		uint64_t range = offset(keys_.back());
+		uint64_t limit = std::max<uint64_t>(64 * static_cast<uint64_t>(keys_.size()), uint64_t{ 1 } << 16);
+		if (range < limit) return EraseStrategy::Bitmap;
+		return keys_.size() <= 16 ? EraseStrategy::Sorted : EraseStrategy::Hash;
+	}
+
+	void buildBitmap() {
+		if (keys_.empty()) return;
+		bits_.assign(offset(keys_.back()) / 64 + 1, 0);
+		for (const Key& key : keys_) {
+			uint64_t bit = offset(key);
+			bits_[bit >> 6] |= uint64_t{ 1 } << (bit & 63);
+		}
+	}
+
+	// Заполнение не больше 1/2
+	void buildHash() {
+		size_t capacity = 2;
+		shift_ = 63;
+		while (capacity < 2 * keys_.size()) {
+			capacity *= 2;
+			--shift_;
+		}
+		mask_ = capacity - 1;
+		table_.assign(capacity, Key{});
+		used_.assign(capacity, 0);
+		for (const Key& key : keys_) {
+			size_t slot = hash(key);
+			while (used_[slot]) slot = (slot + 1) & mask_;
+			table_[slot] = key;
+			used_[slot] = 1;
+		}
+	}
+
+	// Мультипликативное (фибоначчиево) хеширование: старшие биты произведения
+	size_t hash(const Key& key) const {
+		return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> shift_);
+	}
+};
+
+// Удаляет из v элементы x с keys.contains(keyOf(x)), возвращает число удаленных.
+// На threads потоках каждый поток проверяет и уплотняет свою часть вектора,
+// затем части сдвигаются к началу по порядку. keyOf вызывается одновременно
+// из нескольких потоков и не должен менять общее состояние.
+template <typename T, typename Key, typename KeyOf>
+size_t eraseIfKeyIn(std::vector<T>& v, const KeySet<Key>& keys, KeyOf keyOf, unsigned threads = 1) {
+	size_t n = v.size();
+	auto erased = [&](const T& x) { return keys.contains(keyOf(x)); };
+	// Части меньше 4096 элементов не окупают потоки
+	size_t parts = threads_detail::partCount(n, threads, 4096);
+	if (parts == 1) {
+		auto last = std::remove_if(v.begin(), v.end(), erased);
+		size_t removed = static_cast<size_t>(v.end() - last);
+		v.erase(last, v.end());
+		return removed;
+	}
+
+	// 1. Уплотнение каждой части к ее началу
+	std::vector<size_t> kept(parts);
+	threads_detail::forEachPart(parts, [&](size_t p) {
+		auto first = v.begin() + n * p / parts;
+		auto last = v.begin() + n * (p + 1) / parts;
+		kept[p] = static_cast<size_t>(std::remove_if(first, last, erased) - first);
+		});
+
+	// 2. Сдвиг частей: назначение не правее источника, порядок сохраняется
+	size_t out = kept[0];
+	for (size_t p = 1; p < parts; ++p) {
+		auto first = v.begin() + n * p / parts;
+		if (v.begin() + out != first) std::move(first, first + kept[p], v.begin() + out);
+		out += kept[p];
+	}
+	v.erase(v.begin() + out, v.end());
+	return n - out;
+}
+
+template <typename T, typename Key, typename KeyOf>
+size_t eraseIfKeyIn(std::vector<T>& v, const std::vector<Key>& keys, KeyOf keyOf,
+	EraseStrategy strategy = EraseStrategy::Auto, unsigned threads = 1) {
+	return eraseIfKeyIn(v, KeySet<Key>(keys.begin(), keys.end(), strategy), keyOf, threads);
+}
@@ -0,0 +1,343 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "myClassInline.hpp"
+
+// Контейнер элементов myClass в виде структуры массивов: приоритеты и
+// значения лежат в отдельных непрерывных массивах, выровненных на 64 байта.
+// Сумма, минимум/максимум, гистограмма и фильтрация идут по массиву
+// приоритетов и векторизуются компилятором.
+//
+// Элемент доступен через ссылку-представление Ref с интерфейсом myClass
+// (getValue, getPriority, setValue, setPriority, сравнения по приоритету),
+// итераторы - произвольного доступа, так что std::sort, std::remove_if,
+// std::accumulate, std::set_intersection работают как с std::vector<myClass>.
+// value_type итератора - myClassInline; константный итератор отдает
+// myClassInline по значению, так что через него контейнер не изменить.
+
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+	using value_type = T;
+
+	template <typename U>
+	struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+	AlignedAllocator() = default;
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+	}
+	void deallocate(T* p, size_t) {
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+class myClassColumns {
+public:
+	using Column = std::vector<int, AlignedAllocator<int>>;
+
+	// Ссылка на элемент: присваивание меняет элемент контейнера
+	class Ref {
+	public:
+		Ref(int* value, int* priority) :value_(value), priority_(priority) {}
+		Ref(const Ref&) = default;
+
+		Ref& operator=(const Ref& other) {
+			*value_ = other.getValue();
+			*priority_ = other.getPriority();
+			return *this;
+		}
+		Ref& operator=(const myClassInline& other) {
+			*value_ = other.getValue();
+			*priority_ = other.getPriority();
+			return *this;
+		}
+		operator myClassInline() const { return myClassInline(*value_, *priority_); }
+
+		int getValue() const { return *value_; }
+		int getPriority() const { return *priority_; }
+		int& setValue() const { return *value_; }
+		int& setPriority() const { return *priority_; }
+
+		friend void swap(Ref a, Ref b) {
+			std::swap(*a.value_, *b.value_);
+			std::swap(*a.priority_, *b.priority_);
+		}
+
+	private:
+		int* value_;
+		int* priority_;
+	};
+
+	template <bool Const>
+	class Iterator {
+		using Ptr = std::conditional_t<Const, const int*, int*>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = myClassInline;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, myClassInline, Ref>;
+		using pointer = void;
+
+		Iterator() = default;
+		Iterator(Ptr value, Ptr priority) :value_(value), priority_(priority) {}
+		// Неконстантный итератор приводится к константному
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		Iterator(const Iterator<false>& other) :value_(other.value_), priority_(other.priority_) {}
+
+		reference operator*() const {
+			if constexpr (Const) return myClassInline(*value_, *priority_);
+			else return Ref(value_, priority_);
+		}
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		Iterator& operator++() { ++value_; ++priority_; return *this; }
+		Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+		Iterator& operator--() { --value_; --priority_; return *this; }
+		Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+		Iterator& operator+=(difference_type n) { value_ += n; priority_ += n; return *this; }
+		Iterator& operator-=(difference_type n) { value_ -= n; priority_ -= n; return *this; }
+		Iterator operator+(difference_type n) const { return Iterator(value_ + n, priority_ + n); }
+		Iterator operator-(difference_type n) const { return Iterator(value_ - n, priority_ - n); }
+		friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+		difference_type operator-(const Iterator& other) const { return priority_ - other.priority_; }
+
+		bool operator==(const Iterator& other) const { return priority_ == other.priority_; }
+		bool operator!=(const Iterator& other) const { return priority_ != other.priority_; }
+		bool operator<(const Iterator& other) const { return priority_ < other.priority_; }
+		bool operator>(const Iterator& other) const { return priority_ > other.priority_; }
+		bool operator<=(const Iterator& other) const { return priority_ <= other.priority_; }
+		bool operator>=(const Iterator& other) const { return priority_ >= other.priority_; }
+
+	private:
+		template <bool>
+		friend class Iterator;
+		friend class myClassColumns;
+
+		Ptr value_ = nullptr;
+		Ptr priority_ = nullptr;
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	myClassColumns() = default;
+
+	// Из любого диапазона элементов с getValue() / getPriority()
+	template <typename It>
+	myClassColumns(It first, It last) {
+		for (; first != last; ++first) push_back(*first);
+	}
+
+	size_t size() const { return priorities_.size(); }
+	bool empty() const { return priorities_.empty(); }
+	void reserve(size_t n) { values_.reserve(n); priorities_.reserve(n); }
+	void clear() { values_.clear(); priorities_.clear(); }
+
+	void emplace_back(int value, int priority) {
+		values_.push_back(value);
+		priorities_.push_back(priority);
+	}
+	template <typename Item>
+	void push_back(const Item& item) { emplace_back(item.getValue(), item.getPriority()); }
+
+	Ref operator[](size_t i) { return Ref(&values_[i], &priorities_[i]); }
+	myClassInline operator[](size_t i) const { return myClassInline(values_[i], priorities_[i]); }
+
+	iterator begin() { return iterator(values_.data(), priorities_.data()); }
+	iterator end() { return begin() + static_cast<std::ptrdiff_t>(size()); }
+	const_iterator begin() const { return cbegin(); }
+	const_iterator end() const { return cend(); }
+	const_iterator cbegin() const { return const_iterator(values_.data(), priorities_.data()); }
+	const_iterator cend() const { return cbegin() + static_cast<std::ptrdiff_t>(size()); }
+
+	// Удаление [first, last) - для идиомы erase(remove_if(...), end())
+	iterator erase(const_iterator first, const_iterator last) {
+		size_t from = static_cast<size_t>(first.priority_ - priorities_.data());
+		size_t to = static_cast<size_t>(last.priority_ - priorities_.data());
+		values_.erase(values_.begin() + from, values_.begin() + to);
+		priorities_.erase(priorities_.begin() + from, priorities_.begin() + to);
+		return begin() + static_cast<std::ptrdiff_t>(from);
+	}
+
+	const int* values() const { return values_.data(); }
+	const int* priorities() const { return priorities_.data(); }
+
+	long long sumPriorities() const {
+		long long sum = 0;
+		const int* p = priorities_.data();
+		size_t n = size();
+#pragma omp simd reduction(+:sum)
+		for (size_t i = 0; i < n; ++i) sum += p[i];
+		return sum;
+	}
+
+	double averagePriority() const {
+		if (empty()) {
+			throw std::runtime_error("Container is empty");
+		}
+		return static_cast<double>(sumPriorities()) / static_cast<double>(size());
+	}
+
+	int minPriority() const {
+		if (empty()) {
+			throw std::runtime_error("Container is empty");
+		}
+		int result = std::numeric_limits<int>::max();
+		const int* p = priorities_.data();
+		size_t n = size();
+#pragma omp simd reduction(min:result)
+		for (size_t i = 0; i < n; ++i) result = std::min(result, p[i]);
+		return result;
+	}
+
+	int maxPriority() const {
+		if (empty()) {
+			throw std::runtime_error("Container is empty");
+		}
+		int result = std::numeric_limits<int>::min();
+		const int* p = priorities_.data();
+		size_t n = size();
+#pragma omp simd reduction(max:result)
+		for (size_t i = 0; i < n; ++i) result = std::max(result, p[i]);
+		return result;
+	}
+
+	// Гистограмма приоритетов: bins равных корзин на [lo, hi), значения вне - отбрасываются
+	std::vector<size_t> histogram(int lo, int hi, size_t bins) const {
+		if (bins == 0 || hi <= lo) {
+			throw std::invalid_argument("Invalid histogram range");
+		}
+		std::vector<size_t> result(bins, 0);
+		const int* p = priorities_.data();
+		size_t n = size();
+		double scale = static_cast<double>(bins) / (static_cast<double>(hi) - static_cast<double>(lo));
+		for (size_t i = 0; i < n; ++i) {
+			if (p[i] < lo || p[i] >= hi) continue;
+			size_t bin = static_cast<size_t>((static_cast<double>(p[i]) - lo) * scale);
+			++result[std::min(bin, bins - 1)];
+		}
+		return result;
+	}
+
+	// Удаление элементов с pred(priority) == true без ветвлений (сжатие потока),
+	// порядок оставшихся сохраняется; возвращает число удаленных
+	template <typename Pred>
+	size_t removeIf(Pred pred) {
+		int* v = values_.data();
+		int* p = priorities_.data();
+		size_t n = size();
+		size_t kept = 0;
+		for (size_t i = 0; i < n; ++i) {
+			int value = v[i];
+			int priority = p[i];
+			v[kept] = value;
+			p[kept] = priority;
+			kept += !pred(priority);
+		}
+		values_.resize(kept);
+		priorities_.resize(kept);
+		return n - kept;
+	}
+
+	// Новый контейнер из элементов с pred(priority) == true
+	template <typename Pred>
+	myClassColumns select(Pred pred) const {
+		myClassColumns result;
+		result.values_.resize(size());
+		result.priorities_.resize(size());
+		size_t kept = 0;
+		for (size_t i = 0; i < size(); ++i) {
+			result.values_[kept] = values_[i];
+			result.priorities_[kept] = priorities_[i];
+			kept += pred(priorities_[i]) ? 1 : 0;
+		}
+		result.values_.resize(kept);
+		result.priorities_.resize(kept);
+		return result;
+	}
+
+	// Устойчивая сортировка по приоритету. Узкий диапазон приоритетов (не
+	// шире max(size, 65536)) - подсчетом за O(n + диапазон); иначе пара
+	// (приоритет, исходный номер) упаковывается в 64-битное число и
+	// сортируются плоские числа - номер сохраняет исходный порядок равных.
+	void sortByPriority() {
+		size_t n = size();
+		if (n < 2) return;
+		int lo = minPriority();
+		int hi = maxPriority();
+		uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+		if (range <= std::max<uint64_t>(n, 1 << 16)) {
+			std::vector<size_t> offsets(range + 1, 0);
+			for (size_t i = 0; i < n; ++i) ++offsets[static_cast<size_t>(priorities_[i] - static_cast<int64_t>(lo)) + 1];
+			for (size_t b = 0; b < range; ++b) offsets[b + 1] += offsets[b];
+			Column values(n), priorities(n);
+			for (size_t i = 0; i < n; ++i) {
+				size_t to = offsets[static_cast<size_t>(priorities_[i] - static_cast<int64_t>(lo))]++;
+				values[to] = values_[i];
+				priorities[to] = priorities_[i];
+			}
+			values_.swap(values);
+			priorities_.swap(priorities);
+			return;
+		}
+		if (n > UINT32_MAX) {
+			// Номер не помещается в 32 бита
+			std::vector<size_t> order(n);
+			for (size_t i = 0; i < n; ++i) order[i] = i;
+			std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return priorities_[a] < priorities_[b]; });
+			permute(order);
+			return;
+		}
+		std::vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; ++i) {
+			uint32_t priority = static_cast<uint32_t>(priorities_[i]) ^ 0x80000000u;
+			keys[i] = (static_cast<uint64_t>(priority) << 32) | i;
+		}
+		std::sort(keys.begin(), keys.end());
+		std::vector<size_t> order(n);
+		for (size_t i = 0; i < n; ++i) order[i] = static_cast<size_t>(keys[i] & UINT32_MAX);
+		permute(order);
+	}
+
+private:
+	Column values_;
+	Column priorities_;
+
+	// Новый порядок: элемент i - бывший order[i]
+	void permute(const std::vector<size_t>& order) {
+		Column values(order.size()), priorities(order.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			values[i] = values_[order[i]];
+			priorities[i] = priorities_[order[i]];
+		}
+		values_.swap(values);
+		priorities_.swap(priorities);
+	}
+};
+
+// Сравнения по приоритету, как у myClass, для Ref и myClassInline в любых сочетаниях
+inline bool operator<(const myClassColumns::Ref& a, const myClassColumns::Ref& b) { return a.getPriority() < b.getPriority(); }
+inline bool operator<(const myClassColumns::Ref& a, const myClassInline& b) { return a.getPriority() < b.getPriority(); }
+inline bool operator<(const myClassInline& a, const myClassColumns::Ref& b) { return a.getPriority() < b.getPriority(); }
+inline bool operator>(const myClassColumns::Ref& a, const myClassColumns::Ref& b) { return b < a; }
+inline bool operator>(const myClassColumns::Ref& a, const myClassInline& b) { return b < a; }
+inline bool operator>(const myClassInline& a, const myClassColumns::Ref& b) { return b < a; }
+inline bool operator==(const myClassColumns::Ref& a, const myClassColumns::Ref& b) { return a.getPriority() == b.getPriority(); }
+inline bool operator==(const myClassColumns::Ref& a, const myClassInline& b) { return a.getPriority() == b.getPriority(); }
+inline bool operator==(const myClassInline& a, const myClassColumns::Ref& b) { return a.getPriority() == b.getPriority(); }
@@ -0,0 +1,30 @@
+#pragma once
+#include <iostream>
+#include <type_traits>
+
+// Вариант myClass без кучи: значение и приоритет хранятся прямо в объекте.
+// Копирование - memcpy 8 байт, getPriority() в компараторах сортировки -
+// чтение поля без разыменования и проверки на nullptr.
+//
+// Отличие от myClass: перемещение - это копирование, поэтому объект после
+// std::move остается корректной копией, а не пустым (getValue() не бросает).
+class myClassInline {
+private:
+	int value = 0;
+	int priority = 0;
+
+public:
+	myClassInline(int data = 0, int prior = 0) :value(data), priority(prior) {}
+
+	bool operator<(const myClassInline& other) const { return priority < other.priority; }
+	bool operator>(const myClassInline& other) const { return other < *this; }
+	bool operator==(const myClassInline& other) const { return priority == other.priority; }
+
+	int getValue() const { return value; }
+	int getPriority() const { return priority; }
+	int& setValue() { return value; }
+	int& setPriority() { return priority; }
+};
+
+static_assert(std::is_trivially_copyable<myClassInline>::value, "myClassInline must be trivially copyable");
+static_assert(sizeof(myClassInline) == 2 * sizeof(int), "myClassInline must store its fields inline");
@@ -0,0 +1,156 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <functional>
+#include <utility>
+#include "myTopK.hpp"
+#include "myBulkErase.hpp"
+#include "myRadixSort.hpp"
+#include "mySetOps.hpp"
+#include "myPooledList.hpp"
+#include "myZip.hpp"
+#include "myWorkload.hpp"
+
+// Задания лабораторной как шаблон по типу элемента: main() запускает его
+// для myClass, бенчмарк (make bench) - для myClass и myClassInline
+// на больших размерах. Item: конструктор (value, priority), getPriority(),
+// сравнения <, >, ==. Случайные размеры - из Xoshiro256(seed), элементы -
+// workload::makeItems(size, seed): один сид дает один и тот же прогон.
+struct PipelineConfig {
+    int minSize = 500;      // размер v1 - случайный из [minSize, maxSize]
+    int maxSize = 1000;
+    int tailSize = 200;     // v2 - последние tailSize элементов v1
+    int minTop = 20;        // n для list1 / list2 - случайный из [minTop, maxTop]
+    int maxTop = 50;
+    unsigned threads = 1;   // потоки заданий 3-5 и 8 (topKParallel, eraseIfKeyIn, radixSortByKey, merge path)
+};
+
+// Размеры результатов, чтобы вызывающий код мог их проверить или использовать
+struct PipelineResult {
+    size_t v1 = 0;
+    size_t v2 = 0;
+    size_t v3 = 0;
+    size_t list3 = 0;
+    size_t pairs = 0;
+    double avg = 0.0;
+};
+
+template <typename Item>
+PipelineResult runPipeline(uint64_t seed, std::ostream& out, const PipelineConfig& config = {}) {
+    PipelineResult result;
+    workload::Xoshiro256 gen(seed);
+
+    // Генерация размера вектора v1
+    int v1_size = workload::uniformInt(gen(), config.minSize, config.maxSize);
+
+    out << "First task:" << std::endl;
+
+    // Создание вектора v1: value из 1..100, priority из 1..1000
+    std::vector<Item> v1 = workload::makeItems<Item>(v1_size, seed);
+
+    out << "Size of v1 = " << v1.size() << std::endl;
+
+    // Задание 2: Создание вектора v2
+    out << "Second task:" << std::endl;
+
+    int b = static_cast<int>(v1.size()) > config.tailSize ? static_cast<int>(v1.size()) - config.tailSize : 0;
+    int e = v1.size();
+    std::vector<Item> v2(v1.begin() + b, v1.begin() + e);
+
+    out << "Size of v2 = " << v2.size() << std::endl;
+
+    // Задание 3: Формирование списка list1
+    out << "Third task:" << std::endl;
+
+    int n = workload::uniformInt(gen(), config.minTop, config.maxTop);
+    n = std::min(n, static_cast<int>(v1.size()));
+
+    // n наибольших без создания n временных элементов (myTopK.hpp)
+    std::vector<Item> temp = topKParallel(v1.begin(), v1.end(), n, config.threads, std::greater<Item>());
+    myPooledList<Item> list1(temp.begin(), temp.end());
+
+    // Задание 4: Формирование списка list2
+    out << "Fourth task:" << std::endl;
+
+    int n2 = workload::uniformInt(gen(), config.minTop, config.maxTop);
+    n2 = std::min(n2, static_cast<int>(v2.size()));
+    std::vector<Item> temp2 = topKParallel(v2.begin(), v2.end(), n2, config.threads, std::less<Item>());
+    myPooledList<Item> list2(temp2.begin(), temp2.end());
+
+    // Задание 5: Удаление перемещенных элементов из v1 и v2
+    out << "Fifth task:" << std::endl;
+
+    // Элементы сравниваются по приоритету, поэтому удаляются все элементы
+    // с приоритетами из temp / temp2 (myBulkErase.hpp)
+    auto priorityOf = [](const Item& x) { return x.getPriority(); };
+    std::vector<int> temp1_keys;
+    temp1_keys.reserve(temp.size());
+    for (const Item& x : temp) temp1_keys.push_back(x.getPriority());
+    eraseIfKeyIn(v1, temp1_keys, priorityOf, EraseStrategy::Auto, config.threads);
+
+    std::vector<int> temp2_keys;
+    temp2_keys.reserve(temp2.size());
+    for (const Item& x : temp2) temp2_keys.push_back(x.getPriority());
+    eraseIfKeyIn(v2, temp2_keys, priorityOf, EraseStrategy::Auto, config.threads);
+
+    // Задание 6: Перегруппировка элементов в list1
+    out << "Sixth task:" << std::endl;
+
+    double avg = std::accumulate(list1.begin(), list1.end(), 0.0, [](double sum, const Item& x) {
+        return sum + x.getPriority();
+        }) / list1.size();
+
+    out << "Avg elem = " << avg << std::endl;
+
+    list1.sort([](const Item& a, const Item& b) {
+        return a.getPriority() > b.getPriority();
+        });
+
+    // Задание 7: Удаление нечётных элементов из list2
+    out << "Seventh task:" << std::endl;
+
+    list2.remove_if([](const Item& x) {
+        return x.getPriority() % 2 != 0;
+        });
+
+    // Задание 8: Создание вектора v3 из общих элементов
+    out << "Eigth task:" << std::endl;
+
+    // Поразрядная сортировка по приоритету и пересечение по нему же
+    // (myRadixSort.hpp, mySetOps.hpp)
+    radixSortByKey(v1, priorityOf, config.threads);
+    radixSortByKey(v2, priorityOf, config.threads);
+
+    std::vector<Item> v3 = parallelSetIntersection(v1, v2, priorityOf, config.threads);
+
+    // Задание 9: Формирование списка list3 из пар элементов
+    out << "Ninth task:" << std::endl;
+    // Пары с конца списков: лишние первые элементы длинного списка
+    // не входят в представление, элементы не копируются (myZip.hpp)
+    auto list3 = zip(list1, list2, ZipAlign::Back);
+
+    // Длины выровненных частей: от начала пар до конца каждого списка
+    out << "Size list1 and list2 after delete: " << std::distance(list3.begin().first(), list1.end()) << " "
+        << std::distance(list3.begin().second(), list2.end()) << std::endl;
+
+    // Задание 10: Создание вектора пар из v1 и v2 без приведения к одному размеру
+    out << "Tenth task:" << std::endl;
+
+    auto v_pairs = zip(v1, v2);
+    for (auto it_v3 = v_pairs.begin(); it_v3 != v_pairs.end(); ++it_v3) {
+        out << it_v3->first.getPriority() << " " << it_v3->second.getPriority()
+            << std::endl;
+    }
+    out << std::endl;
+
+    result.v1 = v1.size();
+    result.v2 = v2.size();
+    result.v3 = v3.size();
+    result.list3 = list3.size();
+    result.pairs = v_pairs.size();
+    result.avg = avg;
+    return result;
+}
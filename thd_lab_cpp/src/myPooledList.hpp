@@ -0,0 +1,354 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Двусвязный список с узлами из пула (slab-аллокатор): узлы выделяются
+// блоками подряд идущих ячеек, освобожденные ячейки возвращаются в список
+// свободных и переиспользуются. Узлы, созданные подряд, лежат в памяти
+// подряд, поэтому обход, remove_if и advance идут почти последовательно.
+//
+// Семантика как у std::list: итераторы и ссылки остаются действительными
+// при вставке и удалении других элементов, sort устойчивая и переставляет
+// узлы, а не значения. splice между списками с общим пулом (конструктор
+// от pool()) - O(1) перевязка; с разными пулами элементы перемещаются,
+// и итераторы на них становятся недействительными.
+//
+// Пул не потокобезопасен: списки с общим пулом используются из одного потока.
+
+template <typename T>
+class myPooledList {
+	struct Link {
+		Link* prev;
+		Link* next;
+	};
+
+	struct Node : Link {
+		T value;
+
+		template <typename... Args>
+		explicit Node(Args&&... args) :Link{ nullptr, nullptr }, value(std::forward<Args>(args)...) {}
+	};
+
+public:
+	class Pool {
+	public:
+		explicit Pool(size_t firstSlab = 64) :nextSlab_(std::max<size_t>(firstSlab, 1)) {}
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		// Ячеек во всех блоках (занятых и свободных)
+		size_t capacity() const { return capacity_; }
+
+	private:
+		friend class myPooledList;
+
+		union Slot {
+			Slot* nextFree;
+			alignas(Node) unsigned char storage[sizeof(Node)];
+		};
+
+		// Блоки растут вдвое до maxSlab_ ячеек
+		static constexpr size_t maxSlab_ = 4096;
+
+		std::vector<std::unique_ptr<Slot[]>> slabs_;
+		Slot* free_ = nullptr;
+		size_t used_ = 0;           // занятых ячеек в последнем блоке
+		size_t slabSize_ = 0;
+		size_t nextSlab_;
+		size_t capacity_ = 0;
+
+		void* allocate() {
+			if (free_) {
+				Slot* slot = free_;
+				free_ = slot->nextFree;
+				return slot;
+			}
+			if (used_ == slabSize_) {
+				slabSize_ = nextSlab_;
+				nextSlab_ = std::min(nextSlab_ * 2, maxSlab_);
+				slabs_.emplace_back(new Slot[slabSize_]);
+				capacity_ += slabSize_;
+				used_ = 0;
+			}
+			return &slabs_.back()[used_++];
+		}
+
+		void deallocate(void* p) {
+			Slot* slot = static_cast<Slot*>(p);
+			slot->nextFree = free_;
+			free_ = slot;
+		}
+	};
+
+	template <bool Const>
+	class Iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const T&, T&>;
+		using pointer = std::conditional_t<Const, const T*, T*>;
+
+		Iterator() = default;
+		explicit Iterator(Link* link) :link_(link) {}
+		// Неконстантный итератор приводится к константному
+		template <bool C = Const, typename = std::enable_if_t<C>>
+		Iterator(const Iterator<false>& other) :link_(other.link_) {}
+
+		reference operator*() const { return static_cast<Node*>(link_)->value; }
+		pointer operator->() const { return &static_cast<Node*>(link_)->value; }
+
+		Iterator& operator++() { link_ = link_->next; return *this; }
+		Iterator operator++(int) { Iterator tmp = *this; ++*this; return tmp; }
+		Iterator& operator--() { link_ = link_->prev; return *this; }
+		Iterator operator--(int) { Iterator tmp = *this; --*this; return tmp; }
+
+		bool operator==(const Iterator& other) const { return link_ == other.link_; }
+		bool operator!=(const Iterator& other) const { return link_ != other.link_; }
+
+	private:
+		template <bool>
+		friend class Iterator;
+		friend class myPooledList;
+
+		Link* link_ = nullptr;
+	};
+
+	using value_type = T;
+	using size_type = size_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	myPooledList() :myPooledList(std::make_shared<Pool>()) {}
+
+	// Список на общем пуле: splice с другими списками этого пула - O(1)
+	explicit myPooledList(std::shared_ptr<Pool> pool) :pool_(std::move(pool)) {}
+
+	template <typename It>
+	myPooledList(It first, It last) :myPooledList() {
+		for (; first != last; ++first) emplace_back(*first);
+	}
+
+	myPooledList(std::initializer_list<T> values) :myPooledList(values.begin(), values.end()) {}
+
+	myPooledList(const myPooledList& other) :myPooledList(other.begin(), other.end()) {}
+
+	myPooledList(myPooledList&& other) noexcept :pool_(other.pool_) {
+		take(other);
+	}
+
+	myPooledList& operator=(const myPooledList& other) {
+		if (this != &other) {
+			myPooledList copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	myPooledList& operator=(myPooledList&& other) noexcept {
+		if (this != &other) {
+			clear();
+			pool_ = other.pool_;
+			take(other);
+		}
+		return *this;
+	}
+
+	~myPooledList() { clear(); }
+
+	const std::shared_ptr<Pool>& pool() const { return pool_; }
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	iterator begin() { return iterator(head_.next); }
+	iterator end() { return iterator(&head_); }
+	const_iterator begin() const { return const_iterator(const_cast<Link*>(head_.next)); }
+	const_iterator end() const { return const_iterator(const_cast<Link*>(&head_)); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+
+	T& front() { return *begin(); }
+	const T& front() const { return *begin(); }
+	T& back() { return *std::prev(end()); }
+	const T& back() const { return *std::prev(end()); }
+
+	template <typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		void* memory = pool_->allocate();
+		Node* node;
+		try {
+			node = ::new (memory) Node(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			pool_->deallocate(memory);
+			throw;
+		}
+		link(pos.link_, node);
+		return iterator(node);
+	}
+
+	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+	template <typename... Args>
+	T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+	void push_back(const T& value) { emplace_back(value); }
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+	void push_front(const T& value) { emplace_front(value); }
+	void push_front(T&& value) { emplace_front(std::move(value)); }
+	void pop_back() { erase(std::prev(end())); }
+	void pop_front() { erase(begin()); }
+
+	iterator erase(const_iterator pos) {
+		Link* next = pos.link_->next;
+		destroy(unlink(pos.link_));
+		return iterator(next);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		while (first != last) first = erase(first);
+		return iterator(last.link_);
+	}
+
+	void clear() {
+		Link* link = head_.next;
+		while (link != &head_) {
+			Link* next = link->next;
+			destroy(static_cast<Node*>(link));
+			link = next;
+		}
+		head_.prev = head_.next = &head_;
+		size_ = 0;
+	}
+
+	void swap(myPooledList& other) noexcept {
+		myPooledList tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	// Все элементы other перед pos
+	void splice(const_iterator pos, myPooledList& other) {
+		if (&other == this || other.empty()) return;
+		if (pool_ != other.pool_) {
+			for (T& value : other) emplace(pos, std::move(value));
+			other.clear();
+			return;
+		}
+		Link* first = other.head_.next;
+		Link* last = other.head_.prev;
+		other.head_.prev = other.head_.next = &other.head_;
+		Link* next = pos.link_;
+		Link* prev = next->prev;
+		prev->next = first;
+		first->prev = prev;
+		last->next = next;
+		next->prev = last;
+		size_ += other.size_;
+		other.size_ = 0;
+	}
+
+	// Элемент it из other перед pos
+	void splice(const_iterator pos, myPooledList& other, const_iterator it) {
+		if (pos == it || pos.link_ == it.link_->next) return;
+		if (pool_ != other.pool_) {
+			emplace(pos, std::move(*iterator(it.link_)));
+			other.erase(it);
+			return;
+		}
+		link(pos.link_, other.unlink(it.link_));
+	}
+
+	// Удаление за один проход, возвращает число удаленных
+	template <typename Pred>
+	size_t remove_if(Pred pred) {
+		size_t removed = 0;
+		Link* link = head_.next;
+		while (link != &head_) {
+			Link* next = link->next;
+			if (pred(static_cast<Node*>(link)->value)) {
+				destroy(unlink(link));
+				++removed;
+			}
+			link = next;
+		}
+		return removed;
+	}
+
+	// Устойчивая сортировка узлов: указатели на узлы сортируются в массиве
+	// (без обхода по ссылкам на каждом шаге слияния), затем перевязываются
+	template <typename Compare>
+	void sort(Compare comp) {
+		if (size_ < 2) return;
+		std::vector<Node*> nodes;
+		nodes.reserve(size_);
+		for (Link* link = head_.next; link != &head_; link = link->next) {
+			nodes.push_back(static_cast<Node*>(link));
+		}
+		std::stable_sort(nodes.begin(), nodes.end(), [&](const Node* a, const Node* b) {
+			return comp(a->value, b->value);
+			});
+		Link* prev = &head_;
+		for (Node* node : nodes) {
+			prev->next = node;
+			node->prev = prev;
+			prev = node;
+		}
+		prev->next = &head_;
+		head_.prev = prev;
+	}
+
+	void sort() { sort(std::less<T>()); }
+
+private:
+	std::shared_ptr<Pool> pool_;
+	Link head_{ &head_, &head_ };
+	size_t size_ = 0;
+
+	// Узлы other переходят к этому списку (пул уже общий)
+	void take(myPooledList& other) {
+		if (other.empty()) return;
+		head_.next = other.head_.next;
+		head_.prev = other.head_.prev;
+		head_.next->prev = &head_;
+		head_.prev->next = &head_;
+		size_ = other.size_;
+		other.head_.prev = other.head_.next = &other.head_;
+		other.size_ = 0;
+	}
+
+	void link(Link* next, Node* node) {
+		Link* prev = next->prev;
+		node->prev = prev;
+		node->next = next;
+		prev->next = node;
+		next->prev = node;
+		++size_;
+	}
+
+	Node* unlink(Link* link) {
+		link->prev->next = link->next;
+		link->next->prev = link->prev;
+		--size_;
+		return static_cast<Node*>(link);
+	}
+
+	void destroy(Node* node) {
+		node->~Node();
+		pool_->deallocate(node);
+	}
+};
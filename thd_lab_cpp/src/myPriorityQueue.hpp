@@ -0,0 +1,370 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Очереди с приоритетом над myClass-подобными элементами (getPriority(),
+// setPriority()) с дескрипторами: push возвращает Handle, по которому
+// элемент можно найти, удалить или сменить ему приоритет без пересортировки
+// всего контейнера.
+//
+// Compare сравнивает приоритеты: std::less<int> (по умолчанию) - наверху
+// наибольший приоритет, как у std::priority_queue; std::greater<int> - наименьший.
+//
+//  - myIndexedHeap: d-арная куча (D = 4: дети узла в одной-двух кеш-линиях),
+//    в куче лежат пары (приоритет, слот), сами элементы не двигаются;
+//    push / pop / update / erase - O(log n);
+//  - myBucketQueue: приоритеты из известного диапазона [lo, hi] (в main.cpp
+//    1..1000), по корзине на приоритет со связным списком внутри;
+//    push / update / erase - O(1), pop - O(1) амортизированно.
+//
+// Дескриптор - номер слота (младшие 32 бита) и поколение слота (старшие).
+// Слот удаленного элемента переиспользуется, но поколение растет, поэтому
+// старый дескриптор не проходит contains() и get / update / erase бросают
+// invalid_argument, а не попадают в чужой элемент (совпадение возможно
+// только после 2^32 переиспользований одного слота).
+
+using QueueHandle = uint64_t;
+
+namespace queue_detail {
+
+	using Slot = uint32_t;
+
+	inline Slot slotOf(QueueHandle h) { return static_cast<Slot>(h); }
+
+	// Хранилище элементов с переиспользованием освободившихся слотов
+	template <typename Item>
+	class Slots {
+	public:
+		QueueHandle insert(Item item) {
+			Slot s;
+			if (!free_.empty()) {
+				s = free_.back();
+				free_.pop_back();
+				items_[s] = std::move(item);
+				live_[s] = true;
+			}
+			else {
+				s = static_cast<Slot>(items_.size());
+				items_.push_back(std::move(item));
+				live_.push_back(true);
+				// После clear() поколения слотов продолжаются
+				if (s == generation_.size()) generation_.push_back(0);
+			}
+			return handle(s);
+		}
+
+		Item release(Slot s) {
+			live_[s] = false;
+			++generation_[s];
+			free_.push_back(s);
+			return std::move(items_[s]);
+		}
+
+		QueueHandle handle(Slot s) const { return (static_cast<QueueHandle>(generation_[s]) << 32) | s; }
+
+		bool contains(QueueHandle h) const {
+			Slot s = slotOf(h);
+			return s < live_.size() && live_[s] && generation_[s] == static_cast<uint32_t>(h >> 32);
+		}
+
+		// Слот живого элемента по дескриптору
+		Slot check(QueueHandle h) const {
+			if (!contains(h)) {
+				throw std::invalid_argument("Invalid queue handle");
+			}
+			return slotOf(h);
+		}
+
+		Item& operator[](Slot s) { return items_[s]; }
+		const Item& operator[](Slot s) const { return items_[s]; }
+		size_t capacity() const { return items_.size(); }
+
+		// Поколения сохраняются: дескрипторы до clear() остаются недействительными
+		void clear() {
+			for (Slot s = 0; s < live_.size(); ++s) {
+				if (live_[s]) ++generation_[s];
+			}
+			items_.clear();
+			live_.clear();
+			free_.clear();
+		}
+
+	private:
+		std::vector<Item> items_;
+		std::vector<bool> live_;
+		std::vector<uint32_t> generation_;
+		std::vector<Slot> free_;
+	};
+
+}
+
+template <typename Item, size_t D = 4, typename Compare = std::less<int>>
+class myIndexedHeap {
+	static_assert(D >= 2, "Heap arity must be at least 2");
+
+public:
+	using Handle = QueueHandle;
+
+	size_t size() const { return heap_.size(); }
+	bool empty() const { return heap_.empty(); }
+	bool contains(Handle h) const { return slots_.contains(h); }
+
+	Handle push(Item item) {
+		int priority = item.getPriority();
+		Handle h = slots_.insert(std::move(item));
+		if (pos_.size() < slots_.capacity()) pos_.resize(slots_.capacity());
+		heap_.push_back({ priority, queue_detail::slotOf(h) });
+		pos_[heap_.back().slot] = heap_.size() - 1;
+		siftUp(heap_.size() - 1);
+		return h;
+	}
+
+	const Item& top() const {
+		if (heap_.empty()) {
+			throw std::runtime_error("Queue is empty");
+		}
+		return slots_[heap_.front().slot];
+	}
+
+	Handle topHandle() const {
+		if (heap_.empty()) {
+			throw std::runtime_error("Queue is empty");
+		}
+		return slots_.handle(heap_.front().slot);
+	}
+
+	Item pop() {
+		return erase(topHandle());
+	}
+
+	const Item& get(Handle h) const {
+		return slots_[slots_.check(h)];
+	}
+
+	// Новый приоритет элемента: подъем или спуск по куче
+	void update(Handle h, int priority) {
+		Slot s = slots_.check(h);
+		slots_[s].setPriority() = priority;
+		size_t i = pos_[s];
+		int old = heap_[i].priority;
+		heap_[i].priority = priority;
+		if (Compare{}(old, priority)) siftUp(i);
+		else siftDown(i);
+	}
+
+	// Уменьшение приоритета; больший приоритет - ошибка
+	void decreaseKey(Handle h, int priority) {
+		if (priority > get(h).getPriority()) {
+			throw std::invalid_argument("New priority is greater than current");
+		}
+		update(h, priority);
+	}
+
+	Item erase(Handle h) {
+		Slot s = slots_.check(h);
+		size_t i = pos_[s];
+		size_t last = heap_.size() - 1;
+		if (i != last) {
+			// На место удаленного - последний, затем вверх или вниз
+			Slot moved = heap_[last].slot;
+			place(i, heap_[last]);
+			heap_.pop_back();
+			siftUp(i);
+			if (pos_[moved] == i) siftDown(i);
+		}
+		else {
+			heap_.pop_back();
+		}
+		return slots_.release(s);
+	}
+
+	void clear() {
+		heap_.clear();
+		pos_.clear();
+		slots_.clear();
+	}
+
+private:
+	using Slot = queue_detail::Slot;
+
+	// 8 байт: в куче номер слота, поколение - только в Slots
+	struct Entry {
+		int priority;
+		Slot slot;
+	};
+
+	std::vector<Entry> heap_;
+	std::vector<size_t> pos_;       // позиция в heap_ по слоту
+	queue_detail::Slots<Item> slots_;
+
+	// true, если a должен стоять выше b
+	static bool higher(const Entry& a, const Entry& b) { return Compare{}(b.priority, a.priority); }
+
+	void place(size_t i, const Entry& e) {
+		heap_[i] = e;
+		pos_[e.slot] = i;
+	}
+
+	void siftUp(size_t i) {
+		Entry e = heap_[i];
+		while (i > 0) {
+			size_t parent = (i - 1) / D;
+			if (!higher(e, heap_[parent])) break;
+			place(i, heap_[parent]);
+			i = parent;
+		}
+		place(i, e);
+	}
+
+	void siftDown(size_t i) {
+		Entry e = heap_[i];
+		size_t n = heap_.size();
+		while (true) {
+			size_t first = i * D + 1;
+			if (first >= n) break;
+			size_t last = first + D < n ? first + D : n;
+			size_t best = first;
+			for (size_t c = first + 1; c < last; ++c) {
+				if (higher(heap_[c], heap_[best])) best = c;
+			}
+			if (!higher(heap_[best], e)) break;
+			place(i, heap_[best]);
+			i = best;
+		}
+		place(i, e);
+	}
+};
+
+template <typename Item, typename Compare = std::less<int>>
+class myBucketQueue {
+public:
+	using Handle = QueueHandle;
+
+	myBucketQueue(int lo, int hi) :lo_(lo), hi_(hi) {
+		if (hi < lo) {
+			throw std::invalid_argument("Invalid priority range");
+		}
+		size_t buckets = static_cast<size_t>(static_cast<long long>(hi) - lo) + 1;
+		head_.assign(buckets, none);
+		tail_.assign(buckets, none);
+		cursor_ = buckets;
+	}
+
+	int minPriority() const { return lo_; }
+	int maxPriority() const { return hi_; }
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	bool contains(Handle h) const { return slots_.contains(h); }
+
+	Handle push(Item item) {
+		size_t b = bucket(item.getPriority());
+		Handle h = slots_.insert(std::move(item));
+		if (next_.size() < slots_.capacity()) {
+			next_.resize(slots_.capacity());
+			prev_.resize(slots_.capacity());
+		}
+		link(queue_detail::slotOf(h), b);
+		++size_;
+		return h;
+	}
+
+	const Item& top() const { return slots_[topSlot()]; }
+
+	Handle topHandle() const { return slots_.handle(topSlot()); }
+
+	Item pop() {
+		return erase(topHandle());
+	}
+
+	const Item& get(Handle h) const {
+		return slots_[slots_.check(h)];
+	}
+
+	// Новый приоритет: перенос в конец другой корзины
+	void update(Handle h, int priority) {
+		Slot s = slots_.check(h);
+		size_t b = bucket(priority);
+		unlink(s, bucket(slots_[s].getPriority()));
+		slots_[s].setPriority() = priority;
+		link(s, b);
+	}
+
+	void decreaseKey(Handle h, int priority) {
+		if (priority > get(h).getPriority()) {
+			throw std::invalid_argument("New priority is greater than current");
+		}
+		update(h, priority);
+	}
+
+	Item erase(Handle h) {
+		Slot s = slots_.check(h);
+		unlink(s, bucket(slots_[s].getPriority()));
+		--size_;
+		return slots_.release(s);
+	}
+
+	void clear() {
+		head_.assign(head_.size(), none);
+		tail_.assign(tail_.size(), none);
+		cursor_ = head_.size();
+		next_.clear();
+		prev_.clear();
+		slots_.clear();
+		size_ = 0;
+	}
+
+private:
+	using Slot = queue_detail::Slot;
+
+	static constexpr Slot none = ~Slot{ 0 };
+
+	int lo_;
+	int hi_;
+	size_t size_ = 0;
+	mutable size_t cursor_;             // все корзины до cursor_ пусты
+	std::vector<Slot> head_;
+	std::vector<Slot> tail_;
+	std::vector<Slot> next_;
+	std::vector<Slot> prev_;
+	queue_detail::Slots<Item> slots_;
+
+	// Первая непустая корзина; курсор только убывает при push и растет при pop
+	Slot topSlot() const {
+		if (size_ == 0) {
+			throw std::runtime_error("Queue is empty");
+		}
+		while (head_[cursor_] == none) ++cursor_;
+		return head_[cursor_];
+	}
+
+	// Корзина 0 - та, что выдается первой
+	size_t bucket(int priority) const {
+		if (priority < lo_ || priority > hi_) {
+			throw std::out_of_range("Priority out of bucket queue range");
+		}
+		bool largestFirst = Compare{}(0, 1);
+		return largestFirst ? static_cast<size_t>(static_cast<long long>(hi_) - priority)
+			: static_cast<size_t>(static_cast<long long>(priority) - lo_);
+	}
+
+	// В конец корзины: внутри корзины порядок FIFO
+	void link(Slot s, size_t b) {
+		next_[s] = none;
+		prev_[s] = tail_[b];
+		if (tail_[b] != none) next_[tail_[b]] = s;
+		else head_[b] = s;
+		tail_[b] = s;
+		if (b < cursor_) cursor_ = b;
+	}
+
+	void unlink(Slot s, size_t b) {
+		if (prev_[s] != none) next_[prev_[s]] = next_[s];
+		else head_[b] = next_[s];
+		if (next_[s] != none) prev_[next_[s]] = prev_[s];
+		else tail_[b] = prev_[s];
+	}
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myThreads.hpp"
+
+// Устойчивая параллельная LSD-поразрядная сортировка по целому ключу keyOf(x)
+// (знаковому или беззнаковому, до 64 бит). Сортируются пары (ключ, номер)
+// по 11-битным разрядам - только столько разрядов, сколько нужно для
+// диапазона [min, max] (приоритеты 1..1000 - один проход); затем элементы
+// один раз переставляются по номерам. keyOf вызывается один раз на элемент.
+//
+// Проход на p потоках: гистограммы частей, префиксные суммы в порядке
+// (разряд, часть) - это и дает устойчивость, затем раскладка своих частей.
+
+namespace radix_detail {
+
+	constexpr unsigned digitBits = 11;
+	constexpr size_t buckets = size_t{ 1 } << digitBits;
+
+	struct Entry {
+		uint64_t key;
+		size_t index;
+	};
+
+	// Порядок знаковых ключей сохраняется после инверсии старшего бита
+	template <typename Key>
+	uint64_t toUnsigned(Key key) {
+		static_assert(std::is_integral<Key>::value, "radixSortByKey needs an integer key");
+		if constexpr (std::is_signed<Key>::value) {
+			return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ (uint64_t{ 1 } << 63);
+		}
+		else {
+			return static_cast<uint64_t>(key);
+		}
+	}
+
+}
+
+template <typename T, typename KeyOf>
+void radixSortByKey(std::vector<T>& v, KeyOf keyOf, unsigned threads = 1) {
+	using namespace radix_detail;
+	static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+		"radixSortByKey needs nothrow moves");
+	size_t n = v.size();
+	if (n < 2) return;
+	size_t parts = threads_detail::partCount(n, threads, 16384);
+	auto begin = [&](size_t p) { return n * p / parts; };
+
+	// 1. Ключи и их диапазон
+	std::vector<Entry> entries(n);
+	std::vector<uint64_t> partMin(parts, UINT64_MAX), partMax(parts, 0);
+	threads_detail::forEachPart(parts, [&](size_t p) {
+		for (size_t i = begin(p); i < begin(p + 1); ++i) {
+			uint64_t key = toUnsigned(keyOf(v[i]));
+			entries[i] = { key, i };
+			partMin[p] = std::min(partMin[p], key);
+			partMax[p] = std::max(partMax[p], key);
+		}
+		});
+	uint64_t minKey = *std::min_element(partMin.begin(), partMin.end());
+	uint64_t range = *std::max_element(partMax.begin(), partMax.end()) - minKey;
+	unsigned bits = 0;
+	while (bits < 64 && (range >> bits) != 0) ++bits;
+	if (bits == 0) return;      // все ключи равны - порядок уже устойчивый
+
+	// 2. Проходы по разрядам ключа minus minKey
+	std::vector<Entry> buffer(n);
+	std::vector<size_t> counts(parts * buckets);
+	for (unsigned shift = 0; shift < bits; shift += digitBits) {
+		auto digit = [&](const Entry& e) { return static_cast<size_t>(((e.key - minKey) >> shift) & (buckets - 1)); };
+		threads_detail::forEachPart(parts, [&](size_t p) {
+			size_t* count = counts.data() + p * buckets;
+			std::fill(count, count + buckets, 0);
+			for (size_t i = begin(p); i < begin(p + 1); ++i) ++count[digit(entries[i])];
+			});
+		size_t offset = 0;
+		for (size_t d = 0; d < buckets; ++d) {
+			for (size_t p = 0; p < parts; ++p) {
+				size_t c = counts[p * buckets + d];
+				counts[p * buckets + d] = offset;
+				offset += c;
+			}
+		}
+		threads_detail::forEachPart(parts, [&](size_t p) {
+			size_t* next = counts.data() + p * buckets;
+			for (size_t i = begin(p); i < begin(p + 1); ++i) buffer[next[digit(entries[i])]++] = entries[i];
+			});
+		entries.swap(buffer);
+	}
+
+	// 3. Перестановка элементов: перемещение в неинициализированный буфер
+	// и обратно, без конструктора по умолчанию у T
+	std::allocator<T> alloc;
+	T* sorted = alloc.allocate(n);
+	threads_detail::forEachPart(parts, [&](size_t p) {
+		for (size_t i = begin(p); i < begin(p + 1); ++i) {
+			::new (static_cast<void*>(sorted + i)) T(std::move(v[entries[i].index]));
+		}
+		});
+	threads_detail::forEachPart(parts, [&](size_t p) {
+		for (size_t i = begin(p); i < begin(p + 1); ++i) {
+			v[i] = std::move(sorted[i]);
+			sorted[i].~T();
+		}
+		});
+	alloc.deallocate(sorted, n);
+}
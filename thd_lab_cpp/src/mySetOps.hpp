@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "myThreads.hpp"
+
+// Пересечение, объединение и разность отсортированных по keyOf(x) векторов
+// с той же семантикой мультимножеств, что у std::set_intersection /
+// set_union / set_difference (элементы равных ключей берутся из a, затем
+// из b), на нескольких потоках.
+//
+// Разбиение merge path: диагональ d слияния a и b делится двоичным поиском
+// на (i, j), i + j = d; затем граница сдвигается на начало серии равных
+// ключей в обоих векторах, чтобы серия целиком попала в одну часть.
+// Части считаются независимо и склеиваются по порядку.
+
+namespace setops_detail {
+
+	// Начало части на диагонали d: первые i из a и j из b идут раньше
+	template <typename T, typename KeyOf>
+	std::pair<size_t, size_t> split(const std::vector<T>& a, const std::vector<T>& b, size_t d, KeyOf& keyOf) {
+		size_t lo = d > b.size() ? d - b.size() : 0;
+		size_t hi = std::min(d, a.size());
+		// Наибольшее i, при котором a[i - 1] идет в слиянии раньше b[d - i]
+		while (lo < hi) {
+			size_t i = lo + (hi - lo + 1) / 2;
+			if (keyOf(b[d - i]) < keyOf(a[i - 1])) hi = i - 1;
+			else lo = i;
+		}
+		size_t i = lo;
+		size_t j = d - i;
+		if (i == a.size() && j == b.size()) return { i, j };
+		auto key = (j == b.size() || (i < a.size() && !(keyOf(b[j]) < keyOf(a[i])))) ? keyOf(a[i]) : keyOf(b[j]);
+		auto less = [&](const T& x, const decltype(key)& k) { return keyOf(x) < k; };
+		return { static_cast<size_t>(std::lower_bound(a.begin(), a.end(), key, less) - a.begin()),
+			static_cast<size_t>(std::lower_bound(b.begin(), b.end(), key, less) - b.begin()) };
+	}
+
+	template <typename T, typename KeyOf, typename Op>
+	std::vector<T> run(const std::vector<T>& a, const std::vector<T>& b, KeyOf keyOf, unsigned threads, Op op) {
+		size_t total = a.size() + b.size();
+		size_t parts = threads_detail::partCount(total, threads, 16384);
+		auto comp = [&](const T& x, const T& y) { return keyOf(x) < keyOf(y); };
+		if (parts == 1) {
+			std::vector<T> out;
+			op(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out), comp);
+			return out;
+		}
+		std::vector<std::pair<size_t, size_t>> bounds(parts + 1);
+		std::vector<std::vector<T>> partOut(parts);
+		threads_detail::forEachPart(parts, [&](size_t p) {
+			bounds[p] = split(a, b, total * p / parts, keyOf);
+			});
+		bounds[parts] = { a.size(), b.size() };
+		threads_detail::forEachPart(parts, [&](size_t p) {
+			op(a.begin() + bounds[p].first, a.begin() + bounds[p + 1].first,
+				b.begin() + bounds[p].second, b.begin() + bounds[p + 1].second, std::back_inserter(partOut[p]), comp);
+			});
+		size_t size = 0;
+		for (const auto& part : partOut) size += part.size();
+		std::vector<T> out;
+		out.reserve(size);
+		for (auto& part : partOut) out.insert(out.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+		return out;
+	}
+
+	struct Intersection {
+		template <typename It, typename Out, typename Comp>
+		Out operator()(It f1, It l1, It f2, It l2, Out out, Comp comp) const { return std::set_intersection(f1, l1, f2, l2, out, comp); }
+	};
+	struct Union {
+		template <typename It, typename Out, typename Comp>
+		Out operator()(It f1, It l1, It f2, It l2, Out out, Comp comp) const { return std::set_union(f1, l1, f2, l2, out, comp); }
+	};
+	struct Difference {
+		template <typename It, typename Out, typename Comp>
+		Out operator()(It f1, It l1, It f2, It l2, Out out, Comp comp) const { return std::set_difference(f1, l1, f2, l2, out, comp); }
+	};
+
+}
+
+template <typename T, typename KeyOf>
+std::vector<T> parallelSetIntersection(const std::vector<T>& a, const std::vector<T>& b, KeyOf keyOf, unsigned threads = 1) {
+	return setops_detail::run(a, b, keyOf, threads, setops_detail::Intersection());
+}
+
+template <typename T, typename KeyOf>
+std::vector<T> parallelSetUnion(const std::vector<T>& a, const std::vector<T>& b, KeyOf keyOf, unsigned threads = 1) {
+	return setops_detail::run(a, b, keyOf, threads, setops_detail::Union());
+}
+
+template <typename T, typename KeyOf>
+std::vector<T> parallelSetDifference(const std::vector<T>& a, const std::vector<T>& b, KeyOf keyOf, unsigned threads = 1) {
+	return setops_detail::run(a, b, keyOf, threads, setops_detail::Difference());
+}
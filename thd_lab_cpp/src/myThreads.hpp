@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Запуск частей работы на потоках: часть 0 выполняет вызывающий поток,
+// первое исключение из частей пробрасывается после join.
+namespace threads_detail {
+
+	inline unsigned hardwareThreads() {
+		unsigned n = std::thread::hardware_concurrency();
+		return n ? n : 1;
+	}
+
+	// Число частей для n элементов: не больше threads и не меньше minPart на часть
+	inline size_t partCount(size_t n, unsigned threads, size_t minPart) {
+		size_t parts = minPart ? n / minPart : n;
+		if (parts > threads) parts = threads;
+		return parts ? parts : 1;
+	}
+
+	// f(part) для part из [0, parts)
+	template <typename F>
+	void forEachPart(size_t parts, F f) {
+		if (parts <= 1) {
+			f(size_t{ 0 });
+			return;
+		}
+		std::vector<std::exception_ptr> errors(parts);
+		auto work = [&](size_t p) {
+			try {
+				f(p);
+			}
+			catch (...) {
+				errors[p] = std::current_exception();
+			}
+		};
+		std::vector<std::thread> workers;
+		workers.reserve(parts - 1);
+		for (size_t p = 1; p < parts; ++p) workers.emplace_back(work, p);
+		work(0);
+		for (auto& w : workers) w.join();
+		for (auto& e : errors) {
+			if (e) std::rethrow_exception(e);
+		}
+	}
+
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "myThreads.hpp"
+
+// Выбор k первых элементов в порядке Compare (как partial_sort_copy):
+// std::less<T> - k наименьших, std::greater<T> - k наибольших.
+// Результат отсортирован в порядке Compare, размер - min(k, n).
+//
+//  - topK(first, last, k): ограниченная куча из k итераторов, в конце
+//    копируются ровно min(k, n) элементов; память O(k);
+//  - topKParallel(first, last, k, threads): у каждого потока своя куча
+//    итераторов по своей части диапазона, затем слияние кандидатов;
+//  - TopK<T>: потоковый вариант (push по одному элементу), хранит не больше
+//    k копий - элементы, вытесненные из кучи, перезаписываются на месте.
+
+namespace topk_detail {
+
+	// Куча итераторов: наверху худший из отобранных
+	template <typename It, typename Compare>
+	void scan(It first, It last, size_t k, Compare comp, std::vector<It>& heap) {
+		auto worse = [&](const It& a, const It& b) { return comp(*a, *b); };
+		heap.clear();
+		heap.reserve(k);
+		for (; first != last; ++first) {
+			if (heap.size() < k) {
+				heap.push_back(first);
+				std::push_heap(heap.begin(), heap.end(), worse);
+			}
+			else if (comp(*first, *heap.front())) {
+				std::pop_heap(heap.begin(), heap.end(), worse);
+				heap.back() = first;
+				std::push_heap(heap.begin(), heap.end(), worse);
+			}
+		}
+	}
+
+	// Сортировка итераторов и копирование элементов
+	template <typename It, typename Compare>
+	std::vector<typename std::iterator_traits<It>::value_type> collect(std::vector<It>& its, Compare comp) {
+		std::sort(its.begin(), its.end(), [&](const It& a, const It& b) { return comp(*a, *b); });
+		std::vector<typename std::iterator_traits<It>::value_type> result;
+		result.reserve(its.size());
+		for (const It& it : its) result.push_back(*it);
+		return result;
+	}
+
+}
+
+template <typename It, typename Compare = std::less<typename std::iterator_traits<It>::value_type>>
+std::vector<typename std::iterator_traits<It>::value_type> topK(It first, It last, size_t k, Compare comp = Compare()) {
+	std::vector<It> heap;
+	if (k == 0) return {};
+	topk_detail::scan(first, last, k, comp, heap);
+	return topk_detail::collect(heap, comp);
+}
+
+template <typename It, typename Compare = std::less<typename std::iterator_traits<It>::value_type>>
+std::vector<typename std::iterator_traits<It>::value_type> topKParallel(It first, It last, size_t k,
+	unsigned threads = threads_detail::hardwareThreads(), Compare comp = Compare()) {
+	static_assert(std::is_base_of<std::random_access_iterator_tag,
+		typename std::iterator_traits<It>::iterator_category>::value, "topKParallel needs random access iterators");
+	if (k == 0) return {};
+	size_t n = static_cast<size_t>(last - first);
+	// Части меньше 4k не окупают потоки
+	size_t parts = threads_detail::partCount(n, threads, 4 * k);
+	if (parts == 1) return topK(first, last, k, comp);
+
+	std::vector<std::vector<It>> heaps(parts);
+	threads_detail::forEachPart(parts, [&](size_t p) {
+		topk_detail::scan(first + n * p / parts, first + n * (p + 1) / parts, k, comp, heaps[p]);
+		});
+
+	// Слияние: из parts * k кандидатов - k лучших
+	std::vector<It> candidates;
+	candidates.reserve(parts * k);
+	for (auto& h : heaps) candidates.insert(candidates.end(), h.begin(), h.end());
+	if (candidates.size() > k) {
+		std::nth_element(candidates.begin(), candidates.begin() + k - 1, candidates.end(),
+			[&](const It& a, const It& b) { return comp(*a, *b); });
+		candidates.resize(k);
+	}
+	return topk_detail::collect(candidates, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+class TopK {
+public:
+	explicit TopK(size_t k, Compare comp = Compare()) :k_(k), comp_(comp) {
+		heap_.reserve(k);
+	}
+
+	size_t k() const { return k_; }
+	size_t size() const { return heap_.size(); }
+	bool empty() const { return heap_.empty(); }
+
+	// Худший из отобранных (следующий кандидат на вытеснение)
+	const T& threshold() const { return heap_.front(); }
+
+	void push(const T& value) {
+		if (heap_.size() < k_) {
+			heap_.push_back(value);
+			std::push_heap(heap_.begin(), heap_.end(), comp_);
+		}
+		else if (k_ > 0 && comp_(value, heap_.front())) {
+			std::pop_heap(heap_.begin(), heap_.end(), comp_);
+			heap_.back() = value;
+			std::push_heap(heap_.begin(), heap_.end(), comp_);
+		}
+	}
+
+	template <typename It>
+	void push(It first, It last) {
+		for (; first != last; ++first) push(*first);
+	}
+
+	// Объединение с другим потоком (например, другого потока выполнения)
+	void merge(const TopK& other) {
+		for (const T& value : other.heap_) push(value);
+	}
+
+	// Отсортированная копия отобранного
+	std::vector<T> result() const {
+		std::vector<T> sorted = heap_;
+		std::sort_heap(sorted.begin(), sorted.end(), comp_);
+		return sorted;
+	}
+
+	// Отобранное без копирования; поток становится пустым
+	std::vector<T> take() {
+		std::sort_heap(heap_.begin(), heap_.end(), comp_);
+		std::vector<T> sorted = std::move(heap_);
+		heap_.clear();
+		return sorted;
+	}
+
+private:
+	size_t k_;
+	Compare comp_;
+	std::vector<T> heap_;
+};
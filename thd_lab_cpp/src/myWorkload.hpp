@@ -0,0 +1,242 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "myThreads.hpp"
+
+// Быстрые воспроизводимые генераторы данных для бенчмарков и конвейера.
+//  - CounterRng: число с номером i - хеш SplitMix64 от (ключ, i), без
+//    состояния, поэтому части массива заполняются на любом числе потоков
+//    с одинаковым результатом, fill векторизуется;
+//  - Xoshiro256: последовательный xoshiro256** для одного потока, потоки
+//    из одного сида - разные stream (или jump, 2^128 шагов).
+// makeItems: элемент i берет из потока сида значения 2i (value) и 2i + 1
+// (priority) - результат зависит только от сида, не от числа потоков.
+//
+// finalize, mix, toUnit, CounterRng и Xoshiro256 - копия того же ядра из
+// fth_lab_cpp/src/myWorkload.hpp (лабораторные собираются независимо);
+// меняются в обеих копиях вместе.
+
+namespace workload {
+
+	constexpr uint64_t golden = 0x9E3779B97F4A7C15ull;
+
+	// Финализатор SplitMix64
+	inline uint64_t finalize(uint64_t z) {
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	inline uint64_t mix(uint64_t z) { return finalize(z + golden); }
+
+	// Равномерное из [lo, hi] по старшим 32 битам (смещение < 2^-32 на значение)
+	inline int uniformInt(uint64_t r, int lo, int hi) {
+		uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+		return static_cast<int>(lo + static_cast<int64_t>(((r >> 32) * range) >> 32));
+	}
+
+	// [0, 1) с 53 значащими битами
+	inline double toUnit(uint64_t r) { return static_cast<double>(r >> 11) * 0x1.0p-53; }
+
+	class CounterRng {
+	public:
+		explicit CounterRng(uint64_t seed, uint64_t stream = 0) :key_(mix(seed ^ mix(stream))) {}
+
+		uint64_t operator()(uint64_t counter) const { return finalize(key_ + counter * golden); }
+		double uniform(uint64_t counter) const { return toUnit((*this)(counter)); }
+
+		// out[k] = (*this)(first + k * step)
+		void fill(uint64_t first, uint64_t* out, size_t n, uint64_t step = 1) const {
+			const uint64_t key = key_;
+#pragma omp simd
+			for (size_t k = 0; k < n; ++k) {
+				out[k] = finalize(key + (first + k * step) * golden);
+			}
+		}
+
+	private:
+		uint64_t key_;
+	};
+
+	class Xoshiro256 {
+	public:
+		explicit Xoshiro256(uint64_t seed, uint64_t stream = 0) {
+			uint64_t z = seed ^ mix(stream);
+			for (auto& s : s_) s = mix(z += golden);
+		}
+
+		uint64_t operator()() {
+			uint64_t result = rotl(s_[1] * 5, 7) * 9;
+			uint64_t t = s_[1] << 17;
+			s_[2] ^= s_[0];
+			s_[3] ^= s_[1];
+			s_[1] ^= s_[2];
+			s_[0] ^= s_[3];
+			s_[2] ^= t;
+			s_[3] = rotl(s_[3], 45);
+			return result;
+		}
+
+		double uniform() { return toUnit((*this)()); }
+
+		// Эквивалент 2^128 вызовов: неперекрывающиеся подпоследовательности
+		void jump() {
+			static const uint64_t jumpPoly[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+				0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+			uint64_t t[4] = { 0, 0, 0, 0 };
+			for (uint64_t word : jumpPoly) {
+				for (unsigned b = 0; b < 64; ++b) {
+					if (word & (uint64_t{ 1 } << b)) {
+						for (int k = 0; k < 4; ++k) t[k] ^= s_[k];
+					}
+					(*this)();
+				}
+			}
+			for (int k = 0; k < 4; ++k) s_[k] = t[k];
+		}
+
+		// Для std::uniform_int_distribution и std::shuffle
+		using result_type = uint64_t;
+		static constexpr uint64_t min() { return 0; }
+		static constexpr uint64_t max() { return ~uint64_t{ 0 }; }
+
+	private:
+		uint64_t s_[4];
+
+		static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+	};
+
+	// Распределение приоритетов: равномерное на [lo, hi] или Zipf, где
+	// приоритет lo + r встречается с вероятностью ~ 1 / (r + 1)^exponent
+	struct PriorityDistribution {
+		enum class Kind { Uniform, Zipf };
+
+		Kind kind = Kind::Uniform;
+		int lo = 1;
+		int hi = 1000;
+		double exponent = 1.0;
+
+		static PriorityDistribution uniform(int lo, int hi) { return { Kind::Uniform, lo, hi, 1.0 }; }
+		static PriorityDistribution zipf(int lo, int hi, double exponent) { return { Kind::Zipf, lo, hi, exponent }; }
+	};
+
+	// Ранги 0..n-1 с вероятностью ~ 1 / (r + 1)^exponent. Таблица псевдонимов
+	// (Walker/Vose): выборка за O(1) по одному 64-битному числу - старшие
+	// 32 бита выбирают ячейку, младшие - ее ранг или псевдоним.
+	class ZipfTable {
+	public:
+		ZipfTable(size_t n, double exponent) :threshold_(n), alias_(n) {
+			std::vector<double> scaled(n);
+			double sum = 0.0;
+			for (size_t r = 0; r < n; ++r) {
+				scaled[r] = 1.0 / std::pow(static_cast<double>(r + 1), exponent);
+				sum += scaled[r];
+			}
+			std::vector<uint32_t> small, large;
+			for (size_t r = 0; r < n; ++r) {
+				scaled[r] *= static_cast<double>(n) / sum;
+				(scaled[r] < 1.0 ? small : large).push_back(static_cast<uint32_t>(r));
+				alias_[r] = static_cast<uint32_t>(r);
+			}
+			while (!small.empty() && !large.empty()) {
+				uint32_t s = small.back();
+				uint32_t l = large.back();
+				small.pop_back();
+				alias_[s] = l;
+				threshold_[s] = toThreshold(scaled[s]);
+				scaled[l] -= 1.0 - scaled[s];
+				if (scaled[l] < 1.0) {
+					large.pop_back();
+					small.push_back(l);
+				}
+			}
+			// Остатки - погрешность округления, вероятность 1
+			for (uint32_t r : small) threshold_[r] = UINT32_MAX;
+			for (uint32_t r : large) threshold_[r] = UINT32_MAX;
+		}
+
+		size_t size() const { return alias_.size(); }
+
+		uint32_t sample(uint64_t r) const {
+			uint32_t cell = static_cast<uint32_t>(((r >> 32) * alias_.size()) >> 32);
+			return static_cast<uint32_t>(r) < threshold_[cell] ? cell : alias_[cell];
+		}
+
+	private:
+		std::vector<uint32_t> threshold_;   // доля ячейки, доставшаяся ее рангу, * 2^32
+		std::vector<uint32_t> alias_;
+
+		static uint32_t toThreshold(double p) {
+			return p >= 1.0 ? UINT32_MAX : static_cast<uint32_t>(p * 4294967296.0);
+		}
+	};
+
+	// Отображение случайных 64-битных чисел в приоритеты
+	class PrioritySampler {
+	public:
+		explicit PrioritySampler(const PriorityDistribution& dist) :dist_(dist),
+			zipf_(dist.kind == PriorityDistribution::Kind::Zipf ? static_cast<size_t>(static_cast<int64_t>(dist.hi) - dist.lo + 1) : 0,
+				dist.exponent) {}
+
+		int operator()(uint64_t r) const {
+			if (zipf_.size() == 0) return uniformInt(r, dist_.lo, dist_.hi);
+			return dist_.lo + static_cast<int>(zipf_.sample(r));
+		}
+
+		// out[k] = приоритет по draws[k]; равномерный случай векторизуется
+		void map(const uint64_t* draws, int* out, size_t n) const {
+			if (zipf_.size() == 0) {
+				const int lo = dist_.lo;
+				const int hi = dist_.hi;
+#pragma omp simd
+				for (size_t k = 0; k < n; ++k) out[k] = uniformInt(draws[k], lo, hi);
+				return;
+			}
+			for (size_t k = 0; k < n; ++k) out[k] = (*this)(draws[k]);
+		}
+
+	private:
+		PriorityDistribution dist_;
+		ZipfTable zipf_;
+	};
+
+	// priorities[i] - по счетчику first + i * step потока (seed, stream)
+	inline void fillPriorities(int* out, size_t n, const PriorityDistribution& dist, uint64_t seed,
+		uint64_t stream = 0, unsigned threads = 1, uint64_t first = 0, uint64_t step = 1) {
+		CounterRng rng(seed, stream);
+		PrioritySampler sampler(dist);
+		size_t parts = threads_detail::partCount(n, threads, 65536);
+		threads_detail::forEachPart(parts, [&](size_t p) {
+			// Пачками по 1024, чтобы fill и map векторизовались
+			uint64_t draws[1024];
+			size_t end = n * (p + 1) / parts;
+			for (size_t begin = n * p / parts; begin < end; begin += 1024) {
+				size_t count = std::min<size_t>(1024, end - begin);
+				rng.fill(first + begin * step, draws, count, step);
+				sampler.map(draws, out + begin, count);
+			}
+			});
+	}
+
+	// n элементов Item(value, priority): value равномерно из [valueLo, valueHi]
+	// (как в main.cpp: 1..100), priority - по dist
+	template <typename Item>
+	std::vector<Item> makeItems(size_t n, uint64_t seed, const PriorityDistribution& dist = {},
+		unsigned threads = 1, int valueLo = 1, int valueHi = 100) {
+		std::vector<int> values(n);
+		std::vector<int> priorities(n);
+		fillPriorities(values.data(), n, PriorityDistribution::uniform(valueLo, valueHi), seed, 0, threads, 0, 2);
+		fillPriorities(priorities.data(), n, dist, seed, 0, threads, 1, 2);
+		// Сами элементы - последовательно: у myClass каждый конструктор выделяет узел
+		std::vector<Item> items;
+		items.reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			items.emplace_back(values[i], priorities[i]);
+		}
+		return items;
+	}
+
+}
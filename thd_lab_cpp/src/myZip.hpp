@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+// Ленивое попарное представление двух диапазонов (vector, list, myPooledList
+// и т.п.) без копирования элементов: разыменование итератора дает
+// std::pair ссылок на элементы обоих диапазонов.
+//
+// Выравнивание при разной длине (длина представления - меньшая из длин):
+//  - ZipAlign::Front: пары с начала, хвост длинного диапазона отбрасывается
+//    (как transform(a.begin(), a.begin() + n, b.begin(), ...));
+//  - ZipAlign::Back: пары с конца, отбрасывается начало длинного диапазона
+//    (как удаление лишних первых элементов в задании 9).
+//
+// Диапазоны должны жить дольше представления и не менять длину.
+//
+// Разыменование дает пару ссылок по значению (прокси, а не value_type&),
+// поэтому итератор объявлен input_iterator: алгоритмы std:: проходят его
+// последовательно (std::distance - за O(n)). Арифметика +, -, [] и
+// сравнения < > доступны напрямую, если оба диапазона с произвольным
+// доступом. Оба итератора сдвигаются вместе от выровненного начала, так
+// что == сравнивает обе пары.
+
+enum class ZipAlign { Front, Back };
+
+template <typename It1, typename It2>
+class ZipIterator {
+public:
+	using reference = std::pair<typename std::iterator_traits<It1>::reference,
+		typename std::iterator_traits<It2>::reference>;
+	using value_type = std::pair<typename std::iterator_traits<It1>::value_type,
+		typename std::iterator_traits<It2>::value_type>;
+	using difference_type = std::ptrdiff_t;
+	using iterator_category = std::input_iterator_tag;
+
+	// operator-> возвращает пару ссылок по значению
+	struct pointer {
+		reference ref;
+		const reference* operator->() const { return &ref; }
+	};
+
+	ZipIterator() = default;
+	ZipIterator(It1 first, It2 second) :first_(first), second_(second) {}
+
+	reference operator*() const { return reference(*first_, *second_); }
+	pointer operator->() const { return pointer{ **this }; }
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	ZipIterator& operator++() { ++first_; ++second_; return *this; }
+	ZipIterator operator++(int) { ZipIterator tmp = *this; ++*this; return tmp; }
+	ZipIterator& operator--() { --first_; --second_; return *this; }
+	ZipIterator operator--(int) { ZipIterator tmp = *this; --*this; return tmp; }
+	ZipIterator& operator+=(difference_type n) { first_ += n; second_ += n; return *this; }
+	ZipIterator& operator-=(difference_type n) { first_ -= n; second_ -= n; return *this; }
+	ZipIterator operator+(difference_type n) const { return ZipIterator(first_ + n, second_ + n); }
+	ZipIterator operator-(difference_type n) const { return ZipIterator(first_ - n, second_ - n); }
+	friend ZipIterator operator+(difference_type n, const ZipIterator& it) { return it + n; }
+
+	difference_type operator-(const ZipIterator& other) const { return first_ - other.first_; }
+	bool operator==(const ZipIterator& other) const { return first_ == other.first_ && second_ == other.second_; }
+	bool operator!=(const ZipIterator& other) const { return !(*this == other); }
+	bool operator<(const ZipIterator& other) const { return other - *this > 0; }
+	bool operator>(const ZipIterator& other) const { return other < *this; }
+	bool operator<=(const ZipIterator& other) const { return !(other < *this); }
+	bool operator>=(const ZipIterator& other) const { return !(*this < other); }
+
+	It1 first() const { return first_; }
+	It2 second() const { return second_; }
+
+private:
+	It1 first_;
+	It2 second_;
+};
+
+template <typename Range1, typename Range2>
+class ZipView {
+public:
+	using iterator = ZipIterator<decltype(std::begin(std::declval<Range1&>())), decltype(std::begin(std::declval<Range2&>()))>;
+	using value_type = typename iterator::value_type;
+	using reference = typename iterator::reference;
+
+	ZipView(Range1& first, Range2& second, ZipAlign align = ZipAlign::Front)
+		:size_(std::min<size_t>(std::size(first), std::size(second))) {
+		auto begin1 = std::begin(first);
+		auto begin2 = std::begin(second);
+		if (align == ZipAlign::Back) {
+			std::advance(begin1, std::size(first) - size_);
+			std::advance(begin2, std::size(second) - size_);
+		}
+		begin_ = iterator(begin1, begin2);
+		// Конец - size_ шагов от начала в обоих диапазонах; при Back это
+		// концы обоих, при Front у длинного - середина (std::next за O(size_))
+		end_ = iterator(std::size(first) == size_ ? std::end(first) : std::next(begin1, size_),
+			std::size(second) == size_ ? std::end(second) : std::next(begin2, size_));
+	}
+
+	iterator begin() const { return begin_; }
+	iterator end() const { return end_; }
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+private:
+	size_t size_;
+	iterator begin_;
+	iterator end_;
+};
+
+template <typename Range1, typename Range2>
+ZipView<Range1, Range2> zip(Range1& first, Range2& second, ZipAlign align = ZipAlign::Front) {
+	return ZipView<Range1, Range2>(first, second, align);
+}
+
+// Временные диапазоны разрушились бы раньше представления
+template <typename Range1, typename Range2>
+void zip(Range1&& first, Range2&& second, ZipAlign align = ZipAlign::Front) = delete;